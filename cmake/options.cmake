@@ -351,6 +351,12 @@ set_if_at_least_one_set(RETDEC_ENABLE_COMMON
 		RETDEC_ENABLE_SERDES
 		RETDEC_ENABLE_STACOFIN)
 
+set_if_at_least_one_set(RETDEC_ENABLE_YARACPP
+		RETDEC_ENABLE_ALL
+		RETDEC_ENABLE_CPDETECT
+		RETDEC_ENABLE_FILEINFO
+		RETDEC_ENABLE_STACOFIN)
+
 set_if_at_least_one_set(RETDEC_ENABLE_UTILS
 		RETDEC_ENABLE_ALL
 		RETDEC_ENABLE_AR_EXTRACTOR
@@ -374,13 +380,8 @@ set_if_at_least_one_set(RETDEC_ENABLE_UTILS
 		RETDEC_ENABLE_PATTERNGEN
 		RETDEC_ENABLE_RTTI_FINDER
 		RETDEC_ENABLE_STACOFIN
-		RETDEC_ENABLE_UNPACKERTOOL)
-
-set_if_at_least_one_set(RETDEC_ENABLE_YARACPP
-		RETDEC_ENABLE_ALL
-		RETDEC_ENABLE_CPDETECT
-		RETDEC_ENABLE_FILEINFO
-		RETDEC_ENABLE_STACOFIN)
+		RETDEC_ENABLE_UNPACKERTOOL
+		RETDEC_ENABLE_YARACPP)
 
 # tests
 set_if_all_set(RETDEC_ENABLE_BIN2LLVMIR_TESTS
@@ -425,6 +426,9 @@ set_if_all_set(RETDEC_ENABLE_COMMON_TESTS
 set_if_all_set(RETDEC_ENABLE_UTILS_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_UTILS)
+set_if_all_set(RETDEC_ENABLE_YARACPP_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_YARACPP)
 
 # src depending on tests
 set_if_at_least_one_set(RETDEC_ENABLE_LLVMIR_EMUL
@@ -455,7 +459,8 @@ set_if_at_least_one_set(RETDEC_ENABLE_GOOGLETEST
 		RETDEC_ENABLE_LOADER_TESTS
 		RETDEC_ENABLE_SERDES_TESTS
 		RETDEC_ENABLE_UNPACKER_TESTS
-		RETDEC_ENABLE_UTILS_TESTS)
+		RETDEC_ENABLE_UTILS_TESTS
+		RETDEC_ENABLE_YARACPP_TESTS)
 
 set_if_at_least_one_set(RETDEC_ENABLE_KEYSTONE
 		RETDEC_ENABLE_CAPSTONE2LLVMIRTOOL
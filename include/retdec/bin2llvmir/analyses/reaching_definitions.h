@@ -3,9 +3,9 @@
 * @brief Reaching definitions analysis (RDA) builds UD and DU chains.
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 *
-* Right now, this works on an entire module. But we could insert an another layer
-* that represents functions. Then it would be possible to associate BBs with
-* functions that own them and recompute RDA only for the selected function.
+* Reaching definitions are computed separately for every function. Definitions
+* in a function are numbered and sets of reaching definitions are represented
+* as bit vectors indexed by these numbers.
 */
 
 #ifndef RETDEC_BIN2LLVMIR_ANALYSES_REACHING_DEFINITIONS_H
@@ -17,6 +17,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include <llvm/ADT/BitVector.h>
 #include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/IR/Module.h>
 
@@ -34,6 +35,7 @@ class ReachingDefinitionsAnalysis;
 using Changed = bool;
 
 using BBEntrySet = std::unordered_set<BasicBlockEntry*>;
+using BBEntryMap = std::map<const llvm::BasicBlock*, BasicBlockEntry>;
 
 using DefSet = std::unordered_set<Definition*>;
 using UseSet = std::unordered_set<Use*>;
@@ -41,6 +43,9 @@ using UseSet = std::unordered_set<Use*>;
 using DefVector = std::vector<Definition>;
 using UseVector = std::vector<Use>;
 
+/// Indexes of definitions (in a function) of the individual values.
+using DefIndexMap = std::unordered_map<const llvm::Value*, std::vector<unsigned>>;
+
 class Definition
 {
 	public:
@@ -90,7 +95,10 @@ class BasicBlockEntry
 				std::ostream& out,
 				const BasicBlockEntry& bbe);
 
-		void initializeKillDefSets();
+		void initializeKillDefSets(
+				const DefIndexMap& srcDefs,
+				unsigned numDefs);
+		llvm::BitVector getDefsIn() const;
 		Changed initDefsOut();
 
 		const DefSet& defsFromUse(const llvm::Instruction* I) const;
@@ -106,12 +114,15 @@ class BasicBlockEntry
 
 		BBEntrySet prevBBs;
 
-		// defsIn is union of prevBBs' defsOuts
-		DefSet defsOut;
-		DefSet genDefs;
-		std::unordered_set<llvm::Value*> killDefs;
+		/// Index of the first definition of this BB in its function.
+		/// Definitions are numbered in the order of their BBs in the function
+		/// and in the order of their positions in the BBs.
+		unsigned firstDefIdx = 0;
 
-		bool changed = false;
+		// defsIn is union of prevBBs' defsOuts
+		llvm::BitVector defsOut;
+		llvm::BitVector genDefs;
+		llvm::BitVector killDefs;
 
 	private:
 		unsigned id;
@@ -157,13 +168,23 @@ class ReachingDefinitionsAnalysis
 		void initializeBasicBlocks(llvm::Module& M);
 		void initializeBasicBlocks(llvm::Function& F);
 		void initializeBasicBlocksPrev();
-		void initializeKillGenSets();
-		void propagate();
-		void initializeDefsAndUses();
+		void initializeDefIndexes(
+				BBEntryMap& bbs,
+				std::vector<Definition*>& defs,
+				DefIndexMap& srcDefs);
+		void initializeKillGenSets(
+				BBEntryMap& bbs,
+				const DefIndexMap& srcDefs,
+				unsigned numDefs);
+		void propagate(const llvm::Function* F, BBEntryMap& bbs);
+		void initializeDefsAndUses(
+				BBEntryMap& bbs,
+				const std::vector<Definition*>& defs,
+				const DefIndexMap& srcDefs);
 		void clearInternal();
 
 	private:
-		std::map<const llvm::Function*, std::map<const llvm::BasicBlock*, BasicBlockEntry>> bbMap;
+		std::map<const llvm::Function*, BBEntryMap> bbMap;
 		bool _trackFlagRegs = false;
 		const llvm::GlobalVariable* _specialGlobal = nullptr;
 		bool _run = false;
@@ -40,6 +40,9 @@ class ConstantsAnalysis : public llvm::ModulePass
 
 	private:
 		bool run();
+		void runOnFunction(
+				llvm::Function& f,
+				ReachingDefinitionsAnalysis& RDA);
 		void checkForGlobalInInstruction(
 				ReachingDefinitionsAnalysis& RDA,
 				llvm::Instruction* inst,
@@ -84,10 +84,28 @@ class Decoder : public llvm::ModulePass
 		void initStaticCode();
 		void initVtables();
 
+	// Pre-decoding.
+	//
+	private:
+		void predecode();
+		void predecodeChunks(std::size_t first);
+		void releasePredecodedChunks(std::size_t keep);
+		cs_insn* getPredecodedInsn(
+				common::Address addr,
+				std::size_t maxSize,
+				bool take);
+		bool disasm(
+				csh ce,
+				ByteData& bytes,
+				std::uint64_t& addr,
+				cs_insn* insn);
+
 	private:
 		void decode();
 		bool getJumpTarget(JumpTarget& jt);
 		void decodeJumpTarget(const JumpTarget& jt);
+		std::optional<common::AddressRange> getSelectionDependencyRange(
+				const JumpTarget& jt);
 		std::size_t decodeJumpTargetDryRun(
 				const JumpTarget& jt,
 				ByteData bytes,
@@ -299,6 +317,37 @@ class Decoder : public llvm::ModulePass
 
 		std::unique_ptr<capstone2llvmir::Capstone2LlvmIrTranslator> _c2l;
 		cs_insn* _dryCsInsn = nullptr;
+		/**
+		 * Part of the ranges to decode that is disassembled in advance.
+		 */
+		struct PredecodeChunk
+		{
+			std::uint64_t start = 0;
+			std::uint64_t end = 0;
+			/// End of the range the chunk is in, instructions may cross
+			/// the chunk's end but not the range's end.
+			std::uint64_t rangeEnd = 0;
+			/// Owner of the disassembled instructions.
+			capstone2llvmir::InsnArena arena;
+			/// Disassembled instructions, sorted by address.
+			std::vector<std::pair<std::uint64_t, cs_insn*>> insns;
+			/// Is the chunk disassembled (i.e. are @c insns valid)?
+			bool decoded = false;
+			/// Value of @c _predecodeClock when the chunk was last used.
+			std::size_t lastUse = 0;
+		};
+		/// Chunks of the primary ranges to decode, sorted by address.
+		/// Only a bounded window of them is disassembled at a time.
+		std::vector<PredecodeChunk> _predecodeChunks;
+		/// Number of jobs disassembling chunks in parallel.
+		std::size_t _predecodeJobs = 0;
+		/// Number of currently disassembled chunks.
+		std::size_t _predecodedChunkCount = 0;
+		/// Counter of uses of chunks, used to release the least recently
+		/// used ones.
+		std::size_t _predecodeClock = 0;
+		/// Basic mode the chunks are disassembled in.
+		cs_mode _predecodedMode = CS_MODE_LITTLE_ENDIAN;
 
 		llvm::IRBuilder<>* _irb;
 
@@ -337,6 +386,11 @@ class Decoder : public llvm::ModulePass
 		bool _switchGenerated = false;
 
 		bool _somethingDecoded = false;
+
+		/// Functions outside of the selected ranges that are decoded because
+		/// selected functions depend on them (see
+		/// @c getSelectionDependencyRange()), mapped to their call depth.
+		std::map<common::Address, std::size_t> _selectionDependencies;
 };
 
 } // namespace bin2llvmir
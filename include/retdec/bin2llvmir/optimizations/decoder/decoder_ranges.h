@@ -38,6 +38,7 @@ class RangesToDecode
 		const common::AddressRange* getPrimary(common::Address a) const;
 		const common::AddressRange* getAlternative(common::Address a) const;
 		const common::AddressRange* get(common::Address a) const;
+		const common::AddressRangeContainer& getPrimaryRanges() const;
 
 		void setArchitectureInstructionAlignment(unsigned a);
 
@@ -56,6 +56,7 @@ class JumpTarget
 	public:
 		JumpTarget();
 		JumpTarget(
+				Config* c,
 				retdec::common::Address a,
 				eType t,
 				cs_mode m,
@@ -85,9 +86,8 @@ class JumpTarget
 		retdec::common::Address _fromAddress;
 		/// Disassembler mode that should be used for this jump target.
 		mutable cs_mode _mode = CS_MODE_BIG_ENDIAN;
-
-	public:
-		static Config* config;
+		/// Config of the decoded module.
+		Config* _config = nullptr;
 };
 
 /**
@@ -96,6 +96,10 @@ class JumpTarget
 class JumpTargets
 {
 	public:
+		JumpTargets(Config* c = nullptr);
+
+		void setConfig(Config* c);
+
 		auto begin();
 		auto end();
 
@@ -117,8 +121,9 @@ class JumpTargets
 	public:
 		std::set<JumpTarget> _data;
 
-	public:
-		static Config* config;
+	private:
+		/// Config of the decoded module.
+		Config* _config = nullptr;
 };
 
 } // namespace bin2llvmir
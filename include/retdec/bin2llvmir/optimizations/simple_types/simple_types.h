@@ -18,7 +18,9 @@
 #include <llvm/IR/Module.h>
 #include <llvm/Pass.h>
 
+#include "retdec/bin2llvmir/analyses/reaching_definitions.h"
 #include "retdec/bin2llvmir/providers/fileimage.h"
+#include "retdec/bin2llvmir/providers/module_data_map.h"
 #include "retdec/bin2llvmir/utils/debug.h"
 
 namespace retdec {
@@ -206,6 +208,8 @@ class SimpleTypesAnalysis : public llvm::ModulePass
 		virtual bool runOnModule(llvm::Module& m) override;
 		virtual void getAnalysisUsage(llvm::AnalysisUsage& AU) const override;
 
+		static void clear(llvm::Module* m);
+
 	private:
 		void buildEqSets(llvm::Module& M);
 		void buildEquations();
@@ -227,6 +231,9 @@ class SimpleTypesAnalysis : public llvm::ModulePass
 		FileImage* objf = nullptr;
 
 		std::unordered_set<llvm::Instruction*> instToErase;
+
+		/// Modules on which the first run of the pass was done.
+		static ModuleDataMap<bool> _analyzedModules;
 };
 
 } // namespace bin2llvmir
@@ -35,6 +35,9 @@ class StackAnalysis : public llvm::ModulePass
 
 	private:
 		bool run();
+		void runOnFunction(
+				llvm::Function& f,
+				ReachingDefinitionsAnalysis& RDA);
 		void handleInstruction(
 				ReachingDefinitionsAnalysis& RDA,
 				llvm::Instruction* inst,
@@ -7,6 +7,9 @@
 #ifndef RETDEC_BIN2LLVMIR_OPTIMIZATIONS_VALUE_PROTECT_VALUE_PROTECT_H
 #define RETDEC_BIN2LLVMIR_OPTIMIZATIONS_VALUE_PROTECT_VALUE_PROTECT_H
 
+#include <map>
+#include <mutex>
+
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Module.h>
 #include <llvm/Pass.h>
@@ -61,7 +64,13 @@ class ValueProtect : public llvm::ModulePass
 		llvm::Module* _module = nullptr;
 		Config* _config = nullptr;
 		Abi* _abi = nullptr;
-		static std::map<llvm::Type*, llvm::Function*> _type2fnc;
+		/// Protection functions created for the module -- shared by
+		/// the protecting and the unprotecting pass instances.
+		std::map<llvm::Type*, llvm::Function*>* _type2fnc = nullptr;
+		static std::map<
+				llvm::Module*,
+				std::map<llvm::Type*, llvm::Function*>> _module2type2fnc;
+		static std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
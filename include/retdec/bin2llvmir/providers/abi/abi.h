@@ -17,6 +17,7 @@
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
 #include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/providers/calling_convention/calling_convention.h"
+#include "retdec/bin2llvmir/providers/module_data_map.h"
 
 //#include "retdec/capstone2llvmir/x86/x86_defs.h"
 
@@ -165,9 +166,10 @@ class AbiProvider
 		static Abi* getAbi(llvm::Module* m);
 		static bool getAbi(llvm::Module* m, Abi*& abi);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
-		static std::map<llvm::Module*, std::unique_ptr<Abi>> _module2abi;
+		static ModuleDataMap<std::unique_ptr<Abi>> _module2abi;
 };
 
 } // namespace bin2llvmir
@@ -7,14 +7,22 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_ASM_INSTRUCTION_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_ASM_INSTRUCTION_H
 
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <shared_mutex>
+
 #include <capstone/capstone.h>
+#include "retdec/capstone2llvmir/insn_arena.h"
 #include "retdec/capstone2llvmir/arm/arm_defs.h"
 #include "retdec/capstone2llvmir/mips/mips_defs.h"
 #include "retdec/capstone2llvmir/powerpc/powerpc_defs.h"
 #include "retdec/capstone2llvmir/x86/x86_defs.h"
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/Module.h>
+#include <llvm/IR/ValueMap.h>
 
 #include "retdec/bin2llvmir/utils/llvm.h"
 #include "retdec/common/address.h"
@@ -22,7 +30,12 @@
 namespace retdec {
 namespace bin2llvmir {
 
-using Llvm2CapstoneInsnMap = typename std::map<llvm::StoreInst*, cs_insn*>;
+/**
+ * Mapping of special LLVM-to-ASM store instructions to Capstone instructions.
+ * It is an open-addressing hash map, because it is queried for almost every
+ * instruction in almost every pass.
+ */
+using Llvm2CapstoneInsnMap = llvm::DenseMap<llvm::StoreInst*, cs_insn*>;
 
 /**
  * Assembly instruction representation.
@@ -154,6 +167,8 @@ class AsmInstruction
 	public:
 		static Llvm2CapstoneInsnMap& getLlvmToCapstoneInsnMap(
 				const llvm::Module* m);
+		static capstone2llvmir::InsnArena& getCapstoneInsnArena(
+				const llvm::Module* m);
 		static llvm::GlobalVariable* getLlvmToAsmGlobalVariable(
 				const llvm::Module* m);
 		static void setLlvmToAsmGlobalVariable(
@@ -167,6 +182,9 @@ class AsmInstruction
 				llvm::BasicBlock* bb);
 		static retdec::common::Address getTrueBasicBlockAddress(
 				llvm::BasicBlock* bb);
+		static void setTrueBasicBlockAddress(
+				llvm::BasicBlock* bb,
+				retdec::common::Address a);
 		static retdec::common::Address getBasicBlockEndAddress(
 				llvm::BasicBlock* bb);
 		static retdec::common::Address getFunctionAddress(
@@ -175,11 +193,16 @@ class AsmInstruction
 				llvm::Function* f);
 		static bool isLlvmToAsmInstruction(const llvm::Value* inst);
 		static void clear();
+		static void clear(const llvm::Module* m);
 
 	private:
 		const llvm::GlobalVariable* getLlvmToAsmGlobalVariablePrivate(
 				llvm::Module* m) const;
 		bool isLlvmToAsmInstructionPrivate(llvm::Value* inst) const;
+		static retdec::common::Address getBasicBlockAddressFromTable(
+				llvm::BasicBlock* bb);
+		static Llvm2CapstoneInsnMap* findLlvmToCapstoneInsnMap(
+				const llvm::Module* m);
 
 	private:
 		using ModuleGlobalPair = std::pair<
@@ -187,12 +210,30 @@ class AsmInstruction
 				llvm::GlobalVariable*>;
 		using ModuleInstructionMap = std::pair<
 				const llvm::Module*,
-				std::map<llvm::StoreInst*, cs_insn*>>;
+				Llvm2CapstoneInsnMap>;
+		/// Entries of deleted basic blocks are removed automatically.
+		using BasicBlockAddressMap = llvm::ValueMap<
+				const llvm::BasicBlock*,
+				retdec::common::Address>;
+		using ModuleInsnArena = std::pair<
+				const llvm::Module*,
+				capstone2llvmir::InsnArena>;
+		using ModuleBasicBlockAddressMap = std::pair<
+				const llvm::Module*,
+				BasicBlockAddressMap>;
 
 	private:
 		llvm::StoreInst* _llvmToAsmInstr = nullptr;
-		static std::vector<ModuleGlobalPair> _module2global;
-		static std::vector<ModuleInstructionMap> _module2instMap;
+		// Lists, because references to their elements must stay valid
+		// when other modules are added or removed.
+		static std::list<ModuleGlobalPair> _module2global;
+		static std::list<ModuleInstructionMap> _module2instMap;
+		static std::list<ModuleInsnArena> _module2insnArena;
+		static std::list<ModuleBasicBlockAddressMap> _module2bbAddrMap;
+		static std::shared_mutex _mutex;
+		/// Incremented whenever module data are removed. Invalidates
+		/// the per-thread caches of @c findLlvmToCapstoneInsnMap().
+		static std::atomic<std::uint64_t> _generation;
 
 	public:
 		template<
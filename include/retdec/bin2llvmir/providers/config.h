@@ -14,6 +14,7 @@
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/Module.h>
 
+#include "retdec/bin2llvmir/providers/module_data_map.h"
 #include "retdec/common/address.h"
 #include "retdec/utils/filesystem.h"
 
@@ -166,6 +167,11 @@ class Config
 		bool isPseudoAsmFunction(llvm::Function* f);
 		llvm::CallInst* isPseudoAsmFunctionCall(llvm::Value* c);
 
+		// Functions decoded only because selected functions depend on them.
+		//
+		void addSelectionDependency(llvm::Function* f);
+		bool isSelectionDependency(llvm::Function* f);
+
 		// Other
 		//
 		llvm::GlobalVariable* getGlobalDummy();
@@ -196,6 +202,7 @@ class Config
 
 		std::map<IntrinsicFunctionCreatorPtr, llvm::Function*> _intrinsicFunctions;
 		std::set<llvm::Function*> _pseudoAsmFunctions;
+		std::set<llvm::Function*> _selectionDependencies;
 };
 
 class ConfigProvider
@@ -206,9 +213,10 @@ class ConfigProvider
 		static bool getConfig(llvm::Module* m, Config*& c);
 		static void doFinalization(llvm::Module* m);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
-		static std::map<llvm::Module*, Config> _module2config;
+		static ModuleDataMap<Config> _module2config;
 };
 
 } // namespace bin2llvmir
@@ -7,10 +7,12 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_DEBUGFORMAT_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_DEBUGFORMAT_H
 
+
 #include <llvm/IR/Module.h>
 
 #include "retdec/bin2llvmir/providers/demangler.h"
 #include "retdec/bin2llvmir/providers/fileimage.h"
+#include "retdec/bin2llvmir/providers/module_data_map.h"
 #include "retdec/debugformat/debugformat.h"
 
 namespace retdec {
@@ -49,10 +51,11 @@ class DebugFormatProvider
 		static bool getDebugFormat(llvm::Module* m, DebugFormat*& df);
 
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		/// Mapping of modules to debug info associated with them.
-		static std::map<llvm::Module*, DebugFormat> _module2debug;
+		static ModuleDataMap<DebugFormat> _module2debug;
 };
 
 } // namespace bin2llvmir
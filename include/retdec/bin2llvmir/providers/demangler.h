@@ -12,6 +12,7 @@
 #include <llvm/IR/Module.h>
 
 #include "retdec/bin2llvmir/providers/config.h"
+#include "retdec/bin2llvmir/providers/module_data_map.h"
 #include "retdec/common/tool_info.h"
 #include "retdec/demangler/demangler.h"
 #include "retdec/ctypesparser/type_config.h"
@@ -107,10 +108,11 @@ public:
 		Demangler *&d);
 
 	static void clear();
+	static void clear(llvm::Module *m);
 
 private:
 	/// Mapping of modules to demanglers associated with them.
-	static std::map<llvm::Module *, std::unique_ptr<Demangler>> _module2demangler;
+	static ModuleDataMap<std::unique_ptr<Demangler>> _module2demangler;
 };
 
 } // namespace bin2llvmir
@@ -7,6 +7,7 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_FILEIMAGE_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_FILEIMAGE_H
 
+
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Value.h>
@@ -15,6 +16,7 @@
 #include "retdec/bin2llvmir/providers/abi/abi.h"
 #include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/providers/debugformat.h"
+#include "retdec/bin2llvmir/providers/module_data_map.h"
 #include "retdec/loader/loader/image.h"
 #include "retdec/rtti-finder/rtti_finder.h"
 
@@ -134,6 +136,7 @@ class FileImageProvider
 				FileImage*& img);
 
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static FileImage* addFileImage(
@@ -142,7 +145,7 @@ class FileImageProvider
 
 	private:
 		/// Mapping of modules to file images associated with them.
-		static std::map<llvm::Module*, FileImage> _module2image;
+		static ModuleDataMap<FileImage> _module2image;
 };
 
 } // namespace bin2llvmir
@@ -7,11 +7,16 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_LTI_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_LTI_H
 
+#include <mutex>
+#include <tuple>
+#include <vector>
+
 #include <llvm/IR/Module.h>
 
 #include "retdec/ctypesparser/json_ctypes_parser.h"
 #include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/providers/fileimage.h"
+#include "retdec/bin2llvmir/providers/module_data_map.h"
 #include "retdec/ctypesparser/type_config.h"
 
 namespace retdec {
@@ -40,8 +45,24 @@ class Lti
 		FunctionPair getPairFunction(const std::string& name);
 		llvm::Function* getLlvmFunction(const std::string& name);
 
+		static void clearCache();
+
+	private:
+		/// Key of the parsed LTI modules cache: bit size, type widths and
+		/// paths of the loaded LTI files.
+		using LtiModuleKey = std::tuple<
+				unsigned,
+				ctypesparser::TypeConfig::TypeWidths,
+				std::vector<std::string>>;
+
 	private:
-		void loadLtiFile(const std::string& filePath);
+		static std::shared_ptr<retdec::ctypes::Module> getLtiModule(
+				const LtiModuleKey& key);
+		static void loadLtiFile(
+				const std::string& filePath,
+				ctypesparser::JSONCTypesParser& parser,
+				std::unique_ptr<retdec::ctypes::Module>& module,
+				const ctypesparser::TypeConfig::TypeWidths& typeWidths);
 		llvm::Type* getLlvmType(std::shared_ptr<retdec::ctypes::Type> type);
 
 	private:
@@ -49,8 +70,14 @@ class Lti
 		Config* _config = nullptr;
 		std::shared_ptr<ctypesparser::TypeConfig> _typeConfig;
 		retdec::loader::Image* _image = nullptr;
-		std::unique_ptr<retdec::ctypes::Module> _ltiModule;
-		ctypesparser::JSONCTypesParser _ltiParser;
+		/// Shared by all the LTI instances with the same key, must not be
+		/// modified.
+		std::shared_ptr<retdec::ctypes::Module> _ltiModule;
+
+	private:
+		static std::map<LtiModuleKey, std::shared_ptr<retdec::ctypes::Module>>
+				_ltiModules;
+		static std::mutex _ltiModulesMutex;
 };
 
 class LtiProvider
@@ -64,9 +91,10 @@ class LtiProvider
 		static Lti* getLti(llvm::Module* m);
 		static bool getLti(llvm::Module* m, Lti*& lti);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
-		static std::map<llvm::Module*, Lti> _module2lti;
+		static ModuleDataMap<Lti> _module2lti;
 };
 
 } // namespace bin2llvmir
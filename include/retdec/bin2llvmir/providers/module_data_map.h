@@ -0,0 +1,108 @@
+/**
+ * @file include/retdec/bin2llvmir/providers/module_data_map.h
+ * @brief Thread-safe map of provider data indexed by LLVM modules.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_BIN2LLVMIR_PROVIDERS_MODULE_DATA_MAP_H
+#define RETDEC_BIN2LLVMIR_PROVIDERS_MODULE_DATA_MAP_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+namespace llvm {
+class Module;
+} // namespace llvm
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Thread-safe map of provider data indexed by LLVM modules.
+ *
+ * Every provider keeps the data of all the modules in one such map, so that
+ * several modules can be processed in parallel threads. Data are stored
+ * either directly (@c T), or owned by a pointer (@c std::unique_ptr<T>) if
+ * they are polymorphic. In both cases, getters return raw pointers, which
+ * stay valid until the data of the module are cleared.
+ */
+template <typename T>
+class ModuleDataMap
+{
+	private:
+		template <typename U>
+		static U* toPointer(U& data)
+		{
+			return &data;
+		}
+		template <typename U>
+		static U* toPointer(std::unique_ptr<U>& data)
+		{
+			return data.get();
+		}
+
+	public:
+		using Pointer = decltype(toPointer(std::declval<T&>()));
+
+	public:
+		/**
+		 * Add @a data for the module @a m. Existing data of the module are
+		 * kept, @a data are dropped in such a case.
+		 * @return Data associated with the module @a m.
+		 */
+		Pointer add(llvm::Module* m, T&& data)
+		{
+			std::unique_lock<std::shared_mutex> lock(_mutex);
+			auto p = _data.emplace(m, std::move(data));
+			return toPointer(p.first->second);
+		}
+
+		/**
+		 * @return Data associated with the module @a m, or @c nullptr if
+		 *         there are no such data.
+		 */
+		Pointer get(llvm::Module* m)
+		{
+			std::shared_lock<std::shared_mutex> lock(_mutex);
+			auto f = _data.find(m);
+			return f != _data.end() ? toPointer(f->second) : nullptr;
+		}
+
+		/**
+		 * Clear data of all the modules.
+		 */
+		void clear()
+		{
+			decltype(_data) data;
+			{
+				std::unique_lock<std::shared_mutex> lock(_mutex);
+				data.swap(_data);
+			}
+		}
+
+		/**
+		 * Clear data associated with the module @a m.
+		 */
+		void clear(llvm::Module* m)
+		{
+			typename decltype(_data)::node_type node;
+			{
+				std::unique_lock<std::shared_mutex> lock(_mutex);
+				node = _data.extract(m);
+			}
+		}
+
+	private:
+		// clear() methods destroy data only after the lock is released, so
+		// that destructors of the data may use providers.
+		std::map<llvm::Module*, T> _data;
+		std::shared_mutex _mutex;
+};
+
+} // namespace bin2llvmir
+} // namespace retdec
+
+#endif
@@ -15,6 +15,7 @@
 #include "retdec/bin2llvmir/providers/demangler.h"
 #include "retdec/bin2llvmir/providers/fileimage.h"
 #include "retdec/bin2llvmir/providers/lti.h"
+#include "retdec/bin2llvmir/providers/module_data_map.h"
 #include "retdec/common/address.h"
 
 namespace retdec {
@@ -211,9 +212,10 @@ class NamesProvider
 		static NameContainer* getNames(llvm::Module* m);
 		static bool getNames(llvm::Module* m, NameContainer*& names);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
-		static std::map<llvm::Module*, NameContainer> _module2names;
+		static ModuleDataMap<NameContainer> _module2names;
 };
 
 } // namespace bin2llvmir
@@ -0,0 +1,65 @@
+/**
+ * @file include/retdec/bin2llvmir/providers/provider_context.h
+ * @brief Access to the provider data of one decompilation.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_BIN2LLVMIR_PROVIDERS_PROVIDER_CONTEXT_H
+#define RETDEC_BIN2LLVMIR_PROVIDERS_PROVIDER_CONTEXT_H
+
+namespace llvm {
+class Module;
+} // namespace llvm
+
+namespace retdec {
+namespace bin2llvmir {
+
+class Abi;
+class Config;
+class DebugFormat;
+class Demangler;
+class FileImage;
+class Lti;
+class NameContainer;
+
+/**
+ * Access to the provider data of one decompilation.
+ *
+ * Providers (config, file image, ABI, ...) keep their data in process-wide
+ * thread-safe registries keyed by LLVM module. The context is only a facade
+ * over these registries for one module: it does not own any provider, the
+ * data stay in the registries. When the context is destroyed, it removes the
+ * data of its module from all the registries. Therefore, several modules can
+ * be decompiled in parallel threads, each of them with its own context.
+ *
+ * The context must be destroyed before its module.
+ */
+class ProviderContext
+{
+	public:
+		ProviderContext(llvm::Module* m);
+		~ProviderContext();
+
+		ProviderContext(const ProviderContext&) = delete;
+		ProviderContext& operator=(const ProviderContext&) = delete;
+
+		llvm::Module* getModule() const;
+		Config* getConfig() const;
+		FileImage* getFileImage() const;
+		Abi* getAbi() const;
+		Demangler* getDemangler() const;
+		DebugFormat* getDebugFormat() const;
+		Lti* getLti() const;
+		NameContainer* getNames() const;
+
+		void clear();
+		static void clear(llvm::Module* m);
+
+	private:
+		llvm::Module* _module = nullptr;
+};
+
+} // namespace bin2llvmir
+} // namespace retdec
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file include/retdec/bin2llvmir/utils/function_pass_scheduler.h
+ * @brief Runs function-local work of module passes on multiple threads.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_BIN2LLVMIR_UTILS_FUNCTION_PASS_SCHEDULER_H
+#define RETDEC_BIN2LLVMIR_UTILS_FUNCTION_PASS_SCHEDULER_H
+
+#include <algorithm>
+#include <vector>
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+
+#include "retdec/utils/parallel.h"
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Schedules function-local work of a module pass over all the function
+ * definitions in a module.
+ *
+ * LLVM IR is not safe to modify from several threads at once -- constants,
+ * types and use lists are shared by the whole context. Therefore, the work
+ * is split into two phases:
+ * 1. analysis -- must only read the IR, runs in parallel on up to
+ *    @c getJobs() functions at once,
+ * 2. application -- may modify the IR of the analysed function, runs on the
+ *    calling thread in the module's function order.
+ *
+ * Functions are processed in windows, so at most a few analysis results per
+ * thread are alive at any given time. With a single job, analysis and
+ * application alternate function by function, exactly as a plain serial
+ * loop would.
+ */
+class FunctionPassScheduler
+{
+	public:
+		FunctionPassScheduler(llvm::Module* m);
+		FunctionPassScheduler(llvm::Module* m, unsigned jobs);
+
+		unsigned getJobs() const;
+
+		/**
+		 * @param analyze Callable <tt>Result(llvm::Function&)</tt>.
+		 *                It must not modify the IR.
+		 * @param apply   Callable <tt>bool(llvm::Function&, Result&)</tt>
+		 *                returning @c true if it changed the function.
+		 * @return @c True if any @p apply call changed the IR.
+		 */
+		template <typename Result, typename Analyze, typename Apply>
+		bool run(Analyze analyze, Apply apply)
+		{
+			std::vector<llvm::Function*> fncs;
+			for (llvm::Function& f : *_module)
+			{
+				if (!f.isDeclaration())
+				{
+					fncs.push_back(&f);
+				}
+			}
+
+			bool changed = false;
+			std::size_t window = _jobs > 1 ? _jobs * windowPerJob : 1;
+			std::vector<Result> results;
+			for (std::size_t b = 0; b < fncs.size(); b += window)
+			{
+				std::size_t cnt = std::min(window, fncs.size() - b);
+				results.clear();
+				results.resize(cnt);
+
+				retdec::utils::parallelFor(cnt, _jobs, [&](std::size_t i) {
+					results[i] = analyze(*fncs[b + i]);
+				});
+
+				for (std::size_t i = 0; i < cnt; ++i)
+				{
+					changed |= apply(*fncs[b + i], results[i]);
+				}
+			}
+
+			return changed;
+		}
+
+	private:
+		/// Number of functions analysed ahead per job.
+		static const unsigned windowPerJob = 4;
+
+	private:
+		llvm::Module* _module = nullptr;
+		unsigned _jobs = 1;
+};
+
+} // namespace bin2llvmir
+} // namespace retdec
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "retdec/common/address.h"
 #include "retdec/capstone2llvmir/exceptions.h"
+#include "retdec/capstone2llvmir/insn_arena.h"
 
 // These are additions to capstone - include them all here.
 #include "retdec/capstone2llvmir/arm/arm_defs.h"
@@ -284,10 +285,20 @@ class Capstone2LlvmIrTranslator
 		 * Default value: true.
 		 */
 		virtual void setGeneratePseudoAsmFunctions(bool f) = 0;
+		/**
+		 * Arena that owns Capstone instructions created by translation
+		 * methods. The arena must outlive all the uses of the instructions.
+		 * If it is not set (@c nullptr), every instruction is allocated by
+		 * @c cs_malloc() and the caller must free it by @c cs_free().
+		 *
+		 * Default value: nullptr.
+		 */
+		virtual void setInsnArena(InsnArena* arena) = 0;
 
 		virtual bool isIgnoreUnexpectedOperands() const = 0;
 		virtual bool isIgnoreUnhandledInstructions() const = 0;
 		virtual bool isGeneratePseudoAsmFunctions() const = 0;
+		virtual InsnArena* getInsnArena() const = 0;
 //
 //==============================================================================
 // Mode query & modification methods.
@@ -433,6 +444,21 @@ class Capstone2LlvmIrTranslator
 				std::size_t& size,
 				retdec::common::Address& a,
 				llvm::IRBuilder<>& irb) = 0;
+		/**
+		 * Translate one assembly instruction that was already disassembled.
+		 * @param insn  Capstone instruction to translate. It must have been
+		 *              disassembled with details in the translator's current
+		 *              mode. The translator takes over the ownership as if it
+		 *              was allocated by @c translateOne(), i.e. it is returned
+		 *              in @c TranslationResultOne::capstoneInsn.
+		 * @param irb   LLVM IR builder used to create LLVM IR translation.
+		 *              Translated LLVM IR instructions are created at its
+		 *              current position.
+		 * @return See @c TranslationResult structure.
+		 */
+		virtual TranslationResultOne translateOneDecoded(
+				cs_insn* insn,
+				llvm::IRBuilder<>& irb) = 0;
 //
 //==============================================================================
 // Capstone related getters and query methods.
@@ -0,0 +1,67 @@
+/**
+ * @file include/retdec/capstone2llvmir/insn_arena.h
+ * @brief Arena allocator of Capstone instructions.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_CAPSTONE2LLVMIR_INSN_ARENA_H
+#define RETDEC_CAPSTONE2LLVMIR_INSN_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <capstone/capstone.h>
+
+namespace retdec {
+namespace capstone2llvmir {
+
+/**
+ * Arena owning Capstone instructions together with their details.
+ *
+ * Instructions are allocated from large chunks of fixed-size records
+ * instead of by @c cs_malloc() one by one, and they are all freed at once
+ * when the arena is cleared or destroyed. They must not be freed by
+ * @c cs_free().
+ *
+ * Pointers to allocated instructions stay valid until the arena is cleared.
+ * The arena is not thread-safe.
+ */
+class InsnArena
+{
+	public:
+		InsnArena(std::size_t chunkSize = 4096);
+
+		InsnArena(InsnArena&& other);
+		InsnArena& operator=(InsnArena&& other);
+
+		cs_insn* allocate();
+		cs_insn* allocateCopy(const cs_insn& insn);
+		void deallocate(cs_insn* insn);
+		void merge(InsnArena&& other);
+		void clear();
+
+		std::size_t size() const;
+
+	private:
+		struct Record
+		{
+			cs_insn insn;
+			cs_detail detail;
+		};
+
+	private:
+		std::vector<std::unique_ptr<Record[]>> _chunks;
+		std::size_t _chunkSize = 0;
+		/// Chunk the records are allocated from, @c nullptr if there is none.
+		Record* _current = nullptr;
+		/// Number of used records in the current chunk.
+		std::size_t _used = 0;
+		/// Number of allocated instructions.
+		std::size_t _size = 0;
+};
+
+} // namespace capstone2llvmir
+} // namespace retdec
+
+#endif
@@ -64,6 +64,10 @@ class Parameters
 		void setMaxMemoryLimit(uint64_t limit);
 		void setIsMaxMemoryLimitHalfRam(bool f);
 		void setTimeout(uint64_t seconds);
+		void setJobs(uint64_t jobs);
+		void setCacheDir(const std::string& dir);
+		void setCacheMaxSize(uint64_t size);
+		void setSelectedDecodeDepth(uint64_t depth);
 		void setEntryPoint(const retdec::common::Address& a);
 		void setMainAddress(const retdec::common::Address& a);
 		void setSectionVMA(const retdec::common::Address& a);
@@ -99,6 +103,10 @@ class Parameters
 		const std::string& getErrFile() const;
 		uint64_t getMaxMemoryLimit() const;
 		uint64_t getTimeout() const;
+		uint64_t getJobs() const;
+		const std::string& getCacheDir() const;
+		uint64_t getCacheMaxSize() const;
+		uint64_t getSelectedDecodeDepth() const;
 		retdec::common::Address getEntryPoint() const;
 		retdec::common::Address getMainAddress() const;
 		retdec::common::Address getSectionVMA() const;
@@ -165,6 +173,17 @@ class Parameters
 		uint64_t _maxMemoryLimit = 0;
 		bool _maxMemoryLimitHalfRam = true;
 		uint64_t _timeout = 0;
+		/// Number of threads used by the parallelized parts of
+		/// the decompilation. Zero means all hardware threads.
+		uint64_t _jobs = 1;
+		/// Directory of the persistent cache of decompiled functions.
+		/// Empty means that the cache is not used.
+		std::string _cacheDir;
+		/// Maximal size of the cache (in bytes).
+		uint64_t _cacheMaxSize = 1024 * 1024 * 1024;
+		/// Depth of calls from the selected functions up to which
+		/// the called functions are also decoded in selective decoding.
+		uint64_t _selectedDecodeDepth = 0;
 
 		bool _detectStaticCode = true;
 		std::string _backendDisabledOpts;
@@ -7,6 +7,9 @@
 #ifndef RETDEC_CPDETECT_SEARCH_H
 #define RETDEC_CPDETECT_SEARCH_H
 
+#include <cstdint>
+#include <unordered_map>
+
 #include "retdec/cpdetect/cptypes.h"
 #include "retdec/fileformat/file_format/file_format.h"
 
@@ -40,9 +43,37 @@ class Search
 				/// @}
 		};
 	private:
+		/**
+		 * Signature pattern without slashes prepared for comparison with
+		 * bytes of file. For both possible alignments of the pattern to bytes
+		 * (first nibble of pattern in high or low nibble of byte), nibbles of
+		 * the pattern are paired into bytes of values and bytes of masks of
+		 * significant bits.
+		 */
+		struct CompiledPattern
+		{
+			/// length of pattern in nibbles
+			std::size_t length = 0;
+			/// @c false if pattern contains character which is never present
+			/// in hexadecimal representation of file
+			bool matchable = true;
+			/// values of bytes for both alignments
+			std::vector<std::uint8_t> values[2];
+			/// masks of significant bits for both alignments
+			std::vector<std::uint8_t> masks[2];
+		};
+
 		retdec::fileformat::FileFormat &parser;
-		/// content of file in hexadecimal string representation
-		std::string nibbles;
+		/// content of file
+		llvm::ArrayRef<unsigned char> bytes;
+		/// content of file in hexadecimal string representation, it is
+		/// created only if it can not be read directly from @c bytes
+		/// or if it is explicitly requested by @c getNibbles()
+		mutable std::string nibbles;
+		/// @c true if nibbles of file are read directly from @c bytes
+		bool directNibbles;
+		/// patterns compiled by @c compilePattern()
+		mutable std::unordered_map<std::string, CompiledPattern> compiledPatterns;
 		/// content of file as plain string
 		std::string plain;
 		/// representation of supported relative jumps
@@ -60,6 +91,16 @@ class Search
 		bool haveSlashes() const;
 		std::size_t nibblesFromBytes(std::size_t nBytes) const;
 		std::size_t bytesFromNibbles(std::size_t nNibbles) const;
+		std::size_t getNumberOfNibbles() const;
+		char getNibble(std::size_t nibbleIndex) const;
+		bool hasNibblesOnPosition(
+				const std::string &str,
+				std::size_t nibbleIndex) const;
+		const CompiledPattern& compilePattern(
+				const std::string &signPattern) const;
+		bool hasPatternOnPosition(
+				const CompiledPattern &pattern,
+				std::size_t nibbleIndex) const;
 		/// @}
 	public:
 		Search(retdec::fileformat::FileFormat &fileParser);
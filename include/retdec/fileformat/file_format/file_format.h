@@ -7,15 +7,22 @@
 #ifndef RETDEC_FILEFORMAT_FILE_FORMAT_FILE_FORMAT_H
 #define RETDEC_FILEFORMAT_FILE_FORMAT_FILE_FORMAT_H
 
+#include <array>
 #include <fstream>
+#include <functional>
 #include <initializer_list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <utility>
 #include <vector>
 
+#include <llvm/ADT/ArrayRef.h>
+
 #include "retdec/utils/byte_value_storage.h"
+#include "retdec/utils/mapped_file.h"
 #include "retdec/utils/non_copyable.h"
 #include "retdec/fileformat/fftypes.h"
 #include "retdec/fileformat/utils/byte_array_buffer.h"
@@ -41,10 +48,11 @@ struct LoaderErrorInfo
 class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils::NonCopyable
 {
 	private:
+		std::shared_ptr<const retdec::utils::MappedFile> mappedFile; ///< memory-mapped input file
 		byte_array_buffer auxBuff;               ///< auxiliary input buffer
-		std::ifstream auxFStream;                ///< auxiliary input file stream
 		std::istream auxIStream;                 ///< auxiliary input stream
-		std::vector<unsigned char> *loadedBytes; ///< reference to serialized content of input file
+		std::vector<unsigned char> ownedBytes;   ///< content of input file which is not mapped
+		llvm::ArrayRef<unsigned char> loadedBytes; ///< serialized content of input file
 		LoadFlags loadFlags;                     ///< load flags for configurable file loading
 
 		/// @name Initialization methods
@@ -58,6 +66,28 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		virtual std::size_t initSectionTableHashOffsets() = 0;
 		/// @}
 	protected:
+		/**
+		 * Parts of file which are loaded on first use
+		 */
+		enum class LazyPart
+		{
+			Strings,
+			Certificates,
+			PdbInfo,
+			VisualBasicInfo,
+			DotnetTypes,
+			Count
+		};
+
+		/**
+		 * Loader of one lazily loaded part of file
+		 */
+		struct LazyLoader
+		{
+			std::function<void()> load; ///< loads the part (empty if the part is not available)
+			std::once_flag loaded;      ///< ensures that the part is loaded only once
+		};
+
 		std::string crc32;                                                ///< CRC32 of file content
 		std::string md5;                                                  ///< MD5 of file content
 		std::string sha256;                                               ///< SHA256 of file content
@@ -71,7 +101,7 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		std::vector<SymbolTable*> symbolTables;                           ///< symbol tables
 		std::vector<RelocationTable*> relocationTables;                   ///< relocation tables
 		std::vector<DynamicTable*> dynamicTables;                         ///< tables with dynamic records
-		std::vector<unsigned char> bytes;                                 ///< content of file as bytes
+		llvm::ArrayRef<unsigned char> bytes;                              ///< content of file as bytes
 		std::vector<String> strings;                                      ///< detected strings
 		std::vector<ElfNoteSecSeg> noteSecSegs;                           ///< note sections or segemnts found in ELF file
 		std::set<std::uint64_t> unknownRelocs;                            ///< unknown relocations
@@ -91,6 +121,7 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		std::optional<bool> signatureVerified;                            ///< indicates whether the signature is present and also verified
 		retdec::common::RangeContainer<std::uint64_t> nonDecodableRanges;  ///< Address ranges which should not be decoded for instructions.
 		std::vector<std::pair<std::string, std::string>> anomalies;       ///< file format anomalies
+		mutable std::array<LazyLoader, static_cast<std::size_t>(LazyPart::Count)> lazyLoaders; ///< loaders of parts loaded on first use
 
 		/// @name Clear methods
 		/// @{
@@ -102,9 +133,16 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		void computeSectionTableHashes();
 		/// @}
 
+		/// @name Lazy loading methods
+		/// @{
+		void setLazyLoader(LazyPart part, std::function<void()> loader);
+		void loadLazily(LazyPart part) const;
+		/// @}
+
 		/// @name Setters
 		/// @{
 		void setLoadedBytes(std::vector<unsigned char> *lBytes);
+		void appendBytes(const std::vector<unsigned char> &aBytes);
 		/// @}
 
 	public:
@@ -259,8 +297,8 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		const std::vector<SymbolTable*>& getSymbolTables() const;
 		const std::vector<RelocationTable*>& getRelocationTables() const;
 		const std::vector<DynamicTable*>& getDynamicTables() const;
-		const std::vector<unsigned char>& getBytes() const;
-		const std::vector<unsigned char>& getLoadedBytes() const;
+		llvm::ArrayRef<unsigned char> getBytes() const;
+		llvm::ArrayRef<unsigned char> getLoadedBytes() const;
 		const unsigned char* getBytesData() const;
 		const unsigned char* getLoadedBytesData() const;
 		const std::vector<String>& getStrings() const;
@@ -126,7 +126,7 @@ class RawDataFormat : public FileFormat
 			assert(section && "Section must be initialized in constructor");
 			std::vector<unsigned char> aBytes(pd, pd + sizeof(d));
 			const auto pos = bytes.size();
-			bytes.insert(bytes.end(), aBytes.begin(), aBytes.end());
+			appendBytes(aBytes);
 			section->setSizeInFile(bytes.size());
 			section->setSizeInMemory(bytes.size());
 			section->load(this);
@@ -8,6 +8,7 @@
 #define RETDEC_FILEFORMAT_TYPES_RESOURCE_TABLE_RESOURCE_TABLE_H
 
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -46,11 +47,14 @@ class ResourceTable
 		std::vector<ResourceIcon *> icons;                           ///< icons
 		std::vector<std::pair<std::string, std::string>> languages;  ///< supported languages, LCID and code page
 		std::vector<std::pair<std::string, std::string>> strings;    ///< version info strings
-		std::string iconHashCrc32;                                   ///< iconhash CRC32
-		std::string iconHashMd5;                                     ///< iconhash MD5
-		std::string iconHashSha256;                                  ///< iconhash SHA256
-		std::string iconPerceptualAvgHash;                           ///< icon perceptual hash AvgHash
+		mutable std::string iconHashCrc32;                           ///< iconhash CRC32
+		mutable std::string iconHashMd5;                             ///< iconhash MD5
+		mutable std::string iconHashSha256;                          ///< iconhash SHA256
+		mutable std::string iconPerceptualAvgHash;                   ///< icon perceptual hash AvgHash
+		bool iconHashesRequested = false;                            ///< @c true if icon hashes should be computed
+		mutable std::once_flag iconHashesComputed;                   ///< ensures that icon hashes are computed only once
 
+		void loadIconHashes() const;
 		std::string computePerceptualAvgHash(const ResourceIcon &icon) const;
 		bool parseVersionInfo(const std::vector<std::uint8_t> &bytes);
 		bool parseVersionInfoChild(const std::vector<std::uint8_t> &bytes, std::size_t &offset);
@@ -18,6 +18,35 @@ std::string getMd5(const unsigned char *data, std::uint64_t length);
 std::string getSha1(const unsigned char *data, std::uint64_t length);
 std::string getSha256(const unsigned char *data, std::uint64_t length);
 
+/**
+ * Digests which can be computed by @c computeDigests().
+ */
+enum Digest : unsigned
+{
+	DIGEST_CRC32   = 1 << 0,
+	DIGEST_MD5     = 1 << 1,
+	DIGEST_SHA1    = 1 << 2,
+	DIGEST_SHA256  = 1 << 3,
+	DIGEST_ENTROPY = 1 << 4
+};
+
+/**
+ * Digests computed by @c computeDigests(). Only the requested ones are set.
+ */
+struct DataDigests
+{
+	std::string crc32;
+	std::string md5;
+	std::string sha1;
+	std::string sha256;
+	double entropy = 0.0; ///< entropy in <0,8>
+};
+
+DataDigests computeDigests(
+		const unsigned char *data,
+		std::uint64_t length,
+		unsigned digests = DIGEST_CRC32 | DIGEST_MD5 | DIGEST_SHA256);
+
 } // namespace fileformat
 } // namespace retdec
 
@@ -7,6 +7,7 @@
 #ifndef RETDEC_FILEFORMAT_UTILS_OTHER_H
 #define RETDEC_FILEFORMAT_UTILS_OTHER_H
 
+#include <array>
 #include <string>
 #include <vector>
 
@@ -22,6 +23,9 @@ std::vector<std::string> getSupportedArchitectures();
 std::string lcidToStr(std::size_t lcid);
 std::string codePageToStr(std::size_t cpage);
 double computeDataEntropy(const std::uint8_t *data, std::size_t dataLen);
+double computeHistogramEntropy(
+		const std::array<std::size_t, 256> &histogram,
+		std::size_t dataLen);
 
 } // namespace fileformat
 } // namespace retdec
@@ -0,0 +1,133 @@
+/**
+* @file include/retdec/llvmir2hll/hll/func_output_cache.h
+* @brief A persistent cache of the emitted code of functions.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_LLVMIR2HLL_HLL_FUNC_OUTPUT_CACHE_H
+#define RETDEC_LLVMIR2HLL_HLL_FUNC_OUTPUT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "retdec/llvmir2hll/hll/output_managers/recording_manager.h"
+#include "retdec/llvmir2hll/support/smart_ptr.h"
+#include "retdec/llvmir2hll/support/types.h"
+#include "retdec/utils/file_cache.h"
+#include "retdec/utils/non_copyable.h"
+
+namespace llvm {
+
+class Module;
+
+} // namespace llvm
+
+namespace retdec {
+
+namespace config {
+
+class Config;
+
+} // namespace config
+
+namespace llvmir2hll {
+
+class Function;
+class Module;
+class OutputManager;
+
+/**
+* @brief A persistent cache of the emitted code of functions.
+*
+* The code of a function is identified by a hash of everything it depends on:
+* the LLVM IR of the function (which reflects its bytes and relocations), the
+* global variables it refers to, the information about the function from the
+* config (address range, calling convention, comment, etc.), the hashes of all
+* the functions it (transitively) calls, the version of RetDec, and the given
+* context (the options of the decompilation). Hence, entries in the cache never
+* need to be invalidated; when a binary changes, only the functions that are
+* affected by the change get new keys.
+*
+* Functions whose code is found in the cache are marked in the module (see
+* Module::markFuncOutputAsCached()), so they are not optimized. Global
+* variables and functions their code refers to are prevented from removal (see
+* Module::preventRemovalOfVar()). Their code is then emitted from the cache.
+* The code of the other functions is stored into the cache after it is emitted.
+*
+* Names of global variables and functions are stored in their initial form
+* (before renaming) and are mapped to the current names when the code is
+* emitted.
+*/
+class FuncOutputCache: private retdec::utils::NonCopyable {
+public:
+	FuncOutputCache(const std::string &dir, std::uint64_t maxSize,
+		const std::string &context);
+
+	std::size_t loadOutputs(ShPtr<Module> module,
+		llvm::Module &llvmModule, const retdec::config::Config &config);
+	FuncVector dropUnusableOutputs();
+	bool emitCachedOutput(ShPtr<Function> func, OutputManager &out) const;
+	void storeOutput(ShPtr<Function> func,
+		const RecordingOutputManager::Tokens &tokens);
+	void evict();
+
+private:
+	/// Mapping of a function into its key in the cache.
+	using FuncKeyMap = std::map<ShPtr<Function>, std::string>;
+
+	/// Output of a function loaded from the cache.
+	struct CachedOutput {
+		/// Emitted tokens.
+		RecordingOutputManager::Tokens tokens;
+
+		/// Indexes of tokens whose values are initial names of global
+		/// variables or functions.
+		std::vector<std::size_t> nameTokens;
+	};
+
+	/// Mapping of a function into its output loaded from the cache.
+	using FuncOutputMap = std::map<ShPtr<Function>, CachedOutput>;
+
+private:
+	void computeKeys(llvm::Module &llvmModule,
+		const retdec::config::Config &config);
+	StringVarMap getInitialNameToVarMap() const;
+	bool refersOnlyToExistingVars(const CachedOutput &output,
+		const StringVarMap &vars) const;
+	void computeNameMapsForEmission() const;
+
+private:
+	/// The underlying on-disk cache.
+	retdec::utils::FileCache cache;
+
+	/// Options of the decompilation that affect the emitted code.
+	std::string context;
+
+	/// The module whose functions are cached.
+	ShPtr<Module> module;
+
+	/// Keys of functions in the cache.
+	FuncKeyMap keys;
+
+	/// Outputs of functions loaded from the cache.
+	FuncOutputMap outputs;
+
+	/// Have the following mappings of names been computed?
+	/// They are computed when the first function is emitted because global
+	/// variables and functions may be renamed before that.
+	mutable bool nameMapsComputed = false;
+
+	/// Mapping of initial names into current names during the emission.
+	mutable StringStringMap currentNames;
+
+	/// Mapping of current names into initial names during the emission.
+	mutable StringStringMap initialNames;
+};
+
+} // namespace llvmir2hll
+} // namespace retdec
+
+#endif
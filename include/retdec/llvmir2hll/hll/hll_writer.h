@@ -26,6 +26,7 @@ namespace llvmir2hll {
 
 class BinaryOpExpr;
 class BracketManager;
+class FuncOutputCache;
 class UnaryOpExpr;
 
 /**
@@ -55,6 +56,8 @@ public:
 	void setOptionUseCompoundOperators(bool use = true);
 	/// @}
 
+	void setFuncOutputCache(ShPtr<FuncOutputCache> cache);
+
 protected:
 	HLLWriter(llvm::raw_ostream &out, const std::string& outputFormat = "");
 
@@ -215,6 +218,8 @@ private:
 	bool emitMetaInfoDecompilationDate();
 	/// @}
 
+	bool emitFunctionUsingCache(ShPtr<Function> func);
+
 	std::string getRawGotoLabel(ShPtr<Statement> stmt);
 	std::string getReadableClassName(const std::string &cl) const;
 	StringVector getReadableClassNames(const StringVector &classes) const;
@@ -222,6 +227,9 @@ private:
 private:
 	/// Spaces to indent the current block.
 	std::string currentIndent;
+
+	/// Cache of the emitted code of functions (if any).
+	ShPtr<FuncOutputCache> funcOutputCache;
 };
 
 } // namespace llvmir2hll
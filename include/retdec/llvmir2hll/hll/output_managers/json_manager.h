@@ -11,7 +11,6 @@
 
 #include <rapidjson/writer.h>
 #include <rapidjson/prettywriter.h>
-#include <rapidjson/stringbuffer.h>
 #include <rapidjson/encodings.h>
 
 #include <llvm/Support/raw_ostream.h>
@@ -23,11 +22,36 @@ namespace llvmir2hll {
 
 class OutputManager;
 
+/**
+* @brief RapidJSON output stream writing directly into an LLVM output stream.
+*
+* The LLVM stream does its own (bounded) buffering, so the JSON output does
+* not need to be kept in memory as a whole.
+*/
+class JsonOutputStream
+{
+	public:
+		using Ch = char;
+
+	public:
+		JsonOutputStream(llvm::raw_ostream& out) : _out(out) {}
+
+		void Put(Ch c) { _out << c; }
+		void Flush() { _out.flush(); }
+
+	private:
+		llvm::raw_ostream& _out;
+};
+
+// RapidJSON finds these through argument-dependent lookup.
+inline void PutReserve(JsonOutputStream&, std::size_t) {}
+inline void PutUnsafe(JsonOutputStream& stream, char c) { stream.Put(c); }
+
 template <typename Writer>
 class JsonOutputManager : public OutputManager
 {
 	public:
-		JsonOutputManager(llvm::raw_ostream& out);
+		JsonOutputManager(llvm::raw_ostream& out, bool compact = false);
 		virtual void finalize() override;
 
 	public:
@@ -59,15 +83,16 @@ class JsonOutputManager : public OutputManager
 		virtual void addressPop() override;
 
 	private:
-		void jsonToken(const std::string& k, const std::string& v);
+		void jsonToken(std::size_t k, const std::string& v);
 		void generateAddressEntry(Address a);
 
 	private:
-		llvm::raw_ostream& _out;
-
-		rapidjson::StringBuffer sb;
+		JsonOutputStream _stream;
 		Writer writer;
 
+		/// Emit tokens in the compact form (see the constructor).
+		bool _compact = false;
+
 		std::stack<std::pair<Address, bool>> _addrs;
 		std::pair<Address, bool> _addrToGenerate;
 		/**
@@ -87,10 +112,10 @@ class JsonOutputManager : public OutputManager
 };
 
 using JsonOutputManagerPlain =
-		JsonOutputManager<rapidjson::Writer<rapidjson::StringBuffer, rapidjson::ASCII<>>>;
+		JsonOutputManager<rapidjson::Writer<JsonOutputStream, rapidjson::ASCII<>>>;
 
 using JsonOutputManagerPretty =
-		JsonOutputManager<rapidjson::PrettyWriter<rapidjson::StringBuffer, rapidjson::ASCII<>>>;
+		JsonOutputManager<rapidjson::PrettyWriter<JsonOutputStream, rapidjson::ASCII<>>>;
 
 } // namespace llvmir2hll
 } // namespace retdec
@@ -0,0 +1,118 @@
+/**
+* @file include/retdec/llvmir2hll/hll/output_managers/recording_manager.h
+* @brief An output manager that records tokens passed to another manager.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_LLVMIR2HLL_HLL_OUTPUT_MANAGERS_RECORDING_MANAGER_H
+#define RETDEC_LLVMIR2HLL_HLL_OUTPUT_MANAGERS_RECORDING_MANAGER_H
+
+#include <string>
+#include <vector>
+
+#include "retdec/llvmir2hll/hll/output_manager.h"
+
+namespace retdec {
+namespace llvmir2hll {
+
+/**
+* @brief Output manager that passes all tokens to another output manager and
+*        records them, so they can be replayed later.
+*
+* Only the primitive tokens are recorded. Token sequences created by the
+* helpers in @c OutputManager are recorded as the primitive tokens they
+* consist of.
+*/
+class RecordingOutputManager : public OutputManager
+{
+	public:
+		/// Kinds of the recorded tokens.
+		enum class TokenKind
+		{
+			NewLine,
+			Space,
+			Punctuation,
+			Operator,
+			GlobalVariableId,
+			LocalVariableId,
+			MemberId,
+			LabelId,
+			FunctionId,
+			ParameterId,
+			Keyword,
+			DataType,
+			Preprocessor,
+			Include,
+			ConstantBool,
+			ConstantInt,
+			ConstantFloat,
+			ConstantString,
+			ConstantSymbol,
+			ConstantPointer,
+			Comment,
+			CommentModifier,
+			AddressPush,
+			AddressPop
+		};
+
+		/// Recorded token.
+		struct Token
+		{
+			TokenKind kind;
+			/// Text of the token (empty for tokens without text).
+			std::string value;
+			/// Address of @c TokenKind::AddressPush tokens.
+			Address address;
+		};
+
+		using Tokens = std::vector<Token>;
+
+	public:
+		RecordingOutputManager(OutputManager& out);
+
+		const Tokens& getTokens() const;
+
+		static void replay(const Tokens& tokens, OutputManager& out);
+
+	public:
+		virtual void newLine() override;
+		virtual void space(const std::string& space = " ") override;
+		virtual void punctuation(char p) override;
+		virtual void operatorX(const std::string& op) override;
+		virtual void globalVariableId(const std::string& id) override;
+		virtual void localVariableId(const std::string& id) override;
+		virtual void memberId(const std::string& id) override;
+		virtual void labelId(const std::string& id) override;
+		virtual void functionId(const std::string& id) override;
+		virtual void parameterId(const std::string& id) override;
+		virtual void keyword(const std::string& k) override;
+		virtual void dataType(const std::string& t) override;
+		virtual void preprocessor(const std::string& p) override;
+		virtual void include(const std::string& i) override;
+		virtual void constantBool(const std::string& c) override;
+		virtual void constantInt(const std::string& c) override;
+		virtual void constantFloat(const std::string& c) override;
+		virtual void constantString(const std::string& c) override;
+		virtual void constantSymbol(const std::string& c) override;
+		virtual void constantPointer(const std::string& c) override;
+		virtual void comment(const std::string& comment) override;
+
+	public:
+		virtual void commentModifier() override;
+		virtual void addressPush(Address a) override;
+		virtual void addressPop() override;
+
+	private:
+		void record(TokenKind kind, const std::string& value = "");
+
+	private:
+		/// Manager to which the tokens are passed.
+		OutputManager& _out;
+		/// Recorded tokens.
+		Tokens _tokens;
+};
+
+} // namespace llvmir2hll
+} // namespace retdec
+
+#endif
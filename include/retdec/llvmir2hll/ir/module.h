@@ -113,6 +113,14 @@ public:
 
 	bool isExportedFunc(ShPtr<Function> func) const;
 
+	bool isFuncOutputCached(ShPtr<Function> func) const;
+	FuncSet getFuncsWithCachedOutput() const;
+	void markFuncOutputAsCached(ShPtr<Function> func);
+	void unmarkFuncOutputAsCached(ShPtr<Function> func);
+
+	bool canRemoveVar(ShPtr<Variable> var) const;
+	void preventRemovalOfVar(ShPtr<Variable> var);
+
 	std::string getRealNameForFunc(ShPtr<Function> func) const;
 	std::string getDeclarationStringForFunc(ShPtr<Function> func) const;
 	std::string getCommentForFunc(ShPtr<Function> func) const;
@@ -179,6 +187,15 @@ public:
 	StringSet getSelectedButNotFoundFuncs() const;
 	/// @}
 
+	/// @name Modification Tracking
+	/// @{
+	std::size_t getModificationEpoch() const;
+	void markFuncAsModified(ShPtr<Function> func);
+	void markAllFuncsAsModified();
+	void markFuncAsOptimizedBy(ShPtr<Function> func, const std::string &optId);
+	bool isFuncOptimizedBy(ShPtr<Function> func, const std::string &optId) const;
+	/// @}
+
 private:
 	/// Mapping of a function into an address range.
 	using FuncAddressRangeMap = std::map<ShPtr<Function>, AddressRange>;
@@ -205,6 +222,26 @@ private:
 	/// Mapping of a variable into its name in the debug information.
 	VarStringMap debugVarNameMap;
 
+	/// Functions whose output is taken from the cache of function outputs.
+	FuncSet funcsWithCachedOutput;
+
+	/// Global variables and functions that optimizations must not remove.
+	VarSet varsPreventedFromRemoval;
+
+	/// Incremented whenever a function is marked as modified.
+	std::size_t modificationEpoch = 0;
+
+	/// Epoch in which all functions were marked as modified.
+	std::size_t allFuncsModificationEpoch = 0;
+
+	/// Epochs in which functions were marked as modified.
+	std::map<ShPtr<Function>, std::size_t> funcModificationEpochs;
+
+	/// Epochs in which functions were optimized by optimizers (by their ID)
+	/// without being modified.
+	std::map<std::string, std::map<ShPtr<Function>, std::size_t>>
+		funcOptimizationEpochs;
+
 private:
 	bool hasFuncSatisfyingPredicate(
 		std::function<bool (ShPtr<Function>)> pred
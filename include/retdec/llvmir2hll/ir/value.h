@@ -7,6 +7,7 @@
 #ifndef RETDEC_LLVMIR2HLL_IR_VALUE_H
 #define RETDEC_LLVMIR2HLL_IR_VALUE_H
 
+#include <cstddef>
 #include <iosfwd>
 #include <string>
 
@@ -16,6 +17,7 @@
 #include "retdec/llvmir2hll/support/observer.h"
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 #include "retdec/llvmir2hll/support/subject.h"
+#include "retdec/llvmir2hll/support/value_allocator.h"
 #include "retdec/llvmir2hll/support/visitable.h"
 #include "retdec/utils/non_copyable.h"
 
@@ -68,6 +70,18 @@ public:
 
 	std::string getTextRepr();
 
+	/// @name Allocation
+	/// @{
+	// Values are allocated from a pool (see ValueAllocator).
+	static void *operator new(std::size_t size) {
+		return ValueAllocator::allocate(size);
+	}
+
+	static void operator delete(void *ptr, std::size_t size) {
+		ValueAllocator::deallocate(ptr, size);
+	}
+	/// @}
+
 protected:
 	Value() = default;
 };
@@ -4,6 +4,8 @@
 * \copyright (c) 2020 Avast Software, licensed under the MIT license
 */
 
+#include <optional>
+
 #include <llvm/ADT/Triple.h>
 #include <llvm/Analysis/LoopInfo.h>
 #include <llvm/Analysis/ScalarEvolution.h>
@@ -43,6 +45,7 @@
 #include "retdec/llvmir2hll/graphs/cg/cg_builder.h"
 #include "retdec/llvmir2hll/graphs/cg/cg_writer.h"
 #include "retdec/llvmir2hll/graphs/cg/cg_writer_factory.h"
+#include "retdec/llvmir2hll/hll/func_output_cache.h"
 #include "retdec/llvmir2hll/hll/hll_writer.h"
 #include "retdec/llvmir2hll/hll/hll_writer_factory.h"
 #include "retdec/llvmir2hll/ir/function.h"
@@ -76,6 +79,8 @@
 #include "retdec/utils/container.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/memory.h"
+#include "retdec/utils/parallel.h"
+#include "retdec/utils/profiler.h"
 #include "retdec/utils/string.h"
 
 #ifndef RETDEC_LLVMIR2HLL_LLVMIR2HLL_H
@@ -124,8 +129,10 @@ private:
 	void fixSignedUnsignedTypes();
 	void convertLLVMIntrinsicFunctions();
 	void obtainDebugInfo();
+	void loadCachedFuncOutputs();
 	void initAliasAnalysis();
 	void runOptimizations();
+	void runOptimizationsWithoutFuncs(const llvmir2hll::FuncSet &funcs);
 	void renameVariables();
 	void convertConstantsToSymbolicNames();
 	void validateResultingModule();
@@ -136,6 +143,10 @@ private:
 	void finalize();
 	void cleanup();
 
+	std::string getFuncOutputCacheContext() const;
+	void startProfiledPhase(const std::string &name);
+	void stopProfiledPhase();
+
 	llvmir2hll::StringSet parseListOfOpts(
 			const std::string &opts) const;
 	llvmir2hll::StringVector getIdsOfPatternFindersToBeRun() const;
@@ -160,6 +171,9 @@ private:
 	/// The used HLL writer.
 	ShPtr<llvmir2hll::HLLWriter> hllWriter;
 
+	/// The used cache of the emitted code of functions (if any).
+	ShPtr<llvmir2hll::FuncOutputCache> funcOutputCache;
+
 	/// The used alias analysis.
 	ShPtr<llvmir2hll::AliasAnalysis> aliasAnalysis;
 
@@ -180,6 +194,9 @@ private:
 
 	/// Output string stream.
 	std::unique_ptr<llvm::raw_string_ostream> outStringStream;
+
+	/// The currently profiled phase.
+	std::optional<retdec::utils::Profiler::Scope> profiledPhase;
 };
 
 } // namespace llvmir2hll
@@ -7,6 +7,8 @@
 #ifndef RETDEC_LLVMIR2HLL_OPTIMIZER_FUNC_OPTIMIZER_H
 #define RETDEC_LLVMIR2HLL_OPTIMIZER_FUNC_OPTIMIZER_H
 
+#include <functional>
+
 #include "retdec/llvmir2hll/optimizer/optimizer.h"
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 
@@ -39,9 +41,32 @@ class Module;
 * The functions are not optimized in any particular order. Optimizations for a
 * single function should not affect optimizations of other functions.
 *
+* If enableParallelOptimization() is called, functions are optimized in
+* parallel, each by a separate instance of the optimizer. This is safe only
+* for optimizers that do not use any module-level state (like value analysis)
+* and that do not modify anything outside of the optimized function.
+*
+* Functions modified during their optimization are marked as modified in the
+* module. If enableSkippingOfUnmodifiedFuncs() is called, functions that the
+* optimizer has already optimized without modifying them and that have not
+* been modified since then are skipped. This is safe only for deterministic
+* optimizers whose result depends only on the optimized function. Optimizers
+* that optimize a function until nothing changes may set @c fixedPointReached
+* in runOnFunction() so that the function is skipped also after it has been
+* modified.
+*
 * Instances of this class have reference object semantics.
 */
 class FuncOptimizer: public Optimizer {
+public:
+	/// Creates a new instance of the optimizer.
+	using FuncOptimizerFactory = std::function<ShPtr<FuncOptimizer>()>;
+
+public:
+	void enableParallelOptimization(unsigned jobs,
+		FuncOptimizerFactory createOptimizer);
+	void enableSkippingOfUnmodifiedFuncs();
+
 protected:
 	FuncOptimizer(ShPtr<Module> module);
 
@@ -70,6 +95,28 @@ protected:
 protected:
 	/// Function that is currently being optimized.
 	ShPtr<Function> currFunc;
+
+	/// Set in runOnFunction() if running the optimizer on the function again
+	/// would not modify it, even though this run has modified it.
+	bool fixedPointReached;
+
+private:
+	bool shouldBeOptimized(ShPtr<Function> func) const;
+	void optimizeFuncsInParallel();
+	void recordOptimizationOf(ShPtr<Function> func, bool modified,
+		bool fixedPointReached);
+
+private:
+	/// Number of functions that may be optimized in parallel.
+	unsigned jobs;
+
+	/// Creates an instance of the optimizer for every optimized function
+	/// (only when the functions are optimized in parallel).
+	FuncOptimizerFactory createOptimizer;
+
+	/// Skip functions that have not been modified since their last
+	/// optimization by this optimizer?
+	bool skipUnmodifiedFuncs;
 };
 
 } // namespace llvmir2hll
@@ -32,19 +32,26 @@ public:
 	OptimizerManager(const StringSet &enabledOpts, const StringSet &disabledOpts,
 		ShPtr<HLLWriter> hllWriter, ShPtr<ValueAnalysis> va,
 		ShPtr<CallInfoObtainer> cio, ShPtr<ArithmExprEvaluator> arithmExprEvaluator,
-		bool enableDebug = false);
+		bool enableDebug = false, unsigned jobs = 1);
 
 	void optimize(ShPtr<Module> m);
 
 private:
 	void printOptimization(const std::string &optName) const;
 	bool optShouldBeRun(const std::string &optName) const;
-	void runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimizer);
+	void runOptimizerProvidedItShouldBeRun(ShPtr<Module> m,
+		ShPtr<Optimizer> optimizer);
 	bool shouldSecondCopyPropagationBeRun() const;
 
 	template<typename Optimization, typename... Args>
 	void run(ShPtr<Module> m, Args &&... args);
 
+	template<typename Optimization>
+	void runOnFuncsInParallel(ShPtr<Module> m);
+
+	template<typename Optimization>
+	void runOnFuncsInParallelWithEvaluator(ShPtr<Module> m);
+
 private:
 	/// No other optimization than these will be run.
 	const StringSet enabledOpts;
@@ -67,6 +74,9 @@ private:
 	/// Enable emission of debug messages?
 	bool enableDebug;
 
+	/// Maximal number of functions optimized in parallel.
+	unsigned jobs;
+
 	/// Should we recover from out-of-memory errors during optimizations?
 	bool recoverFromOutOfMemory;
 
@@ -22,11 +22,16 @@ class ArithmExprEvaluator;
 * The optimizer utilizes many sub-optimizers. They are in the @c
 * simplify_arithm_expr sub-directory.
 *
+* Every function is optimized until there are no changes. Since the sub-
+* optimizers use the evaluator of arithmetical expressions, which keeps state
+* between evaluations, every instance used when optimizing functions in
+* parallel needs its own evaluator.
+*
 * Instances of this class have reference object semantics.
 *
 * This is a concrete optimizer which should not be subclassed.
 */
-class SimplifyArithmExprOptimizer final: public Optimizer {
+class SimplifyArithmExprOptimizer final: public FuncOptimizer {
 public:
 	SimplifyArithmExprOptimizer(ShPtr<Module> module,
 		ShPtr<ArithmExprEvaluator> arithmExprEvaluator);
@@ -35,6 +40,7 @@ public:
 
 private:
 	virtual void doOptimization() override;
+	virtual void runOnFunction(ShPtr<Function> func) override;
 
 	/// @name Visitor Interface
 	/// @{
@@ -7,6 +7,8 @@
 #ifndef RETDEC_LLVMIR2HLL_SUPPORT_METADATABLE_H
 #define RETDEC_LLVMIR2HLL_SUPPORT_METADATABLE_H
 
+#include "retdec/llvmir2hll/support/modification_recorder.h"
+
 namespace retdec {
 namespace llvmir2hll {
 
@@ -24,6 +26,7 @@ public:
 	* @param[in] data Metadata to be attached.
 	*/
 	void setMetadata(T data) {
+		ModificationRecorder::recordModification();
 		this->data = data;
 	}
 
@@ -0,0 +1,94 @@
+/**
+* @file include/retdec/llvmir2hll/support/modification_recorder.h
+* @brief Recording of modifications of the IR.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_LLVMIR2HLL_SUPPORT_MODIFICATION_RECORDER_H
+#define RETDEC_LLVMIR2HLL_SUPPORT_MODIFICATION_RECORDER_H
+
+#include <cstddef>
+
+#include "retdec/utils/non_copyable.h"
+
+namespace retdec {
+namespace llvmir2hll {
+
+/**
+* @brief Records modifications of the IR done by the current thread during
+*        its lifetime.
+*
+* All the functions that modify values (setters, adding or removing
+* observers, linking statements, etc.) call recordModification(), which
+* increments the number of modifications of the innermost recorder of the
+* current thread (if any). Modifications are not propagated to outer
+* recorders.
+*
+* Usage:
+* @code
+* ModificationRecorder modifications;
+* optimizer->runOnFunction(func);
+* if (modifications.hasModifications()) {
+*     // func has been modified.
+* }
+* @endcode
+*
+* A modification may be recorded even if nothing has changed in the end, but
+* every real modification is recorded.
+*/
+class ModificationRecorder: private retdec::utils::NonCopyable {
+public:
+	/**
+	* @brief Starts recording modifications done by the current thread.
+	*/
+	ModificationRecorder(): outer(current) {
+		current = this;
+	}
+
+	/**
+	* @brief Stops recording modifications.
+	*/
+	~ModificationRecorder() {
+		current = outer;
+	}
+
+	/**
+	* @brief Returns @c true if a modification has been recorded, @c false
+	*        otherwise.
+	*/
+	bool hasModifications() const {
+		return numOfModifications > 0;
+	}
+
+	/**
+	* @brief Returns the number of recorded modifications.
+	*/
+	std::size_t getNumOfModifications() const {
+		return numOfModifications;
+	}
+
+	/**
+	* @brief Records a modification into the innermost recorder of the current
+	*        thread (if any).
+	*/
+	static void recordModification() {
+		if (current) {
+			++current->numOfModifications;
+		}
+	}
+
+private:
+	/// Recorder that was the innermost one before this one was created.
+	ModificationRecorder *outer;
+
+	/// Number of recorded modifications.
+	std::size_t numOfModifications = 0;
+
+	/// The innermost recorder of the current thread.
+	inline static thread_local ModificationRecorder *current = nullptr;
+};
+
+} // namespace llvmir2hll
+} // namespace retdec
+
+#endif
@@ -103,10 +103,12 @@ ShPtr<To> ucast(const ShPtr<From> &ptr) noexcept {
 * @code
 * if (cast<EmptyStmt>(stmt)) {
 * @endcode
+* and, unlike @c cast<>(), it does not create a new shared pointer, so the
+* reference count of @a ptr is not touched.
 */
 template<typename To, typename From>
 bool isa(const ShPtr<From> &ptr) noexcept {
-	return cast<To>(ptr) != nullptr;
+	return dynamic_cast<To *>(ptr.get()) != nullptr;
 }
 
 /**
@@ -7,6 +7,8 @@
 #ifndef RETDEC_LLVMIR2HLL_SUPPORT_STATEMENTS_COUNTER_H
 #define RETDEC_LLVMIR2HLL_SUPPORT_STATEMENTS_COUNTER_H
 
+#include <cstddef>
+
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 #include "retdec/llvmir2hll/support/visitors/ordered_all_visitor.h"
 #include "retdec/utils/non_copyable.h"
@@ -25,6 +27,8 @@ class StatementsCounter: private OrderedAllVisitor,
 public:
 	static unsigned count(ShPtr<Statement> block, bool recursive = true,
 		bool includeEmptyStmts = false);
+	static std::size_t count(ShPtr<Module> module,
+		bool includeEmptyStmts = false);
 
 private:
 	StatementsCounter();
@@ -8,13 +8,69 @@
 #define RETDEC_LLVMIR2HLL_SUPPORT_SUBJECT_H
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 
 namespace retdec {
 namespace llvmir2hll {
 
+/**
+* @brief Locks guarding observers of subjects.
+*
+* Subjects may be shared between functions (e.g. global variables) and
+* functions may be optimized in parallel, in which case the containers of
+* observers have to be guarded. To avoid having a mutex in every subject, a
+* fixed number of mutexes is shared by all subjects. The locks are taken only
+* if they have been enabled, so serial runs do not pay for them.
+*/
+class SubjectLocks {
+public:
+	/**
+	* @brief Enables or disables locking of observers of all subjects.
+	*
+	* It must not be called while the observers are being accessed from more
+	* than one thread.
+	*/
+	static void enable(bool enable) {
+		enabled = enable;
+	}
+
+	/**
+	* @brief Returns @c true if observers of subjects are locked, @c false
+	*        otherwise.
+	*/
+	static bool isEnabled() {
+		return enabled;
+	}
+
+	/**
+	* @brief Locks observers of @a subject (if locking is enabled).
+	*/
+	static std::unique_lock<std::mutex> lock(const void *subject) {
+		if (!enabled) {
+			return std::unique_lock<std::mutex>();
+		}
+		auto i = (reinterpret_cast<std::uintptr_t>(subject) >> 4) % NUM_OF_LOCKS;
+		return std::unique_lock<std::mutex>(locks[i]);
+	}
+
+private:
+	/// Number of mutexes shared by all subjects.
+	static constexpr std::size_t NUM_OF_LOCKS = 64;
+
+	/// Is locking enabled?
+	inline static std::atomic<bool> enabled{false};
+
+	/// Mutexes shared by all subjects.
+	inline static std::mutex locks[NUM_OF_LOCKS];
+};
+
 /**
 * @brief Implementation of a generic typed observer using shared pointers
 *        (subject part).
@@ -89,6 +145,8 @@ public:
 	* @param[in] observer Observer to be added.
 	*/
 	void addObserver(ObserverPtr observer) {
+		ModificationRecorder::recordModification();
+		auto lock = SubjectLocks::lock(this);
 		observers.push_back(observer);
 	}
 
@@ -105,6 +163,8 @@ public:
 	* @brief Removes all observers.
 	*/
 	void removeObservers() {
+		ModificationRecorder::recordModification();
+		auto lock = SubjectLocks::lock(this);
 		observers.clear();
 	}
 
@@ -123,9 +183,11 @@ public:
 	* @see addObserver(), Observer::update(), getSelf()
 	*/
 	void notifyObservers(ShPtr<ArgType> arg = nullptr) {
+		ModificationRecorder::recordModification();
+
 		// We have to iterate over a copy of the container because it can be
 		// modified during the iteration (either by us or in an update() call).
-		for (const auto &observer : ObserverContainer(observers)) {
+		for (const auto &observer : getObserversCopy()) {
 			notifyObserverOrRemoveItIfNotExists(observer, arg);
 		}
 	}
@@ -156,6 +218,14 @@ protected:
 
 private:
 
+	/**
+	* @brief Returns a copy of the container of observers.
+	*/
+	ObserverContainer getObserversCopy() {
+		auto lock = SubjectLocks::lock(this);
+		return observers;
+	}
+
 	/**
 	* @brief Notifies the given observer (if it exists) or removes it (if it
 	*        does not exist).
@@ -189,11 +259,17 @@ private:
 	* @brief Removes the given observer and all the non-existing observers.
 	*/
 	void removeObserverAndNonExistingObservers(ObserverPtr observer) {
+		ModificationRecorder::recordModification();
+		auto lock = SubjectLocks::lock(this);
+		// Observers are compared by their owners, which is equivalent to
+		// comparing the locked pointers for existing observers but does not
+		// touch reference counts.
 		observers.erase(std::remove_if(observers.begin(), observers.end(),
 			[&observer](const auto &other) {
-				return other.expired() || observer.lock() == other.lock();
+				return other.expired() || (!observer.owner_before(other) &&
+					!other.owner_before(observer));
 			}
-		));
+		), observers.end());
 	}
 
 private:
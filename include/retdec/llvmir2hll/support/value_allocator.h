@@ -0,0 +1,55 @@
+/**
+* @file include/retdec/llvmir2hll/support/value_allocator.h
+* @brief A pooled allocator of values.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_LLVMIR2HLL_SUPPORT_VALUE_ALLOCATOR_H
+#define RETDEC_LLVMIR2HLL_SUPPORT_VALUE_ALLOCATOR_H
+
+#include <cstddef>
+
+namespace retdec {
+namespace llvmir2hll {
+
+/**
+* @brief A pooled allocator of values (expressions, statements, variables,
+*        types, etc.).
+*
+* Values are small, numerous, and short-lived (optimizations create and throw
+* away a lot of them), so they are not allocated one by one from the heap.
+* Instead, they are carved from large chunks and, when freed, they are put
+* into free lists of blocks of the same size, from which they are reused.
+*
+* Every thread has its own free lists, so no locking is needed for allocation
+* and deallocation. A block may be freed by a different thread than the one
+* that allocated it; it is then reused by the freeing thread. When a thread
+* exits, its free blocks are handed over to the other threads.
+*
+* Chunks are returned to the system only by trim(), which is called after
+* a module has been decompiled, so that the memory used by values does not
+* stay at the peak of the largest module decompiled by the process.
+*
+* Blocks larger than @c MAX_POOLED_SIZE are allocated from the heap.
+*/
+class ValueAllocator {
+public:
+	static void *allocate(std::size_t size);
+	static void deallocate(void *ptr, std::size_t size) noexcept;
+
+	static std::size_t trim();
+
+	static std::size_t getNumOfAllocatedChunks();
+
+public:
+	/// Maximal size of a block allocated from the pool.
+	static constexpr std::size_t MAX_POOLED_SIZE = 512;
+
+	/// Size of a chunk the blocks are carved from.
+	static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+};
+
+} // namespace llvmir2hll
+} // namespace retdec
+
+#endif
@@ -7,12 +7,15 @@
 #ifndef RETDEC_LOADER_RETDEC_LOADER_IMAGE_H
 #define RETDEC_LOADER_RETDEC_LOADER_IMAGE_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include "retdec/utils/byte_value_storage.h"
 #include "retdec/fileformat/fftypes.h"
 #include "retdec/fileformat/file_format/file_format.h"
 #include "retdec/loader/loader/segment.h"
+#include "retdec/loader/loader/segment_index.h"
 #include "retdec/loader/utils/name_generator.h"
 
 namespace retdec {
@@ -80,6 +83,7 @@ protected:
 	void removeSegment(Segment* segment);
 	void nameSegment(Segment* segment);
 	void sortSegments();
+	void invalidateSegmentIndex();
 
 	void setStatusMessage(const std::string& message);
 
@@ -94,6 +98,11 @@ private:
 	std::uint64_t _baseAddress;
 	NameGenerator _namelessSegNameGen;
 	std::string _statusMessage;
+
+	// Built lazily on the first lookup after segments have changed.
+	mutable SegmentIndex _segmentIndex;
+	mutable std::atomic<bool> _segmentIndexValid;
+	mutable std::mutex _segmentIndexMutex;
 };
 
 } // namespace loader
@@ -0,0 +1,51 @@
+/**
+ * @file include/retdec/loader/loader/segment_index.h
+ * @brief Declaration of index for address lookup of segments.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_LOADER_RETDEC_LOADER_SEGMENT_INDEX_H
+#define RETDEC_LOADER_RETDEC_LOADER_SEGMENT_INDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "retdec/loader/loader/segment.h"
+
+namespace retdec {
+namespace loader {
+
+/**
+ * This class represents the index of segments ordered by their addresses, which allows
+ * to find the segment containing an address in logarithmic time. Address space covered
+ * by segments is split into disjoint intervals and every interval is assigned the first
+ * segment (in the order of the indexed vector) which contains it. Lookups therefore return
+ * the same segment as the linear search over the vector, even if segments overlap.
+ *
+ * The index does not observe the segments. It needs to be rebuilt whenever segments are
+ * added, removed, reordered or their address ranges change.
+ */
+class SegmentIndex
+{
+public:
+	void build(const std::vector<std::unique_ptr<Segment>>& segments);
+	void clear();
+
+	const Segment* find(std::uint64_t address) const;
+
+private:
+	struct Interval
+	{
+		std::uint64_t start;
+		std::uint64_t end;
+		const Segment* segment;
+	};
+
+	std::vector<Interval> _intervals;
+};
+
+} // namespace loader
+} // namespace retdec
+
+#endif
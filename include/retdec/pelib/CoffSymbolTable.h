@@ -32,7 +32,7 @@ namespace PeLib
 			LoaderError loaderError() const;
 			void setLoaderError(LoaderError ldrError);
 
-			int read(ByteBuffer & fileData, std::size_t uiOffset, std::size_t uiSize);
+			int read(const ByteView & fileData, std::size_t uiOffset, std::size_t uiSize);
 			std::size_t getSizeOfStringTable() const;
 			std::size_t getNumberOfStoredSymbols() const;
 			std::uint32_t getSymbolIndex(std::size_t ulSymbol) const;
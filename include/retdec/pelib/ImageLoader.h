@@ -147,7 +147,7 @@ class ImageLoader
 
 	ImageLoader(std::uint32_t loaderFlags = 0);
 
-	int Load(ByteBuffer & fileData, std::uint32_t loadFlags = 0);
+	int Load(const ByteView & fileData, std::uint32_t loadFlags = 0);
 	int Load(std::istream & fs, std::streamoff fileOffset = 0, std::uint32_t loadFlags = 0);
 	int Load(const char * fileName, std::uint32_t loadFlags = 0);
 
@@ -161,7 +161,7 @@ class ImageLoader
 
 	std::uint32_t readString(std::string & str, std::uint32_t rva, std::uint32_t maxLength = 65535);
 	std::uint32_t readStringRc(std::string & str, std::uint32_t rva);
-	std::uint32_t readStringRaw(ByteBuffer & fileData,
+	std::uint32_t readStringRaw(const ByteView & fileData,
 		                        std::string & str,
 		                        std::size_t offset,
 		                        std::size_t maxLength = 65535,
@@ -399,28 +399,28 @@ class ImageLoader
 	bool processImageRelocations(std::uint64_t oldImageBase, std::uint64_t getImageBase, std::uint32_t VirtualAddress, std::uint32_t Size);
 	void writeNewImageBase(std::uint64_t newImageBase);
 
-	int captureDosHeader(ByteBuffer & fileData);
+	int captureDosHeader(const ByteView & fileData);
 	int saveToFile(std::ostream & fs, std::streamoff fileOffset, std::size_t rva, std::size_t length);
 	int saveDosHeaderNew(std::ostream & fs, std::streamoff fileOffset);
 	int saveDosHeader(std::ostream & fs, std::streamoff fileOffset);
-	int captureNtHeaders(ByteBuffer & fileData);
+	int captureNtHeaders(const ByteView & fileData);
 	int saveNtHeadersNew(std::ostream & fs, std::streamoff fileOffset);
 	int saveNtHeaders(std::ostream & fs, std::streamoff fileOffset);
-	int captureSectionName(ByteBuffer & fileData, std::string & sectionName, const std::uint8_t * name);
-	int captureSectionHeaders(ByteBuffer & fileData);
+	int captureSectionName(const ByteView & fileData, std::string & sectionName, const std::uint8_t * name);
+	int captureSectionHeaders(const ByteView & fileData);
 	int saveSectionHeadersNew(std::ostream & fs, std::streamoff fileOffset);
 	int saveSectionHeaders(std::ostream & fs, std::streamoff fileOffset);
-	int captureImageSections(ByteBuffer & fileData, std::uint32_t loadFlags);
-	int captureOptionalHeader32(std::uint8_t * fileData, std::uint8_t * filePtr, std::uint8_t * fileEnd);
-	int captureOptionalHeader64(std::uint8_t * fileData, std::uint8_t * filePtr, std::uint8_t * fileEnd);
-	std::uint32_t copyDataDirectories(std::uint8_t * optionalHeaderPtr, std::uint8_t * dataDirectoriesPtr, std::size_t optionalHeaderMax, std::uint32_t numberOfRvaAndSizes);
+	int captureImageSections(const ByteView & fileData, std::uint32_t loadFlags);
+	int captureOptionalHeader32(const std::uint8_t * fileData, const std::uint8_t * filePtr, const std::uint8_t * fileEnd);
+	int captureOptionalHeader64(const std::uint8_t * fileData, const std::uint8_t * filePtr, const std::uint8_t * fileEnd);
+	std::uint32_t copyDataDirectories(const std::uint8_t * optionalHeaderPtr, const std::uint8_t * dataDirectoriesPtr, std::size_t optionalHeaderMax, std::uint32_t numberOfRvaAndSizes);
 
 	int verifyDosHeader(PELIB_IMAGE_DOS_HEADER & hdr, std::size_t fileSize);
 	int verifyDosHeader(std::istream & fs, std::streamoff fileOffset, std::size_t fileSize);
 
-	int loadImageAsIs(ByteBuffer & fileData);
+	int loadImageAsIs(const ByteView & fileData);
 
-	std::uint32_t captureImageSection(ByteBuffer & fileData,
+	std::uint32_t captureImageSection(const ByteView & fileData,
 									  std::uint32_t virtualAddress,
 									  std::uint32_t virtualSize,
 									  std::uint32_t pointerToRawData,
@@ -439,7 +439,7 @@ class ImageLoader
 	bool checkForInvalidImageRange();
 	bool isValidMachineForCodeIntegrifyCheck(std::uint32_t Bits);
 	bool checkForSectionTablesWithinHeader(std::uint32_t e_lfanew);
-	bool checkForBadCodeIntegrityImages(ByteBuffer & fileData);
+	bool checkForBadCodeIntegrityImages(const ByteView & fileData);
 	bool checkForBadArchitectureSpecific();
 	bool checkForImageAfterMapping();
 
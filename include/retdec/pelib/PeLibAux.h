@@ -133,6 +133,25 @@ namespace PeLib
 
 	typedef std::vector<std::uint8_t> ByteBuffer;
 
+	// Read-only view of data owned by someone else (e.g. a memory-mapped input file).
+	// The viewed data must outlive the view.
+	class ByteView
+	{
+		public:
+		ByteView() = default;
+		ByteView(const std::uint8_t * data, std::size_t size) : m_data(data), m_size(size) {}
+		ByteView(const ByteBuffer & buffer) : m_data(buffer.data()), m_size(buffer.size()) {}
+
+		const std::uint8_t * data() const  { return m_data; }
+		std::size_t size() const           { return m_size; }
+		const std::uint8_t * begin() const { return m_data; }
+		const std::uint8_t * end() const   { return m_data + m_size; }
+
+		private:
+		const std::uint8_t * m_data = nullptr;
+		std::size_t m_size = 0;
+	};
+
 	enum
 	{
 		PEFILE32 = 32,
@@ -11,6 +11,7 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
+#include "retdec/bin2llvmir/providers/provider_context.h"
 #include "retdec/common/basic_block.h"
 #include "retdec/common/function.h"
 #include "retdec/config/config.h"
@@ -22,12 +23,15 @@ struct LlvmModuleContextPair
 	LlvmModuleContextPair(LlvmModuleContextPair&&) = default;
 	~LlvmModuleContextPair()
 	{
-		// Order matters: module destructor uses context.
+		// Order matters: providers reference module, module destructor uses
+		// context.
+		providers.reset();
 		module.reset();
 		context.reset();
 	}
 	std::unique_ptr<llvm::Module> module;
 	std::unique_ptr<llvm::LLVMContext> context;
+	std::unique_ptr<bin2llvmir::ProviderContext> providers;
 };
 
 /**
@@ -45,6 +49,11 @@ LlvmModuleContextPair disassemble(
  * Run a decompilation according to a \p config configuration.
  * If \p outString is set, decompilation output will be returned
  * in this string. Otherwise, output file is expected to be set in \p config.
+ *
+ * Decompilations with different configs can run in parallel threads.
+ * Every decompilation logs into the outputs given by its config, unless
+ * the calling thread has already activated its own loggers
+ * (utils::io::Log::ContextScope).
  */
 bool decompile(
 		retdec::config::Config& config,
@@ -0,0 +1,59 @@
+/**
+* @file include/retdec/utils/file_cache.h
+* @brief Persistent on-disk cache of entries identified by keys.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_FILE_CACHE_H
+#define RETDEC_UTILS_FILE_CACHE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Persistent on-disk cache of entries identified by keys.
+*
+* Every entry is stored in its own file in the cache directory, so the cache
+* is kept across runs. Keys are supposed to be hashes of everything the
+* content of the entry depends on (content addressing), so entries are never
+* invalidated, only evicted: when the total size of the entries exceeds the
+* maximal size, the least recently used ones are removed by @c evict().
+*
+* Several processes may share the same cache directory. Entries are written
+* into temporary files that are then renamed, so a reader never sees a
+* partially written entry.
+*/
+class FileCache {
+public:
+	FileCache(const std::string& dir, std::uint64_t maxSize);
+
+	const std::string& getDir() const;
+	std::uint64_t getMaxSize() const;
+	bool isUsable() const;
+
+	std::optional<std::string> get(const std::string& key) const;
+	bool put(const std::string& key, const std::string& content);
+	void evict();
+
+	static bool isValidKey(const std::string& key);
+
+private:
+	std::string getEntryPath(const std::string& key) const;
+
+private:
+	/// Directory with the entries.
+	std::string _dir;
+	/// Maximal total size of the entries (in bytes).
+	std::uint64_t _maxSize = 0;
+	/// Does the directory exist (or could it be created)?
+	bool _usable = false;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
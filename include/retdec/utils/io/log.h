@@ -29,6 +29,39 @@ public:
 	using Color = Logger::Color;
 	using Action = Logger::Action;
 
+	/**
+	 * Loggers of one run (e.g. one decompilation).
+	 *
+	 * Threads that activate the context by ContextScope use its loggers
+	 * instead of the process-wide ones set by Log::set(). This way, runs
+	 * in parallel threads can log into different outputs. Types without
+	 * a logger in the context fall back to the process-wide loggers.
+	 */
+	class Context {
+	public:
+		void set(const Type& logType, Logger::Ptr&& logger);
+		Logger* get(const Type& logType) const;
+
+	private:
+		Logger::Ptr writers[static_cast<int>(Type::Undefined)+1];
+	};
+
+	/**
+	 * Activates the given context in the calling thread for the lifetime
+	 * of the scope. The previously active context is restored afterwards.
+	 */
+	class ContextScope {
+	public:
+		ContextScope(Context* context);
+		~ContextScope();
+
+		ContextScope(const ContextScope&) = delete;
+		ContextScope& operator=(const ContextScope&) = delete;
+
+	private:
+		Context* previous = nullptr;
+	};
+
 public:
 	/**
 	 * Returns corresponding initialized logger for logType provided
@@ -50,6 +83,12 @@ public:
 	 */
 	static void set(const Type& logType, Logger::Ptr&& logger);
 
+	/**
+	 * Returns context activated in the calling thread, or nullptr if there
+	 * is no such context.
+	 */
+	static Context* getContext();
+
 	/**
 	 * Shortcut for Logger(Log::get(Log::Type::Info)).
 	 *
@@ -132,6 +171,11 @@ private:
 	 * this logger is used as fallback to log (calling set with nullptr).
 	 */
 	static Logger defaultLogger;
+
+	/**
+	 * Context activated in the calling thread.
+	 */
+	static thread_local Context* activeContext;
 };
 
 }
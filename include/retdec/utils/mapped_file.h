@@ -0,0 +1,62 @@
+/**
+* @file include/retdec/utils/mapped_file.h
+* @brief Read-only memory-mapped file.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_MAPPED_FILE_H
+#define RETDEC_UTILS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "retdec/utils/non_copyable.h"
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Read-only view of the whole content of a file.
+*
+* The file is mapped into memory, so its content is not copied and pages are
+* read from the disk only when they are accessed. If the file cannot be
+* mapped (e.g. it is not a regular file), its content is read into an owned
+* buffer instead. Either way, the content stays valid and unchanged for the
+* whole lifetime of the object.
+*
+* Objects are usually shared via @c std::shared_ptr, so that several
+* consumers of the same input (file format parser, YARA scanners, ...) can
+* borrow the content without copying it.
+*/
+class MappedFile: private NonCopyable {
+public:
+	static std::shared_ptr<const MappedFile> open(const std::string& path);
+	~MappedFile();
+
+	const std::uint8_t* data() const;
+	std::size_t size() const;
+	bool empty() const;
+	bool isMapped() const;
+
+private:
+	MappedFile() = default;
+
+	bool map(const std::string& path);
+	bool read(const std::string& path);
+
+private:
+	const std::uint8_t* _data = nullptr;
+	std::size_t _size = 0;
+	/// Mapped region, @c nullptr if the content is in @c _buffer.
+	void* _mapping = nullptr;
+	/// Content of files that could not be mapped.
+	std::vector<std::uint8_t> _buffer;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
@@ -0,0 +1,28 @@
+/**
+* @file include/retdec/utils/parallel.h
+* @brief Utilities for running independent work items in parallel.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_PARALLEL_H
+#define RETDEC_UTILS_PARALLEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace retdec {
+namespace utils {
+
+unsigned getHardwareConcurrency();
+unsigned getNumberOfJobs(std::uint64_t requested);
+
+void parallelFor(
+		std::size_t count,
+		unsigned jobs,
+		const std::function<void(std::size_t)>& work);
+
+} // namespace utils
+} // namespace retdec
+
+#endif
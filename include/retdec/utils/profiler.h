@@ -0,0 +1,94 @@
+/**
+* @file include/retdec/utils/profiler.h
+* @brief Per-phase timing and memory profile of the decompilation.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_PROFILER_H
+#define RETDEC_UTILS_PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "retdec/utils/non_copyable.h"
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Process-wide profile of the decompilation phases.
+*
+* Phases are measured by @c Profiler::Scope objects. When the profiler is
+* disabled (the default), scopes do nothing, so they can be left in the code.
+* Phases are recorded in the order in which they were started. Nested phases
+* have greater levels than their parents.
+*
+* All the methods are thread-safe.
+*/
+class Profiler {
+public:
+	/**
+	* @brief Measured phase.
+	*/
+	struct Phase {
+		std::string name;
+		/// Nesting level of the phase, @c 0 for top-level phases.
+		std::size_t level = 0;
+		/// Wall-clock time (in seconds).
+		double wallTime = 0.0;
+		/// CPU time of the whole process (in seconds).
+		double cpuTime = 0.0;
+		/// Growth of the peak resident set size of the process (in bytes).
+		std::size_t peakRssDelta = 0;
+		/// Number of functions after the phase (if known).
+		std::optional<std::uint64_t> functions;
+		/// Number of instructions/statements after the phase (if known).
+		std::optional<std::uint64_t> instructions;
+	};
+
+	/**
+	* @brief Measures the phase from its construction until @c stop() or its
+	*        destruction.
+	*/
+	class Scope: private NonCopyable {
+	public:
+		explicit Scope(const std::string& name);
+		~Scope();
+
+		bool isActive() const;
+		void stop();
+		void setCounts(std::uint64_t functions, std::uint64_t instructions);
+
+	private:
+		/// Index of the phase in the profile, if the profiler is enabled.
+		std::optional<std::size_t> index;
+		bool stopped = false;
+		std::chrono::steady_clock::time_point wallStart;
+		double cpuStart = 0.0;
+		std::size_t peakRssStart = 0;
+	};
+
+public:
+	static void enable();
+	static void disable();
+	static bool isEnabled();
+
+	static std::vector<Phase> getPhases();
+	static void clear();
+
+	static void writeJson(std::ostream& out);
+	static bool writeJson(const std::string& path);
+
+private:
+	Profiler() = default;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
@@ -7,6 +7,9 @@
 #ifndef RETDEC_YARACPP_YARA_DETECTOR_H
 #define RETDEC_YARACPP_YARA_DETECTOR_H
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -70,22 +73,20 @@ class YaraDetector
 		};
 
 	private:
-		/// compiler or text rules
+		/// compiler of rules added as strings
 		YR_COMPILER *compiler = nullptr;
-		/// representation of files with rules
-		std::vector<FILE*> files;
 		/// representation of detected rules
 		std::vector<YaraRule> detectedRules;
 		/// representation of undetected rules
 		std::vector<YaraRule> undetectedRules;
-		/// rules from input text files
-		YR_RULES* textFilesRules = nullptr;
-		/// rules from precompiled files
-		std::vector<YR_RULES*> precompiledRules;
+		/// rules from input strings
+		YR_RULES* stringRules = nullptr;
+		/// rules from rule files shared through YaraRuleCache
+		std::vector<std::shared_ptr<YR_RULES>> fileRules;
 		/// internal state of instance
 		bool stateIsValid = true;
-		/// indicates whether text files need recompilation
-		bool needsRecompilation = true;
+		/// indicates whether string rules need recompilation
+		bool needsRecompilation = false;
 
 		/// @name Static auxiliary methods
 		/// @{
@@ -129,6 +130,11 @@ class YaraDetector
 				std::vector<std::uint8_t> &bytes,
 				bool storeAllRules = false
 		);
+		bool analyze(
+				const std::uint8_t *data,
+				std::size_t size,
+				bool storeAllRules = false
+		);
 		const std::vector<YaraRule>& getDetectedRules() const;
 		const std::vector<YaraRule>& getUndetectedRules() const;
 		/// @}
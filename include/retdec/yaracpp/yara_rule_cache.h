@@ -0,0 +1,90 @@
+/**
+ * @file include/retdec/yaracpp/yara_rule_cache.h
+ * @brief Process-wide cache of compiled YARA rules.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_YARACPP_YARA_RULE_CACHE_H
+#define RETDEC_YARACPP_YARA_RULE_CACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "retdec/utils/filesystem.h"
+
+typedef struct YR_RULES YR_RULES;
+
+namespace retdec {
+namespace yaracpp {
+
+/**
+ * Process-wide cache of compiled YARA rules
+ *
+ * Every rule file is loaded (if precompiled) or compiled (if text) only once
+ * and the resulting rules are shared by all detectors that use the file.
+ * A file is reloaded when its modification time changes. Rules may be
+ * scanned by several threads at once, and the cache itself is thread-safe.
+ */
+class YaraRuleCache
+{
+	public:
+		static YaraRuleCache& getInstance();
+
+		YaraRuleCache(const YaraRuleCache&) = delete;
+		YaraRuleCache& operator=(const YaraRuleCache&) = delete;
+
+		/// @name Other methods
+		/// @{
+		std::shared_ptr<YR_RULES> getRules(
+				const std::string &pathToFile,
+				const std::string &nameSpace = std::string()
+		);
+		void setPersistCompiledRules(bool persist);
+		bool getPersistCompiledRules() const;
+		void clear();
+		/// @}
+
+		static std::string getCompiledRulesPath(
+				const std::string &pathToFile,
+				const std::string &nameSpace = std::string()
+		);
+
+	private:
+		/**
+		 * Rules loaded from one rule file
+		 */
+		struct Entry
+		{
+			/// modification time of the rule file when it was loaded
+			fs::file_time_type modificationTime;
+			/// loaded rules
+			std::shared_ptr<YR_RULES> rules;
+		};
+
+		YaraRuleCache();
+		~YaraRuleCache();
+
+		static std::shared_ptr<YR_RULES> loadRules(
+				const std::string &pathToFile,
+				const std::string &nameSpace,
+				fs::file_time_type modificationTime,
+				bool persist
+		);
+
+		/// @c true if libyara was successfully initialized
+		bool initialized = false;
+		/// store compiled text rules next to their source files
+		bool persistCompiledRules = false;
+		/// loaded rules indexed by path to rule file and namespace
+		std::map<std::pair<std::string, std::string>, Entry> entries;
+		/// guards all data members
+		mutable std::mutex mutex;
+};
+
+} // namespace yaracpp
+} // namespace retdec
+
+#endif
@@ -72,9 +72,17 @@ bool ReachingDefinitionsAnalysis::runOnFunction(
 void ReachingDefinitionsAnalysis::run()
 {
 	initializeBasicBlocksPrev();
-	initializeKillGenSets();
-	propagate();
-	initializeDefsAndUses();
+
+	for (auto& pair1 : bbMap)
+	{
+		std::vector<Definition*> defs;
+		DefIndexMap srcDefs;
+
+		initializeDefIndexes(pair1.second, defs, srcDefs);
+		initializeKillGenSets(pair1.second, srcDefs, defs.size());
+		propagate(pair1.first, pair1.second);
+		initializeDefsAndUses(pair1.second, defs, srcDefs);
+	}
 
 	LOG << *this << "\n";
 
@@ -225,9 +233,9 @@ void ReachingDefinitionsAnalysis::clearInternal()
 	for (auto& pair : pair1.second)
 	{
 		BasicBlockEntry& bb = pair.second;
-		bb.defsOut.clear();
-		bb.genDefs.clear();
-		bb.killDefs.clear();
+		bb.defsOut = BitVector();
+		bb.genDefs = BitVector();
+		bb.killDefs = BitVector();
 	}
 }
 
@@ -251,54 +259,80 @@ void ReachingDefinitionsAnalysis::initializeBasicBlocksPrev()
 	}
 }
 
-void ReachingDefinitionsAnalysis::initializeKillGenSets()
+/**
+ * Number all the definitions in the function whose basic blocks are @a bbs.
+ * Definition with index @c i is stored in @a defs at position @c i, indexes of
+ * definitions of a value are stored in @a srcDefs.
+ */
+void ReachingDefinitionsAnalysis::initializeDefIndexes(
+		BBEntryMap& bbs,
+		std::vector<Definition*>& defs,
+		DefIndexMap& srcDefs)
 {
-	for (auto &pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	for (auto& pair : bbs)
 	{
-		pair.second.initializeKillDefSets();
+		BasicBlockEntry& bb = pair.second;
+
+		bb.firstDefIdx = defs.size();
+		for (Definition& d : bb.defs)
+		{
+			srcDefs[d.getSource()].push_back(defs.size());
+			defs.push_back(&d);
+		}
 	}
 }
 
-void ReachingDefinitionsAnalysis::propagate()
+void ReachingDefinitionsAnalysis::initializeKillGenSets(
+		BBEntryMap& bbs,
+		const DefIndexMap& srcDefs,
+		unsigned numDefs)
 {
-	for (auto &pair1 : bbMap)
+	for (auto& pair : bbs)
 	{
-		const Function* fnc = pair1.first;
+		pair.second.initializeKillDefSets(srcDefs, numDefs);
+	}
+}
 
-		std::vector<BasicBlockEntry*> workList;
-		workList.reserve(pair1.second.size());
-		ReversePostOrderTraversal<const Function*> RPOT(fnc); // Expensive to create
-		for (auto I = RPOT.begin(); I != RPOT.end(); ++I)
-		{
-			const BasicBlock* bb = *I;
-			auto fIt = pair1.second.find(bb);
-			assert(fIt != pair1.second.end());
-			workList.push_back(&(fIt->second));
+void ReachingDefinitionsAnalysis::propagate(
+		const Function* F,
+		BBEntryMap& bbs)
+{
+	std::vector<BasicBlockEntry*> workList;
+	workList.reserve(bbs.size());
+	ReversePostOrderTraversal<const Function*> RPOT(F); // Expensive to create
+	for (auto I = RPOT.begin(); I != RPOT.end(); ++I)
+	{
+		const BasicBlock* bb = *I;
+		auto fIt = bbs.find(bb);
+		assert(fIt != bbs.end());
+		workList.push_back(&(fIt->second));
+	}
 
-			fIt->second.changed = true;
-		}
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
 
-		bool changed = true;
-		while (changed)
+		for (auto* bbe : workList)
 		{
-			changed = false;
-
-			for (auto* bbe : workList)
-			{
-				changed |= bbe->initDefsOut();
-			}
+			changed |= bbe->initDefsOut();
 		}
 	}
 }
 
-void ReachingDefinitionsAnalysis::initializeDefsAndUses()
+void ReachingDefinitionsAnalysis::initializeDefsAndUses(
+		BBEntryMap& bbs,
+		const std::vector<Definition*>& defs,
+		const DefIndexMap& srcDefs)
 {
-	for (auto &pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	for (auto& pair : bbs)
 	{
 		BasicBlockEntry &bb = pair.second;
 
+		// Computed only if there is a use not defined in this BB.
+		BitVector defsIn;
+		bool defsInInitialized = false;
+
 		for (Use &u : bb.uses)
 		{
 			for (auto dIt = bb.defs.rbegin(); dIt != bb.defs.rend(); ++dIt)
@@ -320,13 +354,24 @@ void ReachingDefinitionsAnalysis::initializeDefsAndUses()
 
 			if (u.defs.empty())
 			{
-				for (auto p : bb.prevBBs)
-				for (auto d : p->defsOut)
+				auto sIt = srcDefs.find(u.src);
+				if (sIt == srcDefs.end())
 				{
-					if (d->getSource() == u.src)
+					continue;
+				}
+
+				if (!defsInInitialized)
+				{
+					defsIn = bb.getDefsIn();
+					defsInInitialized = true;
+				}
+
+				for (unsigned i : sIt->second)
+				{
+					if (defsIn.test(i))
 					{
-						d->uses.insert(&u);
-						u.defs.insert(d);
+						defs[i]->uses.insert(&u);
+						u.defs.insert(defs[i]);
 					}
 				}
 			}
@@ -391,52 +436,66 @@ BasicBlockEntry::BasicBlockEntry(const llvm::BasicBlock* b, std::size_t _id) :
 
 }
 
-void BasicBlockEntry::initializeKillDefSets()
+void BasicBlockEntry::initializeKillDefSets(
+		const DefIndexMap& srcDefs,
+		unsigned numDefs)
 {
+	defsOut.clear();
+	defsOut.resize(numDefs);
 	killDefs.clear();
+	killDefs.resize(numDefs);
 	genDefs.clear();
+	genDefs.resize(numDefs);
 
 	for (auto dIt = defs.rbegin(); dIt != defs.rend(); ++dIt)
 	{
 		Definition& d = *dIt;
 
-		bool added = (killDefs.insert(d.getSource())).second;
-		if (added)
+		auto sIt = srcDefs.find(d.getSource());
+		assert(sIt != srcDefs.end() && "we should have all defs indexed");
+		if (killDefs.test(sIt->second.front()))
 		{
-			genDefs.insert(&d);
+			// Killed by a later definition in this BB.
+			continue;
 		}
+
+		for (unsigned i : sIt->second)
+		{
+			killDefs.set(i);
+		}
+		genDefs.set(firstDefIdx + (defs.rend() - dIt - 1));
 	}
 }
 
 /**
  * REACH_in[B] = Sum (p in pred[B]) (REACH_out[p])
- * REACH_out[B] = GEN[B] + ( REACH_in[B] - KILL[B] )
  */
-Changed BasicBlockEntry::initDefsOut()
+llvm::BitVector BasicBlockEntry::getDefsIn() const
 {
-	auto oldSz = defsOut.size();
-
-	if (defsOut.empty() && !genDefs.empty())
+	BitVector defsIn(defsOut.size());
+	for (auto* p : prevBBs)
 	{
-		defsOut = std::move(genDefs);
+		defsIn |= p->defsOut;
 	}
+	return defsIn;
+}
 
-	for (auto* p : prevBBs)
+/**
+ * REACH_out[B] = GEN[B] + ( REACH_in[B] - KILL[B] )
+ */
+Changed BasicBlockEntry::initDefsOut()
+{
+	BitVector newDefsOut = getDefsIn();
+	newDefsOut.reset(killDefs);
+	newDefsOut |= genDefs;
+
+	if (newDefsOut == defsOut)
 	{
-		if (p->changed)
-		{
-			for (auto* d : p->defsOut)
-			{
-				if (killDefs.find(d->getSource()) == killDefs.end())
-				{
-					defsOut.insert(d);
-				}
-			}
-		}
+		return false;
 	}
 
-	changed = oldSz != defsOut.size();
-	return changed;
+	defsOut = std::move(newDefsOut);
+	return true;
 }
 
 std::string BasicBlockEntry::getName() const
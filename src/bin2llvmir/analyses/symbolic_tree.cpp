@@ -4,8 +4,10 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <map>
 #include <ostream>
 #include <sstream>
+#include <tuple>
 
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/LLVMContext.h>
@@ -27,11 +29,60 @@ using namespace retdec::bin2llvmir::st_match;
 namespace retdec {
 namespace bin2llvmir {
 
+namespace {
+
+/**
+ * Already expanded load nodes of the tree that is being constructed, indexed
+ * by (load, user, level).
+ *
+ * Expansion of a load queries RDA (or searches the CFG when RDA is computed on
+ * demand), which is the most expensive part of the construction. The same
+ * load is often reached through several paths in a single tree (e.g. the same
+ * register loaded by both operands of an instruction), so its expansion is
+ * done only once and copied afterwards.
+ */
+using ExpandedLoads = std::map<
+		std::tuple<llvm::Value*, llvm::Value*, unsigned>,
+		SymbolicTree>;
+
+/**
+ * Expanded loads of the tree that is being constructed by the current thread,
+ * or @c nullptr if no tree is being constructed.
+ */
+thread_local ExpandedLoads* expandedLoads = nullptr;
+
+/**
+ * Makes expanded loads available during the construction of a single tree.
+ *
+ * Expansions are not kept between trees because users of trees are free to
+ * modify the IR between their constructions.
+ */
+class ExpandedLoadsScope
+{
+	public:
+		ExpandedLoadsScope() :
+				_outer(expandedLoads)
+		{
+			expandedLoads = &_loads;
+		}
+		~ExpandedLoadsScope()
+		{
+			expandedLoads = _outer;
+		}
+
+	private:
+		ExpandedLoads _loads;
+		ExpandedLoads* _outer = nullptr;
+};
+
+} // anonymous namespace
+
 SymbolicTree SymbolicTree::PrecomputedRda(
 		ReachingDefinitionsAnalysis& rda,
 		llvm::Value* v,
 		unsigned maxNodeLevel)
 {
+	ExpandedLoadsScope scope;
 	return SymbolicTree(&rda, v, nullptr, 0, maxNodeLevel, nullptr, false);
 }
 
@@ -42,6 +93,7 @@ SymbolicTree SymbolicTree::PrecomputedRdaWithValueMap(
 		unsigned maxNodeLevel)
 {
 	_val2valUsed = false;
+	// Expanded loads are not used because expansions depend on the mapping.
 	return SymbolicTree(&rda, v, nullptr, 0, maxNodeLevel, val2val, false);
 }
 
@@ -49,6 +101,7 @@ SymbolicTree SymbolicTree::OnDemandRda(
 		llvm::Value* v,
 		unsigned maxNodeLevel)
 {
+	ExpandedLoadsScope scope;
 	return SymbolicTree(nullptr, v, nullptr, 0, maxNodeLevel, nullptr, false);
 }
 
@@ -56,6 +109,7 @@ SymbolicTree SymbolicTree::Linear(
 		llvm::Value* v,
 		unsigned maxNodeLevel)
 {
+	ExpandedLoadsScope scope;
 	return SymbolicTree(nullptr, v, nullptr, 0, maxNodeLevel, nullptr, true);
 }
 
@@ -72,8 +126,6 @@ SymbolicTree::SymbolicTree(
 		user(u),
 		_level(nodeLevel)
 {
-	ops.reserve(_naryLimit);
-
 	if (val2val)
 	{
 		auto fIt = val2val->find(value);
@@ -90,7 +142,28 @@ SymbolicTree::SymbolicTree(
 		return;
 	}
 
+	ExpandedLoads* loads = val2val == nullptr && isa<LoadInst>(value)
+			? expandedLoads
+			: nullptr;
+	auto key = std::make_tuple(value, user, getLevel());
+	if (loads)
+	{
+		auto fIt = loads->find(key);
+		if (fIt != loads->end())
+		{
+			value = fIt->second.value;
+			user = fIt->second.user;
+			ops = fIt->second.ops;
+			return;
+		}
+	}
+
 	expandNode(rda, val2val, maxNodeLevel, linear);
+
+	if (loads)
+	{
+		loads->emplace(key, *this);
+	}
 }
 
 unsigned SymbolicTree::getLevel() const
@@ -204,7 +277,7 @@ void SymbolicTree::expandNode(
 		}
 		else if (RDA && RDA->wasRun())
 		{
-			auto defs = RDA->defsFromUse(l);
+			auto& defs = RDA->defsFromUse(l);
 			if (defs.size() > _naryLimit)
 			{
 // TODO!!! replace with invalid tree
@@ -324,6 +397,7 @@ void SymbolicTree::expandNode(
 	}
 	else if (User* U = dyn_cast<User>(value))
 	{
+		ops.reserve(U->getNumOperands());
 		for (unsigned i = 0; i < U->getNumOperands(); ++i)
 		{
 			ops.emplace_back(
@@ -699,14 +773,14 @@ bool SymbolicTree::isNary(unsigned N) const
 //==============================================================================
 //
 
-Abi* SymbolicTree::_abi = nullptr;
-Config* SymbolicTree::_config = nullptr;
-bool SymbolicTree::_val2valUsed = false;
-bool SymbolicTree::_trackThroughAllocaLoads = true;
-bool SymbolicTree::_trackThroughGeneralRegisterLoads = true;
-bool SymbolicTree::_trackOnlyFlagRegisters = false;
-bool SymbolicTree::_simplifyAtCreation = true;
-unsigned SymbolicTree::_naryLimit = 3;
+thread_local Abi* SymbolicTree::_abi = nullptr;
+thread_local Config* SymbolicTree::_config = nullptr;
+thread_local bool SymbolicTree::_val2valUsed = false;
+thread_local bool SymbolicTree::_trackThroughAllocaLoads = true;
+thread_local bool SymbolicTree::_trackThroughGeneralRegisterLoads = true;
+thread_local bool SymbolicTree::_trackOnlyFlagRegisters = false;
+thread_local bool SymbolicTree::_simplifyAtCreation = true;
+thread_local unsigned SymbolicTree::_naryLimit = 3;
 
 void SymbolicTree::clear()
 {
@@ -75,12 +75,8 @@ bool AsmInstructionRemover::run(Module& M)
 
 	// Free Capstone instructions.
 	//
-	auto& insnMap = AsmInstruction::getLlvmToCapstoneInsnMap(&M);
-	for (auto& p : insnMap)
-	{
-		cs_free(p.second, 1);
-	}
-	insnMap.clear();
+	AsmInstruction::getLlvmToCapstoneInsnMap(&M).clear();
+	AsmInstruction::getCapstoneInsnArena(&M).clear();
 
 	// Remove special global variable.
 	//
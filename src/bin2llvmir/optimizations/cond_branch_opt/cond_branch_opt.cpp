@@ -14,6 +14,7 @@
 #include "retdec/bin2llvmir/optimizations/cond_branch_opt/cond_branch_opt.h"
 #define debug_enabled false
 #include "retdec/bin2llvmir/utils/debug.h"
+#include "retdec/bin2llvmir/utils/function_pass_scheduler.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
 #include "retdec/bin2llvmir/utils/symbolic_tree_match.h"
 
@@ -61,22 +62,35 @@ bool CondBranchOpt::run()
 		return false;
 	}
 
-	bool changed = false;
-
-	ReachingDefinitionsAnalysis RDA;
-	RDA.runOnModule(*_module, _abi, true);
+	using RdaPtr = std::unique_ptr<ReachingDefinitionsAnalysis>;
 
 	SymbolicTree::setTrackThroughAllocaLoads(false);
 	SymbolicTree::setTrackOnlyFlagRegisters(true);
 
-	for (Function& f : *_module)
-	for (auto it = inst_begin(&f), eIt = inst_end(&f); it != eIt;)
-	{
-		Instruction& insn = *it;
-		++it;
-
-		changed |= runOnInstruction(RDA, insn);
-	}
+	// RDA of a function only reads the IR, so it is computed in parallel.
+	// Symbolic trees are built and branches transformed serially.
+	FunctionPassScheduler scheduler(_module);
+	bool changed = scheduler.run<RdaPtr>(
+		[this](Function& f)
+		{
+			auto RDA = std::make_unique<ReachingDefinitionsAnalysis>();
+			RDA->runOnFunction(f, _abi, true);
+			return RDA;
+		},
+		[this](Function& f, RdaPtr& RDA)
+		{
+			bool changed = false;
+			for (auto it = inst_begin(&f), eIt = inst_end(&f); it != eIt;)
+			{
+				Instruction& insn = *it;
+				++it;
+
+				changed |= runOnInstruction(*RDA, insn);
+			}
+			RDA.reset();
+			return changed;
+		}
+	);
 
 	SymbolicTree::setToDefaultConfiguration();
 	IrModifier::eraseUnusedInstructionsRecursive(_toRemove);
@@ -23,6 +23,7 @@
 #include "retdec/bin2llvmir/optimizations/constants/constants.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
 const bool debug_enabled = false;
+#include "retdec/bin2llvmir/utils/function_pass_scheduler.h"
 #include "retdec/bin2llvmir/utils/llvm.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
 
@@ -74,10 +75,35 @@ bool ConstantsAnalysis::runOnModuleCustom(
 
 bool ConstantsAnalysis::run()
 {
-	ReachingDefinitionsAnalysis RDA;
-	RDA.runOnModule(*_module, _abi);
+	using RdaPtr = std::unique_ptr<ReachingDefinitionsAnalysis>;
 
-	for (Function& f : *_module)
+	// RDA of a function only reads the IR, so it is computed in parallel.
+	// Global variables are created and used serially.
+	FunctionPassScheduler scheduler(_module);
+	scheduler.run<RdaPtr>(
+		[this](Function& f)
+		{
+			auto RDA = std::make_unique<ReachingDefinitionsAnalysis>();
+			RDA->runOnFunction(f, _abi);
+			return RDA;
+		},
+		[this](Function& f, RdaPtr& RDA)
+		{
+			runOnFunction(f, *RDA);
+			RDA.reset();
+			return false;
+		}
+	);
+
+	IrModifier::eraseUnusedInstructionsRecursive(_toRemove);
+
+	return false;
+}
+
+void ConstantsAnalysis::runOnFunction(
+		llvm::Function& f,
+		ReachingDefinitionsAnalysis& RDA)
+{
 	for (inst_iterator I = inst_begin(&f), E = inst_end(&f); I != E;)
 	{
 		Instruction& i = *I;
@@ -109,10 +135,6 @@ bool ConstantsAnalysis::run()
 			checkForGlobalInInstruction(RDA, load, load->getPointerOperand());
 		}
 	}
-
-	IrModifier::eraseUnusedInstructionsRecursive(_toRemove);
-
-	return false;
 }
 
 void ConstantsAnalysis::checkForGlobalInInstruction(
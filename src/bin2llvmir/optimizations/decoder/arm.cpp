@@ -115,7 +115,7 @@ std::size_t Decoder::decodeJumpTargetDryRun_arm(
 	uint64_t addr = jt.getAddress();
 	std::size_t nops = 0;
 	bool first = true;
-	while (cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, _dryCsInsn))
+	while (disasm(ce, bytes, addr, _dryCsInsn))
 	{
 		decodedSz += _dryCsInsn->size;
 
@@ -163,6 +163,7 @@ void Decoder::addBasicBlock(common::Address a, llvm::BasicBlock* b)
 {
 	_addr2bb[a] = b;
 	_bb2addr[b] = a;
+	AsmInstruction::setTrueBasicBlockAddress(b, a);
 }
 
 } // namespace bin2llvmir
@@ -112,7 +112,9 @@ bool Decoder::run()
 	LOG << _ranges << std::endl;
 	LOG << _jumpTargets << std::endl;
 
+	predecode();
 	decode();
+	releasePredecodedChunks(0);
 
 	if (debug_enabled && fs::exists(_config->getOutputDirectory()))
 	{
@@ -156,6 +158,14 @@ void Decoder::decode()
 	{
 		throw std::runtime_error("No instructions were decoded");
 	}
+
+	for (auto& p : _selectionDependencies)
+	{
+		if (auto* f = getFunctionAtAddress(p.first))
+		{
+			_config->addSelectionDependency(f);
+		}
+	}
 }
 
 bool Decoder::getJumpTarget(JumpTarget& jt)
@@ -169,6 +179,7 @@ bool Decoder::getJumpTarget(JumpTarget& jt)
 	else if (!_ranges.primaryEmpty())
 	{
 		jt = JumpTarget(
+				_config,
 				_ranges.primaryFront().getStart(),
 				JumpTarget::eType::LEFTOVER,
 				_c2l->getBasicMode(),
@@ -200,6 +211,12 @@ void Decoder::decodeJumpTarget(const JumpTarget& jt)
 		range = _ranges.getAlternative(start);
 		alternative = true;
 	}
+	std::optional<AddressRange> dependencyRange;
+	if (range == nullptr
+			&& (dependencyRange = getSelectionDependencyRange(jt)))
+	{
+		range = &dependencyRange.value();
+	}
 	if (range == nullptr)
 	{
 		LOG << "\t\t" << "found no range -> skip" << std::endl;
@@ -326,7 +343,7 @@ void Decoder::decodeJumpTarget(const JumpTarget& jt)
 		}
 		_somethingDecoded = true;
 
-		_llvm2capstone->emplace(res.llvmInsn, res.capstoneInsn);
+		_llvm2capstone->try_emplace(res.llvmInsn, res.capstoneInsn);
 
 		bbEnd |= getJumpTargetsFromInstruction(oldAddr, res, bytes.second);
 		bbEnd |= instructionBreaksBasicBlock(oldAddr, res);
@@ -344,6 +361,15 @@ void Decoder::decodeJumpTarget(const JumpTarget& jt)
 capstone2llvmir::Capstone2LlvmIrTranslator::TranslationResultOne
 Decoder::translate(ByteData& bytes, common::Address& addr, llvm::IRBuilder<>& irb)
 {
+	if (auto* insn = getPredecodedInsn(addr, bytes.second, true))
+	{
+		auto res = _c2l->translateOneDecoded(insn, irb);
+		bytes.first += insn->size;
+		bytes.second -= insn->size;
+		addr += insn->size;
+		return res;
+	}
+
 	auto res = _c2l->translateOne(bytes.first, bytes.second, addr, irb);
 
 	// MIPS 64-bit mode can decompile more instructions than the 32-bit mode.
@@ -365,6 +391,70 @@ Decoder::translate(ByteData& bytes, common::Address& addr, llvm::IRBuilder<>& ir
 	return res;
 }
 
+/**
+ * In the selected-decode-only mode with a non-zero selected decode depth,
+ * the functions called from the selected ranges (up to the depth) are decoded
+ * as well, so that their arguments and return values can be inferred.
+ * \return Range in which \p jt, which is in no range to decode, can be decoded
+ *         because of this, or nothing if it should not be decoded.
+ */
+std::optional<AddressRange> Decoder::getSelectionDependencyRange(
+		const JumpTarget& jt)
+{
+	auto& params = _config->getConfig().parameters;
+	if (!params.isSelectedDecodeOnly()
+			|| params.getSelectedDecodeDepth() == 0
+			|| jt.getType() > JumpTarget::eType::CONTROL_FLOW_RETURN_TARGET
+			|| jt.getFromAddress().isUndefined())
+	{
+		return std::nullopt;
+	}
+
+	// Call depth of the function the jump target was found in.
+	std::size_t depth = 0;
+	if (!params.selectedRanges.contains(jt.getFromAddress()))
+	{
+		auto* f = getFunctionBeforeAddress(jt.getFromAddress());
+		auto it = f
+				? _selectionDependencies.find(getFunctionAddress(f))
+				: _selectionDependencies.end();
+		if (it == _selectionDependencies.end())
+		{
+			return std::nullopt;
+		}
+		depth = it->second;
+	}
+
+	if (jt.getType() == JumpTarget::eType::CONTROL_FLOW_CALL_TARGET)
+	{
+		if (depth >= params.getSelectedDecodeDepth())
+		{
+			return std::nullopt;
+		}
+		auto it = _selectionDependencies.emplace(jt.getAddress(), depth + 1);
+		if (!it.second && depth + 1 < it.first->second)
+		{
+			it.first->second = depth + 1;
+		}
+	}
+	else if (depth == 0)
+	{
+		// Jumps out of the selected ranges are not followed.
+		return std::nullopt;
+	}
+
+	auto* seg = _image->getImage()->getSegmentFromAddress(jt.getAddress());
+	if (seg == nullptr)
+	{
+		return std::nullopt;
+	}
+	Address start = seg->getAddress();
+	Address end = seg->getPhysicalEndAddress();
+	LOG << "\t\t" << "selection dependency (depth " << depth << ")"
+			<< std::endl;
+	return AddressRange(start, end);
+}
+
 /**
  * Check if the given jump targets and bytes can/should be decoded.
  * \return The number of bytes to skip from decoding. If zero, then dry run was
@@ -1402,7 +1492,7 @@ void Decoder::handleDelaySlotTypical(
 		{
 			break;
 		}
-		_llvm2capstone->emplace(r.llvmInsn, r.capstoneInsn);
+		_llvm2capstone->try_emplace(r.llvmInsn, r.capstoneInsn);
 	}
 
 	irb.SetInsertPoint(oldIp);
@@ -1459,7 +1549,7 @@ void Decoder::handleDelaySlotLikely(
 			{
 				break;
 			}
-			_llvm2capstone->emplace(res.llvmInsn, res.capstoneInsn);
+			_llvm2capstone->try_emplace(res.llvmInsn, res.capstoneInsn);
 		}
 
 		_likelyBb2Target.emplace(newBb, target);
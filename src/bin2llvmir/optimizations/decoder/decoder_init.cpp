@@ -84,6 +84,7 @@ void Decoder::initTranslator()
 			_module,
 			basicMode,
 			extraMode);
+	_c2l->setInsnArena(&AsmInstruction::getCapstoneInsnArena(_module));
 }
 
 /**
@@ -182,8 +183,7 @@ void Decoder::initEnvironmentRegisters()
  */
 void Decoder::initRanges()
 {
-	JumpTarget::config = _config;
-	JumpTargets::config = _config;
+	_jumpTargets.setConfig(_config);
 
 	auto& arch = _config->getConfig().architecture;
 	unsigned a = 0;
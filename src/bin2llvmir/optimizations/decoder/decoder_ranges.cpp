@@ -192,6 +192,11 @@ const common::AddressRange* RangesToDecode::get(common::Address a) const
 	return p ? p : getAlternative(a);
 }
 
+const common::AddressRangeContainer& RangesToDecode::getPrimaryRanges() const
+{
+	return _primaryRanges;
+}
+
 void RangesToDecode::setArchitectureInstructionAlignment(unsigned a)
 {
 	archInsnAlign = a;
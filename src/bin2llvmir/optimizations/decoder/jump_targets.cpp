@@ -18,14 +18,13 @@ namespace bin2llvmir {
 //==============================================================================
 //
 
-Config* JumpTarget::config = nullptr;
-
 JumpTarget::JumpTarget()
 {
 
 }
 
 JumpTarget::JumpTarget(
+		Config* c,
 		retdec::common::Address a,
 		eType t,
 		cs_mode m,
@@ -36,9 +35,12 @@ JumpTarget::JumpTarget(
 		_size(sz),
 		_type(t),
 		_fromAddress(f),
-		_mode(m)
+		_mode(m),
+		_config(c)
 {
-	if (config->getConfig().architecture.isArm32OrThumb() && _address % 2)
+	if (_config
+			&& _config->getConfig().architecture.isArm32OrThumb()
+			&& _address % 2)
 	{
 		_mode = CS_MODE_THUMB;
 		_address -= 1;
@@ -157,8 +159,11 @@ std::ostream& operator<<(std::ostream &out, const JumpTarget& jt)
 
 	out << jt.getAddress() << " (" << t << ")";
 
-	auto& arch = jt.config->getConfig().architecture;
-	out << " (" << capstone_utils::mode2string(arch, jt.getMode()) << ")";
+	if (jt._config)
+	{
+		auto& arch = jt._config->getConfig().architecture;
+		out << " (" << capstone_utils::mode2string(arch, jt.getMode()) << ")";
+	}
 
 	if (jt.getFromAddress().isDefined())
 	{
@@ -178,7 +183,16 @@ std::ostream& operator<<(std::ostream &out, const JumpTarget& jt)
 //==============================================================================
 //
 
-Config* JumpTargets::config = nullptr;
+JumpTargets::JumpTargets(Config* c) :
+		_config(c)
+{
+
+}
+
+void JumpTargets::setConfig(Config* c)
+{
+	_config = c;
+}
 
 const JumpTarget* JumpTargets::push(
 		retdec::common::Address a,
@@ -187,7 +201,7 @@ const JumpTarget* JumpTargets::push(
 		retdec::common::Address f,
 		std::optional<std::size_t> sz)
 {
-	auto& arch = config->getConfig().architecture;
+	auto& arch = _config->getConfig().architecture;
 
 	if (arch.isArm64() && m == CS_MODE_THUMB)
 	{
@@ -213,7 +227,7 @@ const JumpTarget* JumpTargets::push(
 		else
 		{
 			LOG << "\t\t" << "[+] JT @ " << a << std::endl;
-			return &(*_data.emplace(a, t, m, f, sz).first);
+			return &(*_data.emplace(_config, a, t, m, f, sz).first);
 		}
 	}
 
@@ -30,7 +30,7 @@ std::size_t Decoder::decodeJumpTargetDryRun_ppc(
 	uint64_t addr = jt.getAddress();
 	std::size_t nops = 0;
 	bool first = true;
-	while (cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, _dryCsInsn))
+	while (disasm(ce, bytes, addr, _dryCsInsn))
 	{
 		if (jt.getType() == JumpTarget::eType::LEFTOVER
 				&& (first || nops > 0)
@@ -0,0 +1,287 @@
+/**
+* @file src/bin2llvmir/optimizations/decoder/predecode.cpp
+* @brief Parallel linear-sweep disassembling of ranges to decode.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+
+#include "retdec/utils/parallel.h"
+#include "retdec/bin2llvmir/optimizations/decoder/decoder.h"
+
+using namespace retdec::capstone2llvmir;
+
+namespace retdec {
+namespace bin2llvmir {
+
+namespace {
+
+/// Size of ranges' chunks disassembled by one job.
+const std::uint64_t PREDECODE_CHUNK_SIZE = 0x1000;
+/// Number of chunks disassembled at once per job.
+const std::size_t PREDECODE_BATCH_PER_JOB = 2;
+/// Maximal number of disassembled chunks kept at once per job.
+const std::size_t PREDECODE_WINDOW_PER_JOB = 4;
+/// Expected average size of instructions, used to size the chunks' arenas.
+const std::uint64_t PREDECODE_AVERAGE_INSN_SIZE = 4;
+
+} // anonymous namespace
+
+/**
+ * Prepare linear disassembling of the primary ranges to decode in parallel
+ * chunks. Disassembled instructions are then used by the recursive
+ * traversal, which only reconstructs control flow and emits LLVM IR
+ * (serially). Addresses that were not disassembled in advance (other
+ * instruction mode, linear sweep got out of sync with the traversal, etc.)
+ * are disassembled on demand as before, so the result does not depend on
+ * this cache.
+ *
+ * Chunks are disassembled lazily, in batches starting at the chunk the
+ * traversal asks for, and only a bounded window of them is kept at once.
+ * Instructions the traversal translates are copied into the module's
+ * arena, the rest is released together with their chunk. Memory used by
+ * the cache thus does not grow with the size of the input.
+ *
+ * It is done only when more than one job is allowed -- the linear sweep
+ * disassembles also bytes that the traversal never gets to, so it is not
+ * worth it when it cannot run in parallel.
+ */
+void Decoder::predecode()
+{
+	auto jobs = utils::getNumberOfJobs(
+			_config->getConfig().parameters.getJobs());
+	if (jobs <= 1)
+	{
+		return;
+	}
+
+	for (auto& r : _ranges.getPrimaryRanges())
+	{
+		std::uint64_t s = r.getStart();
+		std::uint64_t e = r.getEnd();
+		for (; s < e; s += PREDECODE_CHUNK_SIZE)
+		{
+			_predecodeChunks.emplace_back();
+			auto& chunk = _predecodeChunks.back();
+			chunk.start = s;
+			chunk.end = std::min(s + PREDECODE_CHUNK_SIZE, e);
+			chunk.rangeEnd = e;
+		}
+	}
+	_predecodeJobs = jobs;
+	_predecodedMode = _c2l->getBasicMode();
+
+	LOG << "\t" << "chunks to predecode: " << _predecodeChunks.size()
+			<< std::endl;
+}
+
+/**
+ * Disassemble (in parallel) a batch of chunks that are not disassembled yet,
+ * starting at the chunk with index @a first. Before that, the least
+ * recently used chunks are released so that the window of disassembled
+ * chunks stays bounded.
+ */
+void Decoder::predecodeChunks(std::size_t first)
+{
+	std::vector<std::size_t> batch;
+	for (std::size_t i = first;
+			i < _predecodeChunks.size()
+				&& batch.size() < PREDECODE_BATCH_PER_JOB * _predecodeJobs;
+			++i)
+	{
+		if (!_predecodeChunks[i].decoded)
+		{
+			batch.push_back(i);
+		}
+	}
+
+	auto window = PREDECODE_WINDOW_PER_JOB * _predecodeJobs;
+	releasePredecodedChunks(window > batch.size() ? window - batch.size() : 0);
+
+	auto arch = _c2l->getArchitecture();
+	auto basicMode = _c2l->getBasicMode();
+	auto mode = static_cast<cs_mode>(basicMode + _c2l->getExtraMode());
+	std::size_t step = arch == CS_ARCH_X86 ? 1
+			: (arch == CS_ARCH_ARM && (basicMode & CS_MODE_THUMB)) ? 2
+			: 4;
+
+	// Every job has its own Capstone handle and chunk, nothing is shared.
+	//
+	utils::parallelFor(batch.size(), _predecodeJobs, [&](std::size_t i)
+	{
+		auto& chunk = _predecodeChunks[batch[i]];
+		chunk.arena = InsnArena(std::max<std::uint64_t>(
+				(chunk.end - chunk.start) / PREDECODE_AVERAGE_INSN_SIZE, 1));
+
+		ByteData bytes = _image->getImage()->getRawSegmentData(chunk.start);
+		if (bytes.first == nullptr)
+		{
+			return;
+		}
+		auto toRangeEnd = chunk.rangeEnd - chunk.start;
+		bytes.second = toRangeEnd < bytes.second ? toRangeEnd : bytes.second;
+
+		csh ce = 0;
+		if (cs_open(arch, mode, &ce) != CS_ERR_OK)
+		{
+			return;
+		}
+		if (cs_option(ce, CS_OPT_DETAIL, CS_OPT_ON) == CS_ERR_OK)
+		{
+			// The last instruction may end in the next chunk, the next
+			// chunk's job starts at its start anyway.
+			//
+			std::uint64_t addr = chunk.start;
+			cs_insn* insn = chunk.arena.allocate();
+			while (addr < chunk.end && bytes.second > 0)
+			{
+				if (cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, insn))
+				{
+					chunk.insns.emplace_back(insn->address, insn);
+					insn = chunk.arena.allocate();
+				}
+				else
+				{
+					auto sz = std::min(step, bytes.second);
+					bytes.first += sz;
+					bytes.second -= sz;
+					addr += sz;
+				}
+			}
+			chunk.arena.deallocate(insn);
+		}
+		cs_close(&ce);
+	});
+
+	for (auto i : batch)
+	{
+		_predecodeChunks[i].decoded = true;
+		_predecodeChunks[i].lastUse = ++_predecodeClock;
+	}
+	_predecodedChunkCount += batch.size();
+}
+
+/**
+ * Release instructions of the least recently used disassembled chunks, so
+ * that at most @a keep of them stay disassembled. Released chunks are
+ * disassembled again if they are needed later.
+ */
+void Decoder::releasePredecodedChunks(std::size_t keep)
+{
+	if (_predecodedChunkCount <= keep)
+	{
+		return;
+	}
+
+	std::vector<PredecodeChunk*> decoded;
+	for (auto& chunk : _predecodeChunks)
+	{
+		if (chunk.decoded)
+		{
+			decoded.push_back(&chunk);
+		}
+	}
+	std::sort(decoded.begin(), decoded.end(),
+			[](const PredecodeChunk* c1, const PredecodeChunk* c2)
+			{
+				return c1->lastUse < c2->lastUse;
+			});
+
+	for (std::size_t i = 0; i < decoded.size() - keep; ++i)
+	{
+		decoded[i]->arena.clear();
+		decoded[i]->insns.clear();
+		decoded[i]->insns.shrink_to_fit();
+		decoded[i]->decoded = false;
+	}
+	_predecodedChunkCount = keep;
+}
+
+/**
+ * Get instruction pre-decoded at the address @a addr in the translator's
+ * current mode, which is not longer than @a maxSize. The chunk containing
+ * @a addr is disassembled first if it is not disassembled yet.
+ * @param take If set, a copy of the instruction owned by the module's
+ *             arena is returned. Use this if the instruction is going to
+ *             be translated, since the pre-decoded instructions are released
+ *             with their chunks.
+ * @return Pre-decoded instruction, or @c nullptr if there is none.
+ */
+cs_insn* Decoder::getPredecodedInsn(
+		common::Address addr,
+		std::size_t maxSize,
+		bool take)
+{
+	if (_predecodeChunks.empty() || _c2l->getBasicMode() != _predecodedMode)
+	{
+		return nullptr;
+	}
+
+	std::uint64_t a = addr;
+	auto chunkIt = std::upper_bound(
+			_predecodeChunks.begin(),
+			_predecodeChunks.end(),
+			a,
+			[](std::uint64_t v, const PredecodeChunk& c)
+			{
+				return v < c.start;
+			});
+	if (chunkIt == _predecodeChunks.begin() || a >= (--chunkIt)->end)
+	{
+		return nullptr;
+	}
+	if (!chunkIt->decoded)
+	{
+		predecodeChunks(chunkIt - _predecodeChunks.begin());
+	}
+	chunkIt->lastUse = ++_predecodeClock;
+
+	auto& insns = chunkIt->insns;
+	auto it = std::lower_bound(
+			insns.begin(),
+			insns.end(),
+			a,
+			[](const std::pair<std::uint64_t, cs_insn*>& p, std::uint64_t v)
+			{
+				return p.first < v;
+			});
+	if (it == insns.end()
+			|| it->first != a
+			|| it->second->size > maxSize)
+	{
+		return nullptr;
+	}
+
+	return take
+			? AsmInstruction::getCapstoneInsnArena(_module).allocateCopy(
+					*it->second)
+			: it->second;
+}
+
+/**
+ * The same as @c cs_disasm_iter(), but the pre-decoded instruction is
+ * copied into @a insn (including its detail) if there is one.
+ */
+bool Decoder::disasm(csh ce, ByteData& bytes, std::uint64_t& addr, cs_insn* insn)
+{
+	if (auto* cached = getPredecodedInsn(addr, bytes.second, false))
+	{
+		auto* detail = insn->detail;
+		*insn = *cached;
+		insn->detail = detail;
+		if (detail && cached->detail)
+		{
+			*detail = *cached->detail;
+		}
+
+		bytes.first += cached->size;
+		bytes.second -= cached->size;
+		addr += cached->size;
+		return true;
+	}
+
+	return cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, insn);
+}
+
+} // namespace bin2llvmir
+} // namespace retdec
@@ -33,7 +33,7 @@ std::size_t Decoder::decodeJumpTargetDryRun_x86(
 	bool storeOneToEax = false;
 	bool lastSyscall = false;
 	std::size_t decodedSz = 0;
-	while (cs_disasm_iter(ce, &bytes.first, &bytes.second, &addr, _dryCsInsn))
+	while (disasm(ce, bytes, addr, _dryCsInsn))
 	{
 		decodedSz += _dryCsInsn->size;
 		auto& detail = _dryCsInsn->detail->x86;
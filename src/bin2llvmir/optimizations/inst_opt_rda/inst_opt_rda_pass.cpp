@@ -9,6 +9,7 @@
 #include "retdec/bin2llvmir/analyses/reaching_definitions.h"
 #include "retdec/bin2llvmir/optimizations/inst_opt_rda/inst_opt_rda_pass.h"
 #include "retdec/bin2llvmir/optimizations/inst_opt_rda/inst_opt_rda.h"
+#include "retdec/bin2llvmir/utils/function_pass_scheduler.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
 
 using namespace llvm;
@@ -45,25 +46,37 @@ bool InstructionRdaOptimizer::runOnModuleCustom(llvm::Module& m, Abi* abi)
 	return run();
 }
 
+/**
+ * RDA of a function only reads the IR, so it is computed in parallel.
+ * Optimizations using the RDA modify the IR and run serially.
+ */
 bool InstructionRdaOptimizer::run()
 {
-	bool changed = false;
-
-	for (Function& f : *_module)
-	{
-		changed |= runOnFunction(&f);
-	}
-
-	return changed;
+	using RdaPtr = std::unique_ptr<ReachingDefinitionsAnalysis>;
+
+	FunctionPassScheduler scheduler(_module);
+	return scheduler.run<RdaPtr>(
+		[this](Function& f)
+		{
+			auto RDA = std::make_unique<ReachingDefinitionsAnalysis>();
+			RDA->runOnFunction(f, _abi, true);
+			return RDA;
+		},
+		[this](Function& f, RdaPtr& RDA)
+		{
+			bool changed = runOnFunction(&f, *RDA);
+			RDA.reset();
+			return changed;
+		}
+	);
 }
 
-bool InstructionRdaOptimizer::runOnFunction(llvm::Function* f)
+bool InstructionRdaOptimizer::runOnFunction(
+		llvm::Function* f,
+		ReachingDefinitionsAnalysis& RDA)
 {
 	bool changed = false;
 
-	ReachingDefinitionsAnalysis RDA;
-	RDA.runOnFunction(*f, _abi, true);
-
 	std::unordered_set<llvm::Value*> toRemove;
 
 	for (auto it = inst_begin(f), eIt = inst_end(f); it != eIt;)
@@ -78,7 +91,7 @@ bool InstructionRdaOptimizer::runOnFunction(llvm::Function* f)
 				&toRemove
 		);
 	}
-// exit(1);
+
 	IrModifier::eraseUnusedInstructionsRecursive(toRemove);
 	return changed;
 }
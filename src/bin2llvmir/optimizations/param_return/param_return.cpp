@@ -195,7 +195,8 @@ void ParamReturn::collectExtraData(DataFlowEntry* dataflow) const
 	auto& config = _config->getConfig();
 	if (config.parameters.isSelectedDecodeOnly()) {
 		auto rdFnc = _config->getFunctionAddress(fnc);
-		auto isDecoded = config.parameters.selectedRanges.contains(rdFnc);
+		auto isDecoded = config.parameters.selectedRanges.contains(rdFnc)
+				|| _config->isSelectionDependency(fnc);
 		dataflow->setIsFullyDecoded(isDecoded);
 	}
 
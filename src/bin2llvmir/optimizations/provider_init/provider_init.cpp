@@ -13,14 +13,15 @@
 #include "retdec/bin2llvmir/optimizations/provider_init/provider_init.h"
 #include "retdec/bin2llvmir/providers/abi/abi.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
-#include "retdec/bin2llvmir/providers/calling_convention/calling_convention.h"
 #include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/providers/debugformat.h"
 #include "retdec/bin2llvmir/providers/demangler.h"
 #include "retdec/bin2llvmir/providers/fileimage.h"
 #include "retdec/bin2llvmir/providers/lti.h"
 #include "retdec/bin2llvmir/providers/names.h"
+#include "retdec/bin2llvmir/providers/provider_context.h"
 #include "retdec/cpdetect/cpdetect.h"
+#include "retdec/utils/profiler.h"
 #include "retdec/utils/string.h"
 #include "retdec/yaracpp/yara_detector.h"
 
@@ -173,16 +174,10 @@ void ProviderInitialization::setConfig(retdec::config::Config* c)
  */
 bool ProviderInitialization::runOnModule(Module& m)
 {
-	AbiProvider::clear();
-	AsmInstruction::clear();
-	ConfigProvider::clear();
-	DebugFormatProvider::clear();
-	DemanglerProvider::clear();
-	FileImageProvider::clear();
-	LtiProvider::clear();
-	NamesProvider::clear();
+	// Clear only the data of this module -- other modules may be
+	// decompiled in other threads at the same time.
+	ProviderContext::clear(&m);
 	SymbolicTree::clear();
-	CallingConventionProvider::clear();
 
 	// Config.
 	//
@@ -199,10 +194,12 @@ bool ProviderInitialization::runOnModule(Module& m)
 
 	// Fileimage.
 	//
+	utils::Profiler::Scope fileImageProfile("fileformat");
 	auto* f = FileImageProvider::addFileImage(
 			&m,
 			c->getConfig().parameters.getInputFile(),
 			c);
+	fileImageProfile.stop();
 	if (f == nullptr)
 	{
 		throw std::runtime_error("ProviderInitialization: f == nullptr");
@@ -269,6 +266,7 @@ bool ProviderInitialization::runOnModule(Module& m)
 	// Run cpdetect and set info to config.
 	// TODO: we could probably be using cpdetect results.
 	//
+	utils::Profiler::Scope cpdetectProfile("cpdetect");
 	cpdetect::ToolInformation tools;
 	cpdetect::DetectParams searchParams(
 			cpdetect::SearchType::MOST_SIMILAR,
@@ -348,6 +346,7 @@ bool ProviderInitialization::runOnModule(Module& m)
 			}
 		}
 	}
+	cpdetectProfile.stop();
 	// TODO: this is needed, but we should remove the whole PIC thing.
 	if (c->getConfig().tools.isPic32())
 	{
@@ -356,12 +355,22 @@ bool ProviderInitialization::runOnModule(Module& m)
 
 	// YARA crypto patterns scanning.
 	//
+	utils::Profiler::Scope yaraProfile("crypto patterns");
 	yaracpp::YaraDetector yara;
 	for (auto& crypto : c->getConfig().parameters.cryptoPatternPaths)
 	{
 		yara.addRuleFile(crypto);
 	}
-	yara.analyze(c->getConfig().parameters.getInputFile());
+	// Scan the already loaded input file rather than reading it again.
+	if (auto* fileFormat = f->getFileFormat())
+	{
+		const auto bytes = fileFormat->getBytes();
+		yara.analyze(bytes.data(), bytes.size());
+	}
+	else
+	{
+		yara.analyze(c->getConfig().parameters.getInputFile());
+	}
 	for(const auto &rule : yara.getDetectedRules())
 	{
 		common::Pattern p = saveCryptoRule(
@@ -370,6 +379,7 @@ bool ProviderInitialization::runOnModule(Module& m)
 		);
 		c->getConfig().patterns.push_back(p);
 	}
+	yaraProfile.stop();
 	// TODO: removeRedundantCryptoRules()
 	// TODO: sortCryptoPatternMatches()
 
@@ -403,7 +413,7 @@ bool ProviderInitialization::runOnModule(Module& m)
 
 	NamesProvider::addNames(&m, c, debug, f, d, lti);
 
-	AsmInstruction::clear();
+	AsmInstruction::clear(&m);
 
 	return false;
 }
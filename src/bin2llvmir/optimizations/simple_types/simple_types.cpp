@@ -33,6 +33,8 @@ using namespace llvm;
 namespace retdec {
 namespace bin2llvmir {
 
+ModuleDataMap<bool> SimpleTypesAnalysis::_analyzedModules;
+
 std::string priority2string(eSourcePriority p)
 {
 	if (p == eSourcePriority::PRIORITY_NONE) return "PRIORITY_NONE";
@@ -67,6 +69,15 @@ void SimpleTypesAnalysis::getAnalysisUsage(AnalysisUsage& AU) const
 
 }
 
+/**
+ * Forget the phase of the pass for the module @a m, so that the next run on
+ * it (or on another module created at the same address) is the first one.
+ */
+void SimpleTypesAnalysis::clear(llvm::Module* m)
+{
+	_analyzedModules.clear(m);
+}
+
 bool SimpleTypesAnalysis::runOnModule(Module& M)
 {
 	if (!ConfigProvider::getConfig(&M, config))
@@ -82,11 +93,15 @@ bool SimpleTypesAnalysis::runOnModule(Module& M)
 	module = &M;
 	_specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(module);
 
-	static bool first = true;
+	// The pass runs twice in a decompilation: the first run reconstructs
+	// types, the second one only fixes uses of global variables. The phase is
+	// tracked for every module, so that parallel decompilations do not
+	// interfere.
+	bool first = _analyzedModules.get(&M) == nullptr;
 
 	if (first)
 	{
-		first = false;
+		_analyzedModules.add(&M, true);
 
 		RDA.runOnModule(M, AbiProvider::getAbi(&M));
 		buildEqSets(M);
@@ -99,7 +114,7 @@ bool SimpleTypesAnalysis::runOnModule(Module& M)
 	}
 	else
 	{
-		first = true;
+		_analyzedModules.clear(&M);
 
 		instToErase.clear();
 
@@ -16,6 +16,7 @@
 #include "retdec/bin2llvmir/analyses/reaching_definitions.h"
 #include "retdec/bin2llvmir/optimizations/stack/stack.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
+#include "retdec/bin2llvmir/utils/function_pass_scheduler.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
 #define debug_enabled false
 #include "retdec/bin2llvmir/utils/llvm.h"
@@ -69,63 +70,82 @@ bool StackAnalysis::run()
 		return false;
 	}
 
-	ReachingDefinitionsAnalysis RDA;
-	RDA.runOnModule(*_module, _abi);
+	using RdaPtr = std::unique_ptr<ReachingDefinitionsAnalysis>;
 
-	for (auto& f : *_module)
-	{
-		std::map<Value*, Value*> val2val;
-		for (inst_iterator I = inst_begin(f), E = inst_end(f); I != E;)
+	// RDA of a function only reads the IR, so it is computed in parallel.
+	// Stack variables are created serially.
+	FunctionPassScheduler scheduler(_module);
+	scheduler.run<RdaPtr>(
+		[this](Function& f)
+		{
+			auto RDA = std::make_unique<ReachingDefinitionsAnalysis>();
+			RDA->runOnFunction(f, _abi);
+			return RDA;
+		},
+		[this](Function& f, RdaPtr& RDA)
 		{
-			Instruction& i = *I;
-			++I;
+			runOnFunction(f, *RDA);
+			RDA.reset();
+			return false;
+		}
+	);
 
-			if (StoreInst *store = dyn_cast<StoreInst>(&i))
-			{
-				if (AsmInstruction::isLlvmToAsmInstruction(store))
-				{
-					continue;
-				}
+	IrModifier::eraseUnusedInstructionsRecursive(_toRemove);
 
-				handleInstruction(
-						RDA,
-						store,
-						store->getValueOperand(),
-						store->getValueOperand()->getType(),
-						val2val);
+	return false;
+}
 
-				if (isa<GlobalVariable>(store->getPointerOperand()))
-				{
-					continue;
-				}
+void StackAnalysis::runOnFunction(
+		llvm::Function& f,
+		ReachingDefinitionsAnalysis& RDA)
+{
+	std::map<Value*, Value*> val2val;
+	for (inst_iterator I = inst_begin(f), E = inst_end(f); I != E;)
+	{
+		Instruction& i = *I;
+		++I;
 
-				handleInstruction(
-						RDA,
-						store,
-						store->getPointerOperand(),
-						store->getValueOperand()->getType(),
-						val2val);
+		if (StoreInst *store = dyn_cast<StoreInst>(&i))
+		{
+			if (AsmInstruction::isLlvmToAsmInstruction(store))
+			{
+				continue;
 			}
-			else if (LoadInst* load = dyn_cast<LoadInst>(&i))
+
+			handleInstruction(
+					RDA,
+					store,
+					store->getValueOperand(),
+					store->getValueOperand()->getType(),
+					val2val);
+
+			if (isa<GlobalVariable>(store->getPointerOperand()))
 			{
-				if (isa<GlobalVariable>(load->getPointerOperand()))
-				{
-					continue;
-				}
+				continue;
+			}
 
-				handleInstruction(
-						RDA,
-						load,
-						load->getPointerOperand(),
-						load->getType(),
-						val2val);
+			handleInstruction(
+					RDA,
+					store,
+					store->getPointerOperand(),
+					store->getValueOperand()->getType(),
+					val2val);
+		}
+		else if (LoadInst* load = dyn_cast<LoadInst>(&i))
+		{
+			if (isa<GlobalVariable>(load->getPointerOperand()))
+			{
+				continue;
 			}
+
+			handleInstruction(
+					RDA,
+					load,
+					load->getPointerOperand(),
+					load->getType(),
+					val2val);
 		}
 	}
-
-	IrModifier::eraseUnusedInstructionsRecursive(_toRemove);
-
-	return false;
 }
 
 void StackAnalysis::handleInstruction(
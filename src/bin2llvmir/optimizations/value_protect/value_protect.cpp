@@ -259,7 +259,10 @@ llvm::Function* getWriteUndefQword(llvm::Module* m)
 
 char ValueProtect::ID = 0;
 
-std::map<llvm::Type*, llvm::Function*> ValueProtect::_type2fnc;
+std::map<
+		llvm::Module*,
+		std::map<llvm::Type*, llvm::Function*>> ValueProtect::_module2type2fnc;
+std::mutex ValueProtect::_mutex;
 
 static RegisterPass<ValueProtect> X(
 		"retdec-value-protect",
@@ -303,12 +306,23 @@ bool ValueProtect::run()
 
 	bool changed = false;
 
-	if (!_type2fnc.empty() && _type2fnc.begin()->second->getParent() != _module)
 	{
-		_type2fnc.clear();
+		std::lock_guard<std::mutex> lock(_mutex);
+		_type2fnc = &_module2type2fnc[_module];
 	}
 
-	changed = _type2fnc.empty() ? protect() : unprotect();
+	if (_type2fnc->empty())
+	{
+		changed = protect();
+	}
+	else
+	{
+		changed = unprotect();
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_module2type2fnc.erase(_module);
+		_type2fnc = nullptr;
+	}
 
 	return changed;
 }
@@ -621,8 +635,8 @@ bool ValueProtect::protectLoadStores()
 
 llvm::Function* ValueProtect::getOrCreateFunction(llvm::Type* t)
 {
-	auto fIt = _type2fnc.find(t);
-	return fIt != _type2fnc.end() ? fIt->second : createFunction(t);
+	auto fIt = _type2fnc->find(t);
+	return fIt != _type2fnc->end() ? fIt->second : createFunction(t);
 }
 
 llvm::Function* ValueProtect::createFunction(llvm::Type* t)
@@ -636,9 +650,9 @@ llvm::Function* ValueProtect::createFunction(llvm::Type* t)
 	auto* fnc = Function::Create(
 			ft,
 			GlobalValue::ExternalLinkage,
-			names::generateFunctionNameUndef(_type2fnc.size()),
+			names::generateFunctionNameUndef(_type2fnc->size()),
 			_module);
-	_type2fnc[t] = fnc;
+	(*_type2fnc)[t] = fnc;
 
 	return fnc;
 }
@@ -649,7 +663,7 @@ bool ValueProtect::unprotect()
 
 	std::map<std::pair<Function*, Type*>, Value*> ft2v;
 
-	for (auto& p : _type2fnc)
+	for (auto& p : *_type2fnc)
 	{
 		auto* fnc = p.second;
 
@@ -705,7 +719,7 @@ bool ValueProtect::unprotect()
 		}
 	}
 
-	_type2fnc.clear();
+	_type2fnc->clear();
 	return changed;
 }
 
@@ -297,7 +297,7 @@ Config* Abi::getConfig() const
 //==============================================================================
 //
 
-std::map<llvm::Module*, std::unique_ptr<Abi>> AbiProvider::_module2abi;
+ModuleDataMap<std::unique_ptr<Abi>> AbiProvider::_module2abi;
 
 Abi* AbiProvider::addAbi(
 		llvm::Module* m,
@@ -308,30 +308,26 @@ Abi* AbiProvider::addAbi(
 		return nullptr;
 	}
 
+	std::unique_ptr<Abi> abi;
 	if (c->getConfig().architecture.isArm32OrThumb())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiArm>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiArm>(m, c);
 	}
 	else if (c->getConfig().architecture.isArm64())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiArm64>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiArm64>(m, c);
 	}
 	else if (c->getConfig().architecture.isMips())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiMips>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiMips>(m, c);
 	}
 	else if (c->getConfig().architecture.isPic32())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiPic32>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiPic32>(m, c);
 	}
 	else if (c->getConfig().architecture.isPpc())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiPowerpc>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiPowerpc>(m, c);
 	}
 	else if (c->getConfig().architecture.isX86_64())
 	{
@@ -339,27 +335,29 @@ Abi* AbiProvider::addAbi(
 
 		if (isPe || c->getConfig().tools.isMsvc())
 		{
-			auto p = _module2abi.emplace(m, std::make_unique<AbiMS_X64>(m, c));
-			return p.first->second.get();
+			abi = std::make_unique<AbiMS_X64>(m, c);
+		}
+		else
+		{
+			abi = std::make_unique<AbiX64>(m, c);
 		}
-
-		auto p = _module2abi.emplace(m, std::make_unique<AbiX64>(m, c));
-		return p.first->second.get();
 	}
 	else if (c->getConfig().architecture.isX86())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiX86>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiX86>(m, c);
 	}
 	// ...
+	else
+	{
+		return nullptr;
+	}
 
-	return nullptr;
+	return _module2abi.add(m, std::move(abi));
 }
 
 Abi* AbiProvider::getAbi(llvm::Module* m)
 {
-	auto f = _module2abi.find(m);
-	return f != _module2abi.end() ? f->second.get() : nullptr;
+	return _module2abi.get(m);
 }
 
 bool AbiProvider::getAbi(llvm::Module* m, Abi*& abi)
@@ -373,5 +371,13 @@ void AbiProvider::clear()
 	_module2abi.clear();
 }
 
+/**
+ * Clear data associated with the given module @a m.
+ */
+void AbiProvider::clear(llvm::Module* m)
+{
+	_module2abi.clear(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -20,8 +20,12 @@ using namespace llvm;
 namespace retdec {
 namespace bin2llvmir {
 
-std::vector<AsmInstruction::ModuleGlobalPair> AsmInstruction::_module2global;
-std::vector<AsmInstruction::ModuleInstructionMap> AsmInstruction::_module2instMap;
+std::list<AsmInstruction::ModuleGlobalPair> AsmInstruction::_module2global;
+std::list<AsmInstruction::ModuleInstructionMap> AsmInstruction::_module2instMap;
+std::list<AsmInstruction::ModuleInsnArena> AsmInstruction::_module2insnArena;
+std::list<AsmInstruction::ModuleBasicBlockAddressMap> AsmInstruction::_module2bbAddrMap;
+std::shared_mutex AsmInstruction::_mutex;
+std::atomic<std::uint64_t> AsmInstruction::_generation(0);
 
 AsmInstruction::AsmInstruction()
 {
@@ -186,6 +190,12 @@ const llvm::GlobalVariable* AsmInstruction::getLlvmToAsmGlobalVariablePrivate(
 Llvm2CapstoneInsnMap& AsmInstruction::getLlvmToCapstoneInsnMap(
 		const llvm::Module* m)
 {
+	if (auto* map = findLlvmToCapstoneInsnMap(m))
+	{
+		return *map;
+	}
+
+	std::unique_lock<std::shared_mutex> lock(_mutex);
 	for (auto& p : _module2instMap)
 	{
 		if (p.first == m)
@@ -193,16 +203,73 @@ Llvm2CapstoneInsnMap& AsmInstruction::getLlvmToCapstoneInsnMap(
 			return p.second;
 		}
 	}
+	auto it = _module2instMap.emplace(
+			_module2instMap.end(),
+			m,
+			Llvm2CapstoneInsnMap());
+	return it->second;
+}
 
-	auto it = _module2instMap.emplace(_module2instMap.end(), std::make_pair(
+/**
+ * Get the arena owning Capstone instructions of the module @a m.
+ * It is created if it does not exist yet, and it is freed together with
+ * the other data of the module.
+ */
+capstone2llvmir::InsnArena& AsmInstruction::getCapstoneInsnArena(
+		const llvm::Module* m)
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	for (auto& p : _module2insnArena)
+	{
+		if (p.first == m)
+		{
+			return p.second;
+		}
+	}
+	auto it = _module2insnArena.emplace(
+			_module2insnArena.end(),
 			m,
-			std::map<llvm::StoreInst*, cs_insn*>()));
+			capstone2llvmir::InsnArena());
 	return it->second;
 }
 
+/**
+ * Find the LLVM-to-Capstone map of the module @a m.
+ * The map found last by the calling thread is cached, so that the modules
+ * do not have to be locked and searched for every instruction.
+ * @return Map of the module, or @c nullptr if it does not exist.
+ */
+Llvm2CapstoneInsnMap* AsmInstruction::findLlvmToCapstoneInsnMap(
+		const llvm::Module* m)
+{
+	thread_local const llvm::Module* cachedModule = nullptr;
+	thread_local Llvm2CapstoneInsnMap* cachedMap = nullptr;
+	thread_local std::uint64_t cachedGeneration = 0;
+
+	auto generation = _generation.load(std::memory_order_acquire);
+	if (cachedMap && cachedModule == m && cachedGeneration == generation)
+	{
+		return cachedMap;
+	}
+
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	for (auto& p : _module2instMap)
+	{
+		if (p.first == m)
+		{
+			cachedModule = m;
+			cachedMap = &p.second;
+			cachedGeneration = generation;
+			return cachedMap;
+		}
+	}
+	return nullptr;
+}
+
 llvm::GlobalVariable* AsmInstruction::getLlvmToAsmGlobalVariable(
 		const llvm::Module* m)
 {
+	std::shared_lock<std::shared_mutex> lock(_mutex);
 	for (auto& p : _module2global)
 	{
 		if (p.first == m)
@@ -217,6 +284,7 @@ void AsmInstruction::setLlvmToAsmGlobalVariable(
 		const llvm::Module* m,
 		llvm::GlobalVariable* gv)
 {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
 	_module2global.emplace_back(m, gv);
 }
 
@@ -254,30 +322,82 @@ retdec::common::Address AsmInstruction::getBasicBlockAddress(
 
 retdec::common::Address getBasicBlockAddressFromName(llvm::BasicBlock* b)
 {
-	std::string n = b->getName();
+	auto n = b->getName().drop_front(names::generatedBasicBlockPrefix.size());
 	unsigned long long a = 0;
-	std::string pattern = names::generatedBasicBlockPrefix+"%llx";
-	int ret = std::sscanf(n.c_str(), pattern.c_str(), &a);
-	return ret == 1 ? common::Address(a) : common::Address();
+	return n.consumeInteger(16, a) ? common::Address() : common::Address(a);
 }
 
 // TODO: not ideal, returns only for BBs with specific names.
 retdec::common::Address AsmInstruction::getTrueBasicBlockAddress(
 		llvm::BasicBlock* bb)
 {
-	std::string n = bb->getName();
-	if (!retdec::utils::startsWith(n, names::generatedBasicBlockPrefix))
+	if (!bb->getName().startswith(names::generatedBasicBlockPrefix))
 	{
 		return common::Address();
 	}
 
-	if (bb->empty())
+	// Basic blocks created by the decoder are in the table. They are named
+	// after the address they were created for, and the decoder starts them
+	// with the instruction on this address.
+	auto a = getBasicBlockAddressFromTable(bb);
+	if (a.isDefined())
 	{
-		return getBasicBlockAddressFromName(bb);
+		return a;
 	}
 
-	AsmInstruction ai(&bb->front());
-	return ai.isValid() ? ai.getAddress() : getBasicBlockAddressFromName(bb);
+	if (!bb->empty())
+	{
+		AsmInstruction ai(&bb->front());
+		if (ai.isValid())
+		{
+			return ai.getAddress();
+		}
+	}
+
+	return getBasicBlockAddressFromName(bb);
+}
+
+/**
+ * Remember that the basic block @a bb was created for address @a a.
+ * @c getTrueBasicBlockAddress() then does not need to parse the address
+ * from the basic block's name.
+ */
+void AsmInstruction::setTrueBasicBlockAddress(
+		llvm::BasicBlock* bb,
+		retdec::common::Address a)
+{
+	const llvm::Module* m = bb->getModule();
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	for (auto& p : _module2bbAddrMap)
+	{
+		if (p.first == m)
+		{
+			p.second[bb] = a;
+			return;
+		}
+	}
+	auto it = _module2bbAddrMap.emplace(
+			_module2bbAddrMap.end(),
+			std::piecewise_construct,
+			std::forward_as_tuple(m),
+			std::forward_as_tuple());
+	it->second[bb] = a;
+}
+
+retdec::common::Address AsmInstruction::getBasicBlockAddressFromTable(
+		llvm::BasicBlock* bb)
+{
+	const llvm::Module* m = bb->getModule();
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	for (auto& p : _module2bbAddrMap)
+	{
+		if (p.first == m)
+		{
+			auto it = p.second.find(bb);
+			return it != p.second.end() ? it->second : common::Address();
+		}
+	}
+	return common::Address();
 }
 
 retdec::common::Address AsmInstruction::getBasicBlockEndAddress(
@@ -328,8 +448,25 @@ bool AsmInstruction::isLlvmToAsmInstruction(const llvm::Value* inst)
 
 void AsmInstruction::clear()
 {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
 	_module2global.clear();
 	_module2instMap.clear();
+	_module2insnArena.clear();
+	_module2bbAddrMap.clear();
+	++_generation;
+}
+
+/**
+ * Clear data associated with the given module @a m.
+ */
+void AsmInstruction::clear(const llvm::Module* m)
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2global.remove_if([m](auto& p) { return p.first == m; });
+	_module2instMap.remove_if([m](auto& p) { return p.first == m; });
+	_module2insnArena.remove_if([m](auto& p) { return p.first == m; });
+	_module2bbAddrMap.remove_if([m](auto& p) { return p.first == m; });
+	++_generation;
 }
 
 bool AsmInstruction::isValid() const
@@ -344,16 +481,14 @@ bool AsmInstruction::isInvalid() const
 
 cs_insn* AsmInstruction::getCapstoneInsn() const
 {
-	for (auto& p : _module2instMap)
+	auto* map = findLlvmToCapstoneInsnMap(_llvmToAsmInstr->getModule());
+	if (map == nullptr)
 	{
-		if (p.first == _llvmToAsmInstr->getModule())
-		{
-			auto it =  p.second.find(_llvmToAsmInstr);
-			return it != p.second.end() ? it->second : nullptr;
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	auto it = map->find(_llvmToAsmInstr);
+	return it != map->end() ? it->second : nullptr;
 }
 
 std::string AsmInstruction::getDsm() const
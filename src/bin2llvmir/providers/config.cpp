@@ -620,6 +620,16 @@ llvm::CallInst* Config::isPseudoAsmFunctionCall(llvm::Value* c)
 	return isPseudoAsmFunction(cc->getCalledFunction()) ? cc : nullptr;
 }
 
+void Config::addSelectionDependency(llvm::Function* f)
+{
+	_selectionDependencies.insert(f);
+}
+
+bool Config::isSelectionDependency(llvm::Function* f)
+{
+	return _selectionDependencies.count(f);
+}
+
 /**
  * Get crypto pattern information for address \p addr - fill \p name,
  * \p description, and \p type, if there is a pattern on address.
@@ -732,18 +742,18 @@ void Config::tagFunctionsWithUsedCryptoGlobals()
 //=============================================================================
 //
 
-std::map<llvm::Module*, Config> ConfigProvider::_module2config;
+ModuleDataMap<Config> ConfigProvider::_module2config;
 
 Config* ConfigProvider::addConfig(llvm::Module* m, retdec::config::Config& c)
 {
-	auto p = _module2config.emplace(m, Config::fromConfig(m, c));
-	return &p.first->second;
+	auto config = Config::fromConfig(m, c);
+
+	return _module2config.add(m, std::move(config));
 }
 
 Config* ConfigProvider::getConfig(llvm::Module* m)
 {
-	auto f = _module2config.find(m);
-	return f != _module2config.end() ? &f->second : nullptr;
+	return _module2config.get(m);
 }
 
 bool ConfigProvider::getConfig(llvm::Module* m, Config*& c)
@@ -769,5 +779,13 @@ void ConfigProvider::clear()
 	_module2config.clear();
 }
 
+/**
+ * Clear data associated with the given module @a m.
+ */
+void ConfigProvider::clear(llvm::Module* m)
+{
+	_module2config.clear(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
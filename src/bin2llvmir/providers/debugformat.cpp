@@ -23,7 +23,7 @@ namespace bin2llvmir {
 //=============================================================================
 //
 
-std::map<Module*, DebugFormat> DebugFormatProvider::_module2debug;
+ModuleDataMap<DebugFormat> DebugFormatProvider::_module2debug;
 
 /**
  * Create and add to provider a debug info for the given module @a m, file
@@ -42,16 +42,14 @@ DebugFormat* DebugFormatProvider::addDebugFormat(
 		return nullptr;
 	}
 
-	auto p = _module2debug.emplace(
-			m,
-			DebugFormat(
-					objf,
-					pdbFile,
-					nullptr, // symbol table -- not needed.
-					demangler ? demangler->getDemangler() : nullptr
-			)
+	DebugFormat debug(
+			objf,
+			pdbFile,
+			nullptr, // symbol table -- not needed.
+			demangler ? demangler->getDemangler() : nullptr
 	);
-	return &p.first->second;
+
+	return _module2debug.add(m, std::move(debug));
 }
 
 /**
@@ -61,8 +59,7 @@ DebugFormat* DebugFormatProvider::addDebugFormat(
 DebugFormat* DebugFormatProvider::getDebugFormat(
 		llvm::Module* m)
 {
-	auto f = _module2debug.find(m);
-	return f != _module2debug.end() ? &f->second : nullptr;
+	return _module2debug.get(m);
 }
 
 /**
@@ -87,5 +84,13 @@ void DebugFormatProvider::clear()
 	_module2debug.clear();
 }
 
+/**
+ * Clear data associated with the given module @a m.
+ */
+void DebugFormatProvider::clear(llvm::Module* m)
+{
+	_module2debug.clear(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -118,7 +118,7 @@ std::unique_ptr<Demangler> DemanglerFactory::getBorlandDemangler(
 /******************************************************************/
 /********************** Demangler Provider ************************/
 /******************************************************************/
-std::map<Module *, std::unique_ptr<Demangler>> DemanglerProvider::_module2demangler;
+ModuleDataMap<std::unique_ptr<Demangler>> DemanglerProvider::_module2demangler;
 
 /**
  * Create and add to provider a demangler for the given module @a m
@@ -144,9 +144,7 @@ Demangler *DemanglerProvider::addDemangler(
 		d = DemanglerFactory::getItaniumDemangler(llvmModule, config, typeConfig);
 	}
 
-	auto p = _module2demangler.insert(std::make_pair(llvmModule, std::move(d)));
-
-	return p.first->second.get();
+	return _module2demangler.add(llvmModule, std::move(d));
 }
 
 /**
@@ -155,8 +153,7 @@ Demangler *DemanglerProvider::addDemangler(
  */
 Demangler *DemanglerProvider::getDemangler(llvm::Module *m)
 {
-	auto f = _module2demangler.find(m);
-	return f != _module2demangler.end() ? f->second.get() : nullptr;
+	return _module2demangler.get(m);
 }
 
 /**
@@ -183,5 +180,13 @@ void DemanglerProvider::clear()
 	_module2demangler.clear();
 }
 
+/**
+ * Clear data associated with the given module @a m.
+ */
+void DemanglerProvider::clear(llvm::Module *m)
+{
+	_module2demangler.clear(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
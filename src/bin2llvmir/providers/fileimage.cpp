@@ -625,7 +625,7 @@ bool FileImage::isImportTerminating(
 //=============================================================================
 //
 
-std::map<llvm::Module*, FileImage> FileImageProvider::_module2image;
+ModuleDataMap<FileImage> FileImageProvider::_module2image;
 
 /**
  * Create and add to provider a file image created from file at @a path for
@@ -659,8 +659,7 @@ FileImage* FileImageProvider::addFileImage(
 		llvm::Module* m,
 		FileImage img)
 {
-	auto p = _module2image.emplace(m, std::move(img));
-	return &p.first->second;
+	return _module2image.add(m, std::move(img));
 }
 
 /**
@@ -670,8 +669,7 @@ FileImage* FileImageProvider::addFileImage(
 FileImage* FileImageProvider::getFileImage(
 		llvm::Module* m)
 {
-	auto f = _module2image.find(m);
-	return f != _module2image.end() ? &f->second : nullptr;
+	return _module2image.get(m);
 }
 
 /**
@@ -698,5 +696,13 @@ void FileImageProvider::clear()
 	_module2image.clear();
 }
 
+/**
+ * Clear data associated with the given module @a m.
+ */
+void FileImageProvider::clear(llvm::Module* m)
+{
+	_module2image.clear(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -31,6 +31,10 @@ namespace bin2llvmir {
 //=============================================================================
 //
 
+std::map<Lti::LtiModuleKey, std::shared_ptr<retdec::ctypes::Module>>
+		Lti::_ltiModules;
+std::mutex Lti::_ltiModulesMutex;
+
 Lti::Lti(
 	llvm::Module *m,
 	Config *c,
@@ -42,17 +46,12 @@ Lti::Lti(
 		_typeConfig(typeConfig),
 		_image(objf)
 {
-	_ltiModule = std::make_unique<retdec::ctypes::Module>(
-			std::make_shared<retdec::ctypes::Context>());
-
-	_ltiParser = ctypesparser::JSONCTypesParser(
-			static_cast<unsigned>(c->getConfig().architecture.getBitSize()));
-
+	std::vector<std::string> files;
 	for (auto& l : _config->getConfig().parameters.libraryTypeInfoPaths)
 	{
 		if (retdec::utils::endsWith(l, "cstdlib.json"))
 		{
-			loadLtiFile(l);
+			files.push_back(l);
 		}
 	}
 
@@ -68,12 +67,12 @@ Lti::Lti(
 		if (retdec::utils::endsWith(l, "windows.json")
 				&& _config->getConfig().fileFormat.isPe())
 		{
-			loadLtiFile(l);
+			files.push_back(l);
 		}
 		else if (winDriver
 				&& retdec::utils::endsWith(l, "windrivers.json"))
 		{
-			loadLtiFile(l);
+			files.push_back(l);
 		}
 		else if (retdec::utils::endsWith(l, "linux.json")
 				&& (_config->getConfig().fileFormat.isElf()
@@ -81,17 +80,60 @@ Lti::Lti(
 				|| _config->getConfig().fileFormat.isIntelHex()
 				|| _config->getConfig().fileFormat.isRaw()))
 		{
-			loadLtiFile(l);
+			files.push_back(l);
 		}
 		else if (retdec::utils::endsWith(l, "arm.json") &&
 				_config->getConfig().architecture.isArm32OrThumb())
 		{
-			loadLtiFile(l);
+			files.push_back(l);
 		}
 	}
+
+	_ltiModule = getLtiModule(LtiModuleKey(
+			static_cast<unsigned>(c->getConfig().architecture.getBitSize()),
+			_typeConfig->typeWidths(),
+			files));
+}
+
+/**
+ * Get LTI module parsed from the files in the given @a key.
+ *
+ * Parsing of LTI files is expensive and their content does not change, so
+ * the parsed modules are cached and shared by all the decompilations in the
+ * process (e.g. by all the jobs in the decompiler's batch mode).
+ */
+std::shared_ptr<retdec::ctypes::Module> Lti::getLtiModule(
+		const LtiModuleKey& key)
+{
+	{
+		std::lock_guard<std::mutex> lock(_ltiModulesMutex);
+		auto f = _ltiModules.find(key);
+		if (f != _ltiModules.end())
+		{
+			return f->second;
+		}
+	}
+
+	auto module = std::make_unique<retdec::ctypes::Module>(
+			std::make_shared<retdec::ctypes::Context>());
+	ctypesparser::JSONCTypesParser parser(std::get<0>(key));
+	for (auto& f : std::get<2>(key))
+	{
+		loadLtiFile(f, parser, module, std::get<1>(key));
+	}
+
+	// If some other thread parsed the same files in the meantime, its
+	// module is used and ours is thrown away.
+	std::lock_guard<std::mutex> lock(_ltiModulesMutex);
+	auto p = _ltiModules.emplace(key, std::move(module));
+	return p.first->second;
 }
 
-void Lti::loadLtiFile(const std::string& filePath)
+void Lti::loadLtiFile(
+		const std::string& filePath,
+		ctypesparser::JSONCTypesParser& parser,
+		std::unique_ptr<retdec::ctypes::Module>& module,
+		const ctypesparser::TypeConfig::TypeWidths& typeWidths)
 {
 	std::ifstream file(filePath);
 	if (file)
@@ -101,10 +143,20 @@ void Lti::loadLtiFile(const std::string& filePath)
 		{
 			cc = "stdcall";
 		}
-		_ltiParser.parseInto(file, _ltiModule, _typeConfig->typeWidths(), cc);
+		parser.parseInto(file, module, typeWidths, cc);
 	}
 }
 
+/**
+ * Drop all the cached LTI modules. Modules still used by existing LTI
+ * instances are released together with these instances.
+ */
+void Lti::clearCache()
+{
+	std::lock_guard<std::mutex> lock(_ltiModulesMutex);
+	_ltiModules.clear();
+}
+
 bool Lti::hasLtiFunction(const std::string& name)
 {
 	return getLtiFunction(name) != nullptr;
@@ -234,7 +286,7 @@ llvm::Type* Lti::getLlvmType(std::shared_ptr<retdec::ctypes::Type> type)
 //=============================================================================
 //
 
-std::map<llvm::Module*, Lti> LtiProvider::_module2lti;
+ModuleDataMap<Lti> LtiProvider::_module2lti;
 
 Lti* LtiProvider::addLti(
 	llvm::Module *m,
@@ -247,14 +299,14 @@ Lti* LtiProvider::addLti(
 		return nullptr;
 	}
 
-	auto p = _module2lti.emplace(m, Lti(m, c, typeConfig, objf));
-	return &p.first->second;
+	Lti lti(m, c, typeConfig, objf);
+
+	return _module2lti.add(m, std::move(lti));
 }
 
 Lti* LtiProvider::getLti(llvm::Module* m)
 {
-	auto f = _module2lti.find(m);
-	return f != _module2lti.end() ? &f->second : nullptr;
+	return _module2lti.get(m);
 }
 
 bool LtiProvider::getLti(llvm::Module* m, Lti*& lti)
@@ -268,5 +320,13 @@ void LtiProvider::clear()
 	_module2lti.clear();
 }
 
+/**
+ * Clear data associated with the given module @a m.
+ */
+void LtiProvider::clear(llvm::Module* m)
+{
+	_module2lti.clear(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
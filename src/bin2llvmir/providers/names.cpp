@@ -544,7 +544,7 @@ bool NameContainer::loadImportOrds(const std::string& libName)
 //==============================================================================
 //
 
-std::map<llvm::Module*, NameContainer> NamesProvider::_module2names;
+ModuleDataMap<NameContainer> NamesProvider::_module2names;
 
 NameContainer* NamesProvider::addNames(
 		llvm::Module* m,
@@ -563,14 +563,14 @@ NameContainer* NamesProvider::addNames(
 		return nullptr;
 	}
 
-	auto p = _module2names.emplace(m, NameContainer(m, c, d, i, dm, lti));
-	return &p.first->second;
+	NameContainer names(m, c, d, i, dm, lti);
+
+	return _module2names.add(m, std::move(names));
 }
 
 NameContainer* NamesProvider::getNames(llvm::Module* m)
 {
-	auto f = _module2names.find(m);
-	return f != _module2names.end() ? &f->second : nullptr;
+	return _module2names.get(m);
 }
 
 bool NamesProvider::getNames(llvm::Module* m, NameContainer*& names)
@@ -584,5 +584,13 @@ void NamesProvider::clear()
 	_module2names.clear();
 }
 
+/**
+ * Clear data associated with the given module @a m.
+ */
+void NamesProvider::clear(llvm::Module* m)
+{
+	_module2names.clear(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
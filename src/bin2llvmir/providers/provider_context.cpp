@@ -0,0 +1,100 @@
+/**
+ * @file src/bin2llvmir/providers/provider_context.cpp
+ * @brief Access to the provider data of one decompilation.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#include "retdec/bin2llvmir/optimizations/simple_types/simple_types.h"
+#include "retdec/bin2llvmir/providers/abi/abi.h"
+#include "retdec/bin2llvmir/providers/asm_instruction.h"
+#include "retdec/bin2llvmir/providers/config.h"
+#include "retdec/bin2llvmir/providers/debugformat.h"
+#include "retdec/bin2llvmir/providers/demangler.h"
+#include "retdec/bin2llvmir/providers/fileimage.h"
+#include "retdec/bin2llvmir/providers/lti.h"
+#include "retdec/bin2llvmir/providers/names.h"
+#include "retdec/bin2llvmir/providers/provider_context.h"
+
+namespace retdec {
+namespace bin2llvmir {
+
+ProviderContext::ProviderContext(llvm::Module* m) :
+		_module(m)
+{
+
+}
+
+ProviderContext::~ProviderContext()
+{
+	clear();
+}
+
+llvm::Module* ProviderContext::getModule() const
+{
+	return _module;
+}
+
+Config* ProviderContext::getConfig() const
+{
+	return ConfigProvider::getConfig(_module);
+}
+
+FileImage* ProviderContext::getFileImage() const
+{
+	return FileImageProvider::getFileImage(_module);
+}
+
+Abi* ProviderContext::getAbi() const
+{
+	return AbiProvider::getAbi(_module);
+}
+
+Demangler* ProviderContext::getDemangler() const
+{
+	return DemanglerProvider::getDemangler(_module);
+}
+
+DebugFormat* ProviderContext::getDebugFormat() const
+{
+	return DebugFormatProvider::getDebugFormat(_module);
+}
+
+Lti* ProviderContext::getLti() const
+{
+	return LtiProvider::getLti(_module);
+}
+
+NameContainer* ProviderContext::getNames() const
+{
+	return NamesProvider::getNames(_module);
+}
+
+/**
+ * Release all the provider data associated with the context's module.
+ */
+void ProviderContext::clear()
+{
+	clear(_module);
+}
+
+/**
+ * Release all the provider data associated with the module @a m.
+ * Providers are released in the reverse order of their creation, because
+ * the later ones may reference the former ones. Per-module state of passes
+ * is released too, in case the decompilation did not finish.
+ */
+void ProviderContext::clear(llvm::Module* m)
+{
+	SimpleTypesAnalysis::clear(m);
+	NamesProvider::clear(m);
+	LtiProvider::clear(m);
+	DebugFormatProvider::clear(m);
+	DemanglerProvider::clear(m);
+	AbiProvider::clear(m);
+	FileImageProvider::clear(m);
+	ConfigProvider::clear(m);
+	AsmInstruction::clear(m);
+}
+
+} // namespace bin2llvmir
+} // namespace retdec
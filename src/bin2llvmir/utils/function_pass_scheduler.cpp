@@ -0,0 +1,40 @@
+/**
+ * @file src/bin2llvmir/utils/function_pass_scheduler.cpp
+ * @brief Runs function-local work of module passes on multiple threads.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#include "retdec/bin2llvmir/providers/config.h"
+#include "retdec/bin2llvmir/utils/function_pass_scheduler.h"
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Use the number of jobs from the module's config, or a single job if there
+ * is no config.
+ */
+FunctionPassScheduler::FunctionPassScheduler(llvm::Module* m) :
+		_module(m)
+{
+	if (auto* c = ConfigProvider::getConfig(m))
+	{
+		_jobs = retdec::utils::getNumberOfJobs(
+				c->getConfig().parameters.getJobs());
+	}
+}
+
+FunctionPassScheduler::FunctionPassScheduler(llvm::Module* m, unsigned jobs) :
+		_module(m),
+		_jobs(std::max(jobs, 1u))
+{
+
+}
+
+unsigned FunctionPassScheduler::getJobs() const
+{
+	return _jobs;
+}
+
+} // namespace bin2llvmir
+} // namespace retdec
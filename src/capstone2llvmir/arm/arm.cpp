@@ -64,9 +64,12 @@ void Capstone2LlvmIrTranslatorArm_impl::generateDataLayout()
 
 void Capstone2LlvmIrTranslatorArm_impl::generateRegisters()
 {
-	for (auto& p : _reg2type)
+	for (uint32_t r = 0; r < _reg2typeTable.size(); ++r)
 	{
-		createRegister(p.first, _regLt);
+		if (_reg2typeTable[r])
+		{
+			createRegister(r, _regLt);
+		}
 	}
 }
 
@@ -84,11 +87,9 @@ void Capstone2LlvmIrTranslatorArm_impl::translateInstruction(
 	cs_detail* d = i->detail;
 	cs_arm* ai = &d->arm;
 
-	auto fIt = _i2fm.find(i->id);
-	if (fIt != _i2fm.end() && fIt->second != nullptr)
+	auto f = getFromDispatchTable(_i2ft, i->id);
+	if (f != nullptr)
 	{
-		auto f = fIt->second;
-
 		bool branchInsn = i->id == ARM_INS_B || i->id == ARM_INS_BX
 				|| i->id == ARM_INS_BL || i->id == ARM_INS_BLX
 				|| i->id == ARM_INS_CBZ || i->id == ARM_INS_CBNZ;
@@ -129,6 +129,8 @@ class Capstone2LlvmIrTranslatorArm_impl :
 					cs_insn* i,
 					cs_arm*,
 					llvm::IRBuilder<>&)> _i2fm;
+		/// @c _i2fm indexed by Capstone instruction IDs.
+		static const std::vector<decltype(_i2fm)::mapped_type> _i2ft;
 //
 //==============================================================================
 // ARM instruction translation methods.
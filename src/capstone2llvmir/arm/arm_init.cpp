@@ -823,5 +823,8 @@ Capstone2LlvmIrTranslatorArm_impl::_i2fm =
 		{ARM_INS_ENDING, nullptr},
 };
 
+const std::vector<decltype(Capstone2LlvmIrTranslatorArm_impl::_i2fm)::mapped_type>
+Capstone2LlvmIrTranslatorArm_impl::_i2ft = createDispatchTable(_i2fm);
+
 } // namespace capstone2llvmir
 } // namespace retdec
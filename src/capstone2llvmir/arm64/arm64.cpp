@@ -307,7 +307,7 @@ void Capstone2LlvmIrTranslatorArm64_impl::generateRegisters()
 	createRegister(ARM64_REG_SP, _regLt);
 
 	// Create system & flag registers in this loop
-	for (const auto& r : _reg2name)
+	for (const auto& r : _archDesc->reg2name)
 	{
 		createRegister(r.first, _regLt);
 	}
@@ -330,11 +330,9 @@ void Capstone2LlvmIrTranslatorArm64_impl::translateInstruction(
 
 	//std::cout << i->mnemonic << " " << i->op_str << std::endl;
 
-	auto fIt = _i2fm.find(i->id);
-	if (fIt != _i2fm.end() && fIt->second != nullptr)
+	auto f = getFromDispatchTable(_i2ft, i->id);
+	if (f != nullptr)
 	{
-		auto f = fIt->second;
-
 		(this->*f)(i, ai, irb);
 	}
 	else
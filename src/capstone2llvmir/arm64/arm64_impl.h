@@ -193,6 +193,8 @@ class Capstone2LlvmIrTranslatorArm64_impl :
 		static std::map<
 			std::size_t,
 			_translator_fnc> _i2fm;
+		/// @c _i2fm indexed by Capstone instruction IDs.
+		static const std::vector<decltype(_i2fm)::mapped_type> _i2ft;
 //
 //==============================================================================
 // ARM64 instruction translation methods.
@@ -2089,5 +2089,8 @@ Capstone2LlvmIrTranslatorArm64_impl::_i2fm =
 	{ARM64_INS_ENDING, nullptr}
 };
 
+const std::vector<decltype(Capstone2LlvmIrTranslatorArm64_impl::_i2fm)::mapped_type>
+Capstone2LlvmIrTranslatorArm64_impl::_i2ft = createDispatchTable(_i2fm);
+
 } // namespace capstone2llvmir
 } // namespace retdec
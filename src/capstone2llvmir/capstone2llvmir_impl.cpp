@@ -6,6 +6,8 @@
  */
 
 #include <iomanip>
+#include <mutex>
+#include <tuple>
 
 #include "capstone2llvmir/capstone2llvmir_impl.h"
 
@@ -58,6 +60,12 @@ void Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::setGeneratePseudoAsmFunctio
 	_generatePseudoAsmFunctions = f;
 }
 
+template <typename CInsn, typename CInsnOp>
+void Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::setInsnArena(InsnArena* arena)
+{
+	_insnArena = arena;
+}
+
 template <typename CInsn, typename CInsnOp>
 bool Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::isIgnoreUnexpectedOperands() const
 {
@@ -76,6 +84,12 @@ bool Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::isGeneratePseudoAsmFunction
 	return _generatePseudoAsmFunctions;
 }
 
+template <typename CInsn, typename CInsnOp>
+InsnArena* Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::getInsnArena() const
+{
+	return _insnArena;
+}
+
 //
 //==============================================================================
 // Mode query & modification methods - from Capstone2LlvmIrTranslator.
@@ -173,7 +187,7 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translate(
 	TranslationResult res;
 
 	// We want to keep all Capstone instructions -> alloc a new one each time.
-	cs_insn* insn = cs_malloc(_handle);
+	cs_insn* insn = allocateInsn();
 
 	uint64_t address = a;
 
@@ -211,7 +225,7 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translate(
 			return res;
 		}
 
-		insn = cs_malloc(_handle);
+		insn = allocateInsn();
 
 		// TODO: hack, solve better.
 		disasmRes = cs_disasm_iter(_handle, &bytes, &size, &address, insn);
@@ -223,7 +237,7 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translate(
 		}
 	}
 
-	cs_free(insn, 1);
+	freeInsn(insn);
 
 	return res;
 }
@@ -239,11 +253,9 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateOne(
 	TranslationResultOne res;
 
 	// We want to keep all Capstone instructions -> alloc a new one each time.
-	cs_insn* insn = cs_malloc(_handle);
+	cs_insn* insn = allocateInsn();
 
 	uint64_t address = a;
-	_branchGenerated = nullptr;
-	_inCondition = false;
 
 	// TODO: hack, solve better.
 	bool disasmRes = cs_disasm_iter(_handle, &bytes, &size, &address, insn);
@@ -256,25 +268,67 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateOne(
 
 	if (disasmRes)
 	{
-		auto* a2l = generateSpecialAsm2LlvmInstr(irb, insn);
-		translateInstruction(insn, irb);
-
-		res.llvmInsn = a2l;
-		res.capstoneInsn = insn;
-		res.size = insn->size;
-		res.branchCall = _branchGenerated;
-		res.inCondition = _inCondition;
-
+		res = translateOneDecoded(insn, irb);
 		a = address;
 	}
 	else
 	{
-		cs_free(insn, 1);
+		_branchGenerated = nullptr;
+		_inCondition = false;
+		freeInsn(insn);
 	}
 
 	return res;
 }
 
+template <typename CInsn, typename CInsnOp>
+typename Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::TranslationResultOne
+Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateOneDecoded(
+		cs_insn* insn,
+		llvm::IRBuilder<>& irb)
+{
+	TranslationResultOne res;
+
+	_branchGenerated = nullptr;
+	_inCondition = false;
+
+	auto* a2l = generateSpecialAsm2LlvmInstr(irb, insn);
+	translateInstruction(insn, irb);
+
+	res.llvmInsn = a2l;
+	res.capstoneInsn = insn;
+	res.size = insn->size;
+	res.branchCall = _branchGenerated;
+	res.inCondition = _inCondition;
+
+	return res;
+}
+
+/**
+ * Allocate a new Capstone instruction -- from the arena if it is set.
+ */
+template <typename CInsn, typename CInsnOp>
+cs_insn* Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::allocateInsn()
+{
+	return _insnArena ? _insnArena->allocate() : cs_malloc(_handle);
+}
+
+/**
+ * Free the Capstone instruction @a insn allocated by @c allocateInsn().
+ */
+template <typename CInsn, typename CInsnOp>
+void Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::freeInsn(cs_insn* insn)
+{
+	if (_insnArena)
+	{
+		_insnArena->deallocate(insn);
+	}
+	else
+	{
+		cs_free(insn, 1);
+	}
+}
+
 //
 //==============================================================================
 // Capstone related getters - from Capstone2LlvmIrTranslator.
@@ -332,15 +386,14 @@ std::size_t Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::getDelaySlot(uint32_
 template <typename CInsn, typename CInsnOp>
 llvm::GlobalVariable* Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::getRegister(uint32_t r)
 {
-	auto fIt = _capstone2LlvmRegs.find(r);
-	return fIt != _capstone2LlvmRegs.end() ? fIt->second : nullptr;
+	return r < _capstone2LlvmRegs.size() ? _capstone2LlvmRegs[r] : nullptr;
 }
 
 template <typename CInsn, typename CInsnOp>
 std::string Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::getRegisterName(uint32_t r) const
 {
-	auto fIt = _reg2name.find(r);
-	if (fIt == _reg2name.end())
+	auto fIt = _archDesc->reg2name.find(r);
+	if (fIt == _archDesc->reg2name.end())
 	{
 		if (auto* n = cs_reg_name(_handle, r))
 		{
@@ -404,20 +457,20 @@ template <typename CInsn, typename CInsnOp>
 llvm::Type* Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::getRegisterType(
 		uint32_t r) const
 {
-	auto fIt = _reg2type.find(r);
-	if (fIt == _reg2type.end())
+	auto* t = r < _reg2typeTable.size() ? _reg2typeTable[r] : nullptr;
+	if (t == nullptr)
 	{
 		throw GenericError(
 				"Missing type for register number: " + std::to_string(r));
 	}
-	return fIt->second;
+	return t;
 }
 
 template <typename CInsn, typename CInsnOp>
 bool Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::isControlFlowInstruction(
 		cs_insn& i) const
 {
-	return _controlFlowInsnIds.count(i.id)
+	return isInsnOfKind(i.id, INSN_KIND_CONTROL_FLOW)
 			|| isCallInstruction(i)
 			|| isReturnInstruction(i)
 			|| isBranchInstruction(i)
@@ -428,28 +481,37 @@ template <typename CInsn, typename CInsnOp>
 bool Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::isCallInstruction(
 		cs_insn& i) const
 {
-	return _callInsnIds.count(i.id);
+	return isInsnOfKind(i.id, INSN_KIND_CALL);
 }
 
 template <typename CInsn, typename CInsnOp>
 bool Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::isReturnInstruction(
 		cs_insn& i) const
 {
-	return _returnInsnIds.count(i.id);
+	return isInsnOfKind(i.id, INSN_KIND_RETURN);
 }
 
 template <typename CInsn, typename CInsnOp>
 bool Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::isBranchInstruction(
 		cs_insn& i) const
 {
-	return _branchInsnIds.count(i.id);
+	return isInsnOfKind(i.id, INSN_KIND_BRANCH);
 }
 
 template <typename CInsn, typename CInsnOp>
 bool Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::isCondBranchInstruction(
 		cs_insn& i) const
 {
-	return _condBranchInsnIds.count(i.id);
+	return isInsnOfKind(i.id, INSN_KIND_COND_BRANCH);
+}
+
+template <typename CInsn, typename CInsnOp>
+bool Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::isInsnOfKind(
+		unsigned int id,
+		eInsnKind kind) const
+{
+	auto& kinds = _archDesc->insnKinds;
+	return id < kinds.size() && (kinds[id] & kind);
 }
 
 //
@@ -705,14 +767,113 @@ void Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::initialize()
 	openHandle(); // Sets both _basicMode and _extraMode.
 	configureHandle();
 
-	initializeRegNameMap();
-	initializeRegTypeMap();
-	initializePseudoCallInstructionIDs();
+	initializeArchDescriptor();
 	initializeArchSpecific();
+	initializeLookupTables();
 
 	generateEnvironment();
 }
 
+/**
+ * Get the architecture descriptor shared by all translators with the same
+ * architecture and modes. If there is none yet, run the initialization
+ * methods and create it. Translators are often created many times (e.g. in
+ * batch decompilation or tests) and the initialization tables are big.
+ */
+template <typename CInsn, typename CInsnOp>
+void Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::initializeArchDescriptor()
+{
+	using Key = std::tuple<cs_arch, cs_mode, cs_mode, cs_mode>;
+	static std::mutex descriptorsMutex;
+	static std::map<Key, std::shared_ptr<const ArchDescriptor>> descriptors;
+
+	std::lock_guard<std::mutex> lock(descriptorsMutex);
+	auto& desc = descriptors[Key(_arch, _origBasicMode, _basicMode, _extraMode)];
+	if (desc == nullptr)
+	{
+		initializeRegNameMap();
+		initializeRegTypeMap();
+		initializePseudoCallInstructionIDs();
+		desc = createArchDescriptor();
+	}
+	_archDesc = desc;
+}
+
+/**
+ * Move the maps and sets filled by the initialization methods into a new
+ * architecture descriptor. Register types are stored without their LLVM
+ * context, and instruction IDs are turned into a table of their kinds.
+ */
+template <typename CInsn, typename CInsnOp>
+std::shared_ptr<const typename Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::ArchDescriptor>
+Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::createArchDescriptor()
+{
+	auto desc = std::make_shared<ArchDescriptor>();
+
+	desc->reg2name = std::move(_reg2name);
+	_reg2name.clear();
+
+	if (!_reg2type.empty())
+	{
+		desc->reg2type.resize(_reg2type.rbegin()->first + 1);
+	}
+	for (const auto& p : _reg2type)
+	{
+		auto& rt = desc->reg2type[p.first];
+		rt.id = p.second->getTypeID();
+		rt.bitWidth = p.second->isIntegerTy()
+				? p.second->getIntegerBitWidth()
+				: 0;
+	}
+	_reg2type.clear();
+
+	auto addKind = [&desc](std::set<unsigned int>& ids, eInsnKind kind)
+	{
+		auto& kinds = desc->insnKinds;
+		if (!ids.empty() && *ids.rbegin() >= kinds.size())
+		{
+			kinds.resize(*ids.rbegin() + 1, 0);
+		}
+		for (auto id : ids)
+		{
+			kinds[id] |= kind;
+		}
+		ids.clear();
+	};
+	addKind(_callInsnIds, INSN_KIND_CALL);
+	addKind(_returnInsnIds, INSN_KIND_RETURN);
+	addKind(_branchInsnIds, INSN_KIND_BRANCH);
+	addKind(_condBranchInsnIds, INSN_KIND_COND_BRANCH);
+	addKind(_controlFlowInsnIds, INSN_KIND_CONTROL_FLOW);
+
+	return desc;
+}
+
+/**
+ * Create register types from the architecture descriptor in the context of
+ * the translated module. They are queried for every translated instruction.
+ */
+template <typename CInsn, typename CInsnOp>
+void Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::initializeLookupTables()
+{
+	auto& ctx = _module->getContext();
+	auto& regTypes = _archDesc->reg2type;
+
+	_reg2typeTable.assign(regTypes.size(), nullptr);
+	for (std::size_t r = 0; r < regTypes.size(); ++r)
+	{
+		auto& rt = regTypes[r];
+		if (rt.id == llvm::Type::IntegerTyID)
+		{
+			_reg2typeTable[r] = llvm::IntegerType::get(ctx, rt.bitWidth);
+		}
+		else if (rt.id != llvm::Type::VoidTyID)
+		{
+			_reg2typeTable[r] = llvm::Type::getPrimitiveType(ctx, rt.id);
+		}
+	}
+}
+
 template <typename CInsn, typename CInsnOp>
 void Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::openHandle()
 {
@@ -970,6 +1131,10 @@ llvm::GlobalVariable* Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::createRegi
 	}
 
 	_llvm2CapstoneRegs[gv] = r;
+	if (r >= _capstone2LlvmRegs.size())
+	{
+		_capstone2LlvmRegs.resize(r + 1, nullptr);
+	}
 	_capstone2LlvmRegs[r] = gv;
 
 	return gv;
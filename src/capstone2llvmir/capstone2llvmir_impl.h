@@ -8,6 +8,12 @@
 #ifndef CAPSTONE2LLVMIR_CAPSTONE2LLVMIR_IMPL_H
 #define CAPSTONE2LLVMIR_CAPSTONE2LLVMIR_IMPL_H
 
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
 #include "capstone2llvmir/llvmir_utils.h"
 #include "retdec/capstone2llvmir/capstone2llvmir.h"
 
@@ -45,10 +51,12 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 		virtual void setIgnoreUnexpectedOperands(bool f) override;
 		virtual void setIgnoreUnhandledInstructions(bool f) override;
 		virtual void setGeneratePseudoAsmFunctions(bool f) override;
+		virtual void setInsnArena(InsnArena* arena) override;
 
 		virtual bool isIgnoreUnexpectedOperands() const override;
 		virtual bool isIgnoreUnhandledInstructions() const override;
 		virtual bool isGeneratePseudoAsmFunctions() const override;
+		virtual InsnArena* getInsnArena() const override;
 //
 //==============================================================================
 // Mode query & modification methods - from Capstone2LlvmIrTranslator.
@@ -77,6 +85,13 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 				std::size_t& size,
 				retdec::common::Address& a,
 				llvm::IRBuilder<>& irb) override;
+		virtual TranslationResultOne translateOneDecoded(
+				cs_insn* insn,
+				llvm::IRBuilder<>& irb) override;
+
+	protected:
+		cs_insn* allocateInsn();
+		void freeInsn(cs_insn* insn);
 //
 //==============================================================================
 // Capstone related getters - from Capstone2LlvmIrTranslator.
@@ -200,6 +215,43 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 				llvm::IRBuilder<>& irb,
 				llvm::Type* to,
 				eOpConv ct);
+
+		/// Kinds of instructions in @c ArchDescriptor::insnKinds.
+		enum eInsnKind : uint8_t
+		{
+			INSN_KIND_CALL = 1 << 0,
+			INSN_KIND_RETURN = 1 << 1,
+			INSN_KIND_BRANCH = 1 << 2,
+			INSN_KIND_COND_BRANCH = 1 << 3,
+			INSN_KIND_CONTROL_FLOW = 1 << 4,
+		};
+
+		bool isInsnOfKind(unsigned int id, eInsnKind kind) const;
+
+		/**
+		 * Data created by the initialization methods that do not depend on
+		 * the translated module. They depend only on the architecture and
+		 * modes, so all translators with the same ones share a single
+		 * immutable instance created by the first of them.
+		 */
+		struct ArchDescriptor
+		{
+			/// Register type described independently of LLVM contexts.
+			struct RegType
+			{
+				llvm::Type::TypeID id = llvm::Type::VoidTyID;
+				unsigned bitWidth = 0;
+			};
+
+			/// @c _reg2name of the translator that created the descriptor.
+			std::map<uint32_t, std::string> reg2name;
+			/// @c _reg2type indexed by register numbers, unmapped registers
+			/// have @c llvm::Type::VoidTyID.
+			std::vector<RegType> reg2type;
+			/// Kinds of instructions (see @c eInsnKind) indexed by Capstone
+			/// instruction IDs.
+			std::vector<uint8_t> insnKinds;
+		};
 //
 //==============================================================================
 // New implementation-related pure virtual methods.
@@ -275,6 +327,9 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 //
 	protected:
 		virtual void initialize();
+		void initializeArchDescriptor();
+		std::shared_ptr<const ArchDescriptor> createArchDescriptor();
+		void initializeLookupTables();
 		virtual void openHandle();
 		virtual void configureHandle();
 		virtual void closeHandle();
@@ -315,6 +370,36 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 				llvm::GlobalValue::LinkageTypes lt =
 						llvm::GlobalValue::LinkageTypes::InternalLinkage,
 				llvm::Constant* initializer = nullptr);
+
+		/**
+		 * Create a table of translation functions from @a i2fm indexed by
+		 * Capstone instruction IDs. IDs missing in @a i2fm map to @c nullptr.
+		 */
+		template <typename Fnc>
+		static std::vector<Fnc> createDispatchTable(
+				const std::map<std::size_t, Fnc>& i2fm)
+		{
+			std::vector<Fnc> table(
+					i2fm.empty() ? 0 : i2fm.rbegin()->first + 1,
+					nullptr);
+			for (const auto& p : i2fm)
+			{
+				table[p.first] = p.second;
+			}
+			return table;
+		}
+
+		/**
+		 * Get a translation function for instruction ID @a id from @a table
+		 * created by @c createDispatchTable(), or @c nullptr if there is none.
+		 */
+		template <typename Fnc>
+		static Fnc getFromDispatchTable(
+				const std::vector<Fnc>& table,
+				std::size_t id)
+		{
+			return id < table.size() ? table[id] : nullptr;
+		}
 //
 //==============================================================================
 // Load/store methods.
@@ -637,11 +722,21 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 		/// Capstone provides type information for registers, so all registers
 		/// need to be manually mapped here.
 		std::map<uint32_t, llvm::Type*> _reg2type;
+		/// @c _reg2name and @c _reg2type (and also the instruction ID sets
+		/// below) are filled only when @c _archDesc is being created, and
+		/// they are moved into it afterwards. Use @c _archDesc to query them.
+		std::shared_ptr<const ArchDescriptor> _archDesc;
+		/// Register types from @c _archDesc in the context of @c _module,
+		/// unmapped registers are @c nullptr. Created by
+		/// @c initializeLookupTables().
+		std::vector<llvm::Type*> _reg2typeTable;
 
 		/// Maps with all LLVM registers created by the translator.
 		/// Used for bidirectional queries.
-		std::map<llvm::GlobalVariable*, uint32_t> _llvm2CapstoneRegs;
-		std::map<uint32_t, llvm::GlobalVariable*> _capstone2LlvmRegs;
+		std::unordered_map<llvm::GlobalVariable*, uint32_t> _llvm2CapstoneRegs;
+		/// Indexed by register numbers, registers that were not created are
+		/// @c nullptr.
+		std::vector<llvm::GlobalVariable*> _capstone2LlvmRegs;
 
 		/// If the last translated instruction generated branch call, it is
 		/// stored to this member.
@@ -685,6 +780,8 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 		bool _ignoreUnexpectedOperands = true;
 		bool _ignoreUnhandledInstructions = true;
 		bool _generatePseudoAsmFunctions = true;
+
+		InsnArena* _insnArena = nullptr;
 };
 
 //
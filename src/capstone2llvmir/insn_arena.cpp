@@ -0,0 +1,141 @@
+/**
+ * @file src/capstone2llvmir/insn_arena.cpp
+ * @brief Arena allocator of Capstone instructions.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#include <iterator>
+
+#include "retdec/capstone2llvmir/insn_arena.h"
+
+namespace retdec {
+namespace capstone2llvmir {
+
+/**
+ * @param chunkSize Number of instructions allocated from the system at once.
+ */
+InsnArena::InsnArena(std::size_t chunkSize) :
+		_chunkSize(chunkSize ? chunkSize : 1)
+{
+
+}
+
+InsnArena::InsnArena(InsnArena&& other) :
+		_chunks(std::move(other._chunks)),
+		_chunkSize(other._chunkSize),
+		_current(other._current),
+		_used(other._used),
+		_size(other._size)
+{
+	other.clear();
+}
+
+InsnArena& InsnArena::operator=(InsnArena&& other)
+{
+	if (this != &other)
+	{
+		_chunks = std::move(other._chunks);
+		_chunkSize = other._chunkSize;
+		_current = other._current;
+		_used = other._used;
+		_size = other._size;
+		other.clear();
+	}
+	return *this;
+}
+
+/**
+ * Allocate a new instruction whose @c detail points to a detail record
+ * owned by the arena. The instruction can be directly filled by
+ * @c cs_disasm_iter().
+ */
+cs_insn* InsnArena::allocate()
+{
+	if (_current == nullptr || _used == _chunkSize)
+	{
+		// Records are not initialized, Capstone fills them when decoding.
+		_chunks.emplace_back(new Record[_chunkSize]);
+		_current = _chunks.back().get();
+		_used = 0;
+	}
+
+	Record& r = _current[_used++];
+	r.insn.detail = &r.detail;
+	++_size;
+	return &r.insn;
+}
+
+/**
+ * Allocate a copy of the instruction @a insn, including its detail (if it
+ * has one). The copy is owned by this arena, so it stays valid even when
+ * the owner of @a insn frees it.
+ */
+cs_insn* InsnArena::allocateCopy(const cs_insn& insn)
+{
+	cs_insn* copy = allocate();
+	cs_detail* detail = copy->detail;
+	*copy = insn;
+	copy->detail = detail;
+	if (insn.detail)
+	{
+		*detail = *insn.detail;
+	}
+	return copy;
+}
+
+/**
+ * Return the instruction @a insn to the arena. Only the most recently
+ * allocated instruction can be reused, memory of the other instructions
+ * is released when the arena is cleared.
+ */
+void InsnArena::deallocate(cs_insn* insn)
+{
+	if (insn && _used && insn == &_current[_used - 1].insn)
+	{
+		--_used;
+		--_size;
+	}
+}
+
+/**
+ * Take over all the instructions allocated by the arena @a other.
+ * Pointers to them stay valid, they are freed together with instructions
+ * of this arena. The arena @a other is left empty.
+ */
+void InsnArena::merge(InsnArena&& other)
+{
+	if (this == &other)
+	{
+		return;
+	}
+
+	// Keep the current chunk last, so that deallocate() still works.
+	_chunks.insert(
+			_chunks.begin(),
+			std::make_move_iterator(other._chunks.begin()),
+			std::make_move_iterator(other._chunks.end()));
+	_size += other._size;
+	other.clear();
+}
+
+/**
+ * Free all the instructions allocated by the arena.
+ */
+void InsnArena::clear()
+{
+	_chunks.clear();
+	_current = nullptr;
+	_used = 0;
+	_size = 0;
+}
+
+/**
+ * @return Number of allocated instructions.
+ */
+std::size_t InsnArena::size() const
+{
+	return _size;
+}
+
+} // namespace capstone2llvmir
+} // namespace retdec
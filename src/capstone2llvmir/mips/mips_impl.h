@@ -112,6 +112,8 @@ class Capstone2LlvmIrTranslatorMips_impl :
 					cs_insn* i,
 					cs_mips*,
 					llvm::IRBuilder<>&)> _i2fm;
+		/// @c _i2fm indexed by Capstone instruction IDs.
+		static const std::vector<decltype(_i2fm)::mapped_type> _i2ft;
 //
 //==============================================================================
 // MIPS instruction translation methods.
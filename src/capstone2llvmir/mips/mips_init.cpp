@@ -962,5 +962,8 @@ Capstone2LlvmIrTranslatorMips_impl::_i2fm =
 		{MIPS_INS_ENDING, nullptr},
 };
 
+const std::vector<decltype(Capstone2LlvmIrTranslatorMips_impl::_i2fm)::mapped_type>
+Capstone2LlvmIrTranslatorMips_impl::_i2ft = createDispatchTable(_i2fm);
+
 } // namespace capstone2llvmir
 } // namespace retdec
@@ -88,9 +88,12 @@ void Capstone2LlvmIrTranslatorPowerpc_impl::generateDataLayout()
 
 void Capstone2LlvmIrTranslatorPowerpc_impl::generateRegisters()
 {
-	for (auto& p : _reg2type)
+	for (uint32_t r = 0; r < _reg2typeTable.size(); ++r)
 	{
-		createRegister(p.first, _regLt);
+		if (_reg2typeTable[r])
+		{
+			createRegister(r, _regLt);
+		}
 	}
 }
 
@@ -106,10 +109,9 @@ void Capstone2LlvmIrTranslatorPowerpc_impl::translateInstruction(
 	cs_detail* d = i->detail;
 	cs_ppc* pi = &d->ppc;
 
-	auto fIt = _i2fm.find(i->id);
-	if (fIt != _i2fm.end() && fIt->second != nullptr)
+	auto f = getFromDispatchTable(_i2ft, i->id);
+	if (f != nullptr)
 	{
-		auto f = fIt->second;
 		(this->*f)(i, pi, irb);
 	}
 	else
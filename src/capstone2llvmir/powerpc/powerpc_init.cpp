@@ -16,6 +16,11 @@ namespace capstone2llvmir {
 //
 
 void Capstone2LlvmIrTranslatorPowerpc_impl::initializeArchSpecific()
+{
+	// Nothing.
+}
+
+void Capstone2LlvmIrTranslatorPowerpc_impl::initializeRegNameMap()
 {
 	std::map<uint32_t, std::string> r2n =
 	{
@@ -63,11 +68,6 @@ void Capstone2LlvmIrTranslatorPowerpc_impl::initializeArchSpecific()
 	_reg2name = std::move(r2n);
 }
 
-void Capstone2LlvmIrTranslatorPowerpc_impl::initializeRegNameMap()
-{
-	// Nothing.
-}
-
 void Capstone2LlvmIrTranslatorPowerpc_impl::initializeRegTypeMap()
 {
 	auto* i1 = llvm::IntegerType::getInt1Ty(_module->getContext());
@@ -1854,5 +1854,8 @@ Capstone2LlvmIrTranslatorPowerpc_impl::_i2fm =
 
 };
 
+const std::vector<decltype(Capstone2LlvmIrTranslatorPowerpc_impl::_i2fm)::mapped_type>
+Capstone2LlvmIrTranslatorPowerpc_impl::_i2ft = createDispatchTable(_i2fm);
+
 } // namespace capstone2llvmir
 } // namespace retdec
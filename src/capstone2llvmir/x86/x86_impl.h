@@ -215,6 +215,8 @@ class Capstone2LlvmIrTranslatorX86_impl :
 					cs_insn* i,
 					cs_x86*,
 					llvm::IRBuilder<>&)> _i2fm;
+		/// @c _i2fm indexed by Capstone instruction IDs.
+		static const std::vector<decltype(_i2fm)::mapped_type> _i2ft;
 
 		llvm::Value* top = nullptr;
 		llvm::Value* idx = nullptr;
@@ -1960,5 +1960,8 @@ Capstone2LlvmIrTranslatorX86_impl::_i2fm =
 		{X86_INS_ENDING, nullptr}, // mark the end of the list of insn
 };
 
+const std::vector<decltype(Capstone2LlvmIrTranslatorX86_impl::_i2fm)::mapped_type>
+Capstone2LlvmIrTranslatorX86_impl::_i2ft = createDispatchTable(_i2fm);
+
 } // namespace capstone2llvmir
 } // namespace retdec
@@ -4,6 +4,7 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <chrono>
 #include <iomanip>
 
 #include <keystone/keystone.h>
@@ -108,6 +109,15 @@ class ProgramOptions
 				{
 					outFile = getParamOrDie(argc, argv, i);
 				}
+				else if (c == "-n")
+				{
+					_benchmark = getParamOrDie(argc, argv, i);
+					if (!retdec::utils::strToNum(_benchmark, benchmark)
+							|| benchmark == 0)
+					{
+						printHelpAndDie();
+					}
+				}
 				else if (c == "-h")
 				{
 					printHelpAndDie();
@@ -170,6 +180,7 @@ class ProgramOptions
 			Log::info() << "\t" << "b mode : " << std::hex << basicMode << " (" << _basicMode << ")" << std::endl;
 			Log::info() << "\t" << "e mode : " << std::hex << extraMode << " (" << _extraMode << ")" << std::endl;
 			Log::info() << "\t" << "out    : " << outFile << std::endl;
+			Log::info() << "\t" << "bench  : " << std::dec << benchmark << std::endl;
 			Log::info() << std::endl;
 		}
 
@@ -198,7 +209,10 @@ class ProgramOptions
 				"\t          Possible values: little, big, micro, mclass, v8, v9.\n"
 				"\t          Default value: little.\n"
 				"\t-o out    Output file name where LLVM IR will be generated.\n"
-				"\t          Default value: stdout\n";
+				"\t          Default value: stdout\n"
+				"\t-n count  Benchmark: translate the code count times and print\n"
+				"\t          the number of translated instructions per second\n"
+				"\t          instead of generating LLVM IR.\n";
 
 			exit(0);
 		}
@@ -211,6 +225,7 @@ class ProgramOptions
 		cs_mode basicMode = CS_MODE_32;
 		cs_mode extraMode = CS_MODE_LITTLE_ENDIAN;
 		std::string outFile = "-"; // "-" == stdout for llvm::raw_fd_ostream.
+		std::size_t benchmark = 0; // 0 == no benchmark.
 
 	private:
 		std::string _programName = "capstone2llvmir";
@@ -219,6 +234,7 @@ class ProgramOptions
 		std::string _code;
 		std::string _basicMode;
 		std::string _extraMode;
+		std::string _benchmark;
 		bool _useDefaultBasicMode = true;
 };
 
@@ -379,6 +395,72 @@ void assemble(ProgramOptions& po)
 
 using namespace retdec::capstone2llvmir;
 
+/**
+ * Translate the code @c po.benchmark times and print the translation speed.
+ * Every iteration translates into a new function, which is then removed, so
+ * the module does not grow.
+ */
+int runBenchmark(const ProgramOptions& po)
+{
+	llvm::LLVMContext ctx;
+	llvm::Module module("benchmark", ctx);
+
+	std::size_t insnCount = 0;
+	std::chrono::steady_clock::duration elapsed{};
+	try
+	{
+		auto c2l = Capstone2LlvmIrTranslator::createArch(
+				po.arch,
+				&module,
+				po.basicMode,
+				po.extraMode);
+		InsnArena arena;
+		c2l->setInsnArena(&arena);
+
+		for (std::size_t i = 0; i < po.benchmark; ++i)
+		{
+			auto* f = llvm::Function::Create(
+					llvm::FunctionType::get(llvm::Type::getVoidTy(ctx), false),
+					llvm::GlobalValue::ExternalLinkage,
+					"root",
+					&module);
+			llvm::BasicBlock::Create(module.getContext(), "entry", f);
+			llvm::IRBuilder<> irb(&f->front());
+			irb.SetInsertPoint(irb.CreateRetVoid());
+
+			auto start = std::chrono::steady_clock::now();
+			auto res = c2l->translate(
+					po.code.data(),
+					po.code.size(),
+					po.base,
+					irb);
+			elapsed += std::chrono::steady_clock::now() - start;
+			insnCount += res.count;
+
+			f->eraseFromParent();
+			arena.clear();
+		}
+	}
+	catch (const BaseError& e)
+	{
+		Log::error() << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	double seconds = std::chrono::duration<double>(elapsed).count();
+	Log::info() << std::endl;
+	Log::info() << "Benchmark:" << std::endl;
+	Log::info() << "\t" << "iterations   : " << std::dec << po.benchmark << std::endl;
+	Log::info() << "\t" << "instructions : " << insnCount << std::endl;
+	Log::info() << "\t" << "time [s]     : " << std::fixed
+			<< std::setprecision(6) << seconds << std::endl;
+	Log::info() << "\t" << "insns/s      : " << std::fixed
+			<< std::setprecision(0)
+			<< (seconds > 0.0 ? insnCount / seconds : 0.0) << std::endl;
+
+	return EXIT_SUCCESS;
+}
+
 int main(int argc, char *argv[])
 {
 	ProgramOptions po(argc, argv);
@@ -390,6 +472,11 @@ int main(int argc, char *argv[])
 
 	printVersion();
 
+	if (po.benchmark > 0)
+	{
+		return runBenchmark(po);
+	}
+
 	llvm::LLVMContext ctx;
 	llvm::Module module("test", ctx);
 
@@ -17,6 +17,7 @@ namespace {
 const std::string JSON_verboseOut               = "verboseOut";
 const std::string JSON_keepAllFuncs             = "keepAllFuncs";
 const std::string JSON_selectedDecodeOnly       = "selectedDecodeOnly";
+const std::string JSON_selectedDecodeDepth      = "selectedDecodeDepth";
 const std::string JSON_ordinalNumDir            = "ordinalNumDirectory";
 const std::string JSON_userStaticSigPaths       = "userStaticSignPaths";
 const std::string JSON_staticSigPaths           = "staticSignPaths";
@@ -59,6 +60,9 @@ const std::string JSON_backendNoCompoundOperators = "backendNoCompoundOperators"
 const std::string JSON_backendNoSymbolicNames   = "backendNoSymbolicNames";
 
 const std::string JSON_timeout                  = "timeout";
+const std::string JSON_jobs                     = "jobs";
+const std::string JSON_cacheDir                 = "cacheDir";
+const std::string JSON_cacheMaxSize             = "cacheMaxSize";
 const std::string JSON_maxMemoryLimit           = "maxMemoryLimit";
 const std::string JSON_maxMemoryLimitHalfRam    = "maxMemoryLimitHalfRam";
 
@@ -251,6 +255,26 @@ void Parameters::setTimeout(uint64_t seconds)
 	_timeout = seconds;
 }
 
+void Parameters::setJobs(uint64_t jobs)
+{
+	_jobs = jobs;
+}
+
+void Parameters::setCacheDir(const std::string& dir)
+{
+	_cacheDir = dir;
+}
+
+void Parameters::setCacheMaxSize(uint64_t size)
+{
+	_cacheMaxSize = size;
+}
+
+void Parameters::setSelectedDecodeDepth(uint64_t depth)
+{
+	_selectedDecodeDepth = depth;
+}
+
 void Parameters::setEntryPoint(const retdec::common::Address& a)
 {
 	_entryPoint = a;
@@ -405,6 +429,43 @@ uint64_t Parameters::getTimeout() const
 	return _timeout;
 }
 
+/**
+ * @return Number of threads used by the parallelized parts of
+ * the decompilation. Zero means all hardware threads.
+ */
+uint64_t Parameters::getJobs() const
+{
+	return _jobs;
+}
+
+/**
+ * @return Directory of the persistent cache of decompiled functions.
+ * Empty if the cache is not used.
+ */
+const std::string& Parameters::getCacheDir() const
+{
+	return _cacheDir;
+}
+
+/**
+ * @return Maximal size of the persistent cache of decompiled functions
+ * (in bytes).
+ */
+uint64_t Parameters::getCacheMaxSize() const
+{
+	return _cacheMaxSize;
+}
+
+/**
+ * @return Depth of calls from the selected functions up to which the called
+ * functions are also decoded when only the selected functions are decoded.
+ * Zero means that only the selected functions are decoded.
+ */
+uint64_t Parameters::getSelectedDecodeDepth() const
+{
+	return _selectedDecodeDepth;
+}
+
 retdec::common::Address Parameters::getEntryPoint() const
 {
 	return _entryPoint;
@@ -485,6 +546,7 @@ void Parameters::serialize(Writer& writer) const
 	serdes::serializeBool(writer, JSON_verboseOut, isVerboseOutput());
 	serdes::serializeBool(writer, JSON_keepAllFuncs, isKeepAllFunctions());
 	serdes::serializeBool(writer, JSON_selectedDecodeOnly, isSelectedDecodeOnly());
+	serdes::serializeUint64(writer, JSON_selectedDecodeDepth, getSelectedDecodeDepth());
 	serdes::serializeString(writer, JSON_ordinalNumDir, getOrdinalNumbersDirectory());
 
 	serdes::serializeString(writer, JSON_inputFile, getInputFile());
@@ -515,6 +577,9 @@ void Parameters::serialize(Writer& writer) const
 	serdes::serializeBool(writer, JSON_backendNoSymbolicNames, isBackendNoSymbolicNames());
 
 	serdes::serializeUint64(writer, JSON_timeout, getTimeout());
+	serdes::serializeUint64(writer, JSON_jobs, getJobs());
+	serdes::serializeString(writer, JSON_cacheDir, getCacheDir());
+	serdes::serializeUint64(writer, JSON_cacheMaxSize, getCacheMaxSize());
 	serdes::serializeUint64(writer, JSON_maxMemoryLimit, getMaxMemoryLimit());
 	serdes::serializeBool(writer, JSON_maxMemoryLimitHalfRam, isMaxMemoryLimitHalfRam());
 
@@ -553,6 +618,7 @@ void Parameters::deserialize(const rapidjson::Value& val)
 	setIsVerboseOutput( serdes::deserializeBool(val, JSON_verboseOut, false) );
 	setIsKeepAllFunctions( serdes::deserializeBool(val, JSON_keepAllFuncs) );
 	setIsSelectedDecodeOnly( serdes::deserializeBool(val, JSON_selectedDecodeOnly) );
+	setSelectedDecodeDepth( serdes::deserializeUint64(val, JSON_selectedDecodeDepth, 0) );
 	setOrdinalNumbersDirectory( serdes::deserializeString(val, JSON_ordinalNumDir) );
 
 	setInputFile( serdes::deserializeString(val, JSON_inputFile) );
@@ -583,6 +649,9 @@ void Parameters::deserialize(const rapidjson::Value& val)
 	setIsBackendNoSymbolicNames( serdes::deserializeBool(val, JSON_backendNoSymbolicNames, false) );
 
 	setTimeout( serdes::deserializeUint64(val, JSON_timeout, 0) );
+	setJobs( serdes::deserializeUint64(val, JSON_jobs, 1) );
+	setCacheDir( serdes::deserializeString(val, JSON_cacheDir) );
+	setCacheMaxSize( serdes::deserializeUint64(val, JSON_cacheMaxSize, 1024 * 1024 * 1024) );
 	setMaxMemoryLimit( serdes::deserializeUint64(val, JSON_maxMemoryLimit, 0) );
 	setIsMaxMemoryLimitHalfRam( serdes::deserializeBool(val, JSON_maxMemoryLimitHalfRam, true) );
 
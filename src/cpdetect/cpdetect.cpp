@@ -518,8 +518,10 @@ ReturnCode CompilerDetector::getAllSignatures()
 		}
 	}
 
+	const auto bytes = fileParser.getBytes();
 	yara.analyze(
-			fileParser.getPathToFile(),
+			bytes.data(),
+			bytes.size(),
 			cpParams.searchType != SearchType::EXACT_MATCH
 	);
 	const auto &detected = yara.getDetectedRules();
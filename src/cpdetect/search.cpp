@@ -25,6 +25,8 @@ namespace cpdetect {
 namespace
 {
 
+const char HEX_DIGITS[] = "0123456789ABCDEF";
+
 const std::map<Architecture, std::vector<Search::RelativeJump>> jumpMap =
 {
 	{
@@ -45,13 +47,19 @@ const std::map<Architecture, std::vector<Search::RelativeJump>> jumpMap =
  */
 Search::Search(retdec::fileformat::FileFormat &fileParser)
 		: parser(fileParser)
+		, bytes(fileParser.getLoadedBytes())
 		, averageSlashLen(0)
 {
-	const auto &bytes = parser.getLoadedBytes();
-	bytesToHexString(bytes, nibbles);
-	bytesToString(bytes, plain);
+	// Hexadecimal representation of little endian file is the same as
+	// representation of its bytes, so nibbles can be read directly from bytes.
+	directNibbles = parser.isLittleEndian();
+	if (!directNibbles)
+	{
+		bytesToHexString(bytes.data(), bytes.size(), nibbles);
+	}
+	bytesToString(bytes.data(), bytes.size(), plain);
 	fileLoaded = !bytes.empty();
-	fileSupported = parser.hexToLittle(nibbles)
+	fileSupported = (directNibbles || parser.hexToLittle(nibbles))
 			&& parser.getNumberOfNibblesInByte();
 	jumps = mapGetValueOrDefault(
 			jumpMap,
@@ -145,6 +153,145 @@ std::size_t Search::bytesFromNibbles(std::size_t nNibbles) const
 	return parser.bytesFromNibbles(nNibbles);
 }
 
+/**
+ * Get number of nibbles in hexadecimal representation of file
+ */
+std::size_t Search::getNumberOfNibbles() const
+{
+	return directNibbles ? 2 * bytes.size() : nibbles.length();
+}
+
+/**
+ * Get nibble from hexadecimal representation of file
+ * @param nibbleIndex Index of nibble, it must be less than number of nibbles
+ * @return Nibble as uppercase hexadecimal digit
+ */
+char Search::getNibble(std::size_t nibbleIndex) const
+{
+	if (!directNibbles)
+	{
+		return nibbles[nibbleIndex];
+	}
+
+	const auto byte = bytes[nibbleIndex / 2];
+	return HEX_DIGITS[nibbleIndex % 2 ? byte & 0x0F : byte >> 4];
+}
+
+/**
+ * Check if hexadecimal representation of file has substring @a str on
+ * specified position
+ * @param str Coveted substring
+ * @param nibbleIndex Index of nibble
+ * @return @c true if @a str is on position @a nibbleIndex, @c false otherwise
+ */
+bool Search::hasNibblesOnPosition(
+		const std::string &str,
+		std::size_t nibbleIndex) const
+{
+	const auto numberOfNibbles = getNumberOfNibbles();
+	if (nibbleIndex >= numberOfNibbles
+			|| numberOfNibbles - nibbleIndex < str.length())
+	{
+		return false;
+	}
+
+	for (std::size_t i = 0, e = str.length(); i < e; ++i)
+	{
+		if (str[i] != getNibble(nibbleIndex + i))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Compile signature pattern without slashes for comparison with bytes of file.
+ * Each pattern is compiled only once.
+ * @param signPattern Signature pattern
+ * @return Compiled pattern
+ */
+const Search::CompiledPattern& Search::compilePattern(
+		const std::string &signPattern) const
+{
+	const auto it = compiledPatterns.find(signPattern);
+	if (it != compiledPatterns.end())
+	{
+		return it->second;
+	}
+
+	auto &result = compiledPatterns[signPattern];
+	result.length = signPattern.length();
+
+	for (std::size_t alignment = 0; alignment < 2; ++alignment)
+	{
+		auto &values = result.values[alignment];
+		auto &masks = result.masks[alignment];
+		values.assign((alignment + signPattern.length() + 1) / 2, 0);
+		masks.assign(values.size(), 0);
+
+		for (std::size_t i = 0, e = signPattern.length(); i < e; ++i)
+		{
+			const auto c = signPattern[i];
+			std::uint8_t value = 0;
+			if (c == '-' || c == '?' || c == ';')
+			{
+				continue;
+			}
+			else if (c >= '0' && c <= '9')
+			{
+				value = c - '0';
+			}
+			else if (c >= 'A' && c <= 'F')
+			{
+				value = c - 'A' + 10;
+			}
+			else
+			{
+				result.matchable = false;
+				continue;
+			}
+
+			const auto nibbleIndex = alignment + i;
+			const auto shift = nibbleIndex % 2 ? 0 : 4;
+			values[nibbleIndex / 2] |= value << shift;
+			masks[nibbleIndex / 2] |= 0x0F << shift;
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Check if compiled pattern is present in file on specified position.
+ * Usable only if nibbles are read directly from bytes of file.
+ * @param pattern Compiled pattern
+ * @param nibbleIndex Index of nibble, pattern must not exceed end of file
+ *    when it is placed on this index
+ * @return @c true if pattern is present on position @a nibbleIndex,
+ *    @c false otherwise
+ */
+bool Search::hasPatternOnPosition(
+		const CompiledPattern &pattern,
+		std::size_t nibbleIndex) const
+{
+	const auto alignment = nibbleIndex % 2;
+	const auto &values = pattern.values[alignment];
+	const auto &masks = pattern.masks[alignment];
+	const auto *data = bytes.data() + nibbleIndex / 2;
+
+	for (std::size_t i = 0, e = values.size(); i < e; ++i)
+	{
+		if ((data[i] & masks[i]) != values[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 /**
  * Check if input file was successfully loaded
  * @return @c true if file was successfully loaded, @c false otherwise
@@ -169,6 +316,11 @@ bool Search::isFileSupported() const
  */
 const std::string& Search::getNibbles() const
 {
+	if (directNibbles && nibbles.empty())
+	{
+		bytesToHexString(bytes.data(), bytes.size(), nibbles);
+	}
+
 	return nibbles;
 }
 
@@ -201,9 +353,9 @@ const Search::RelativeJump* Search::getRelativeJump(
 	for (const auto &jump : jumps)
 	{
 		const auto nibblesAfter = nibblesFromBytes(jump.getBytesAfter());
-		if (!hasSubstringOnPosition(nibbles, jump.getSlash(), nibbleOffset)
+		if (!hasNibblesOnPosition(jump.getSlash(), nibbleOffset)
 				|| (nibbleOffset + jump.getSlashNibbleSize() + nibblesAfter - 1
-						>= nibbles.length()))
+						>= getNumberOfNibbles()))
 		{
 			continue;
 		}
@@ -287,6 +439,29 @@ unsigned long long Search::findUnslashedSignature(
 		return 0;
 	}
 
+	if (directNibbles)
+	{
+		const auto &pattern = compilePattern(signPattern);
+		const auto startIndex = nibblesFromBytes(startOffset);
+		const auto stopIndex = std::min(
+				nibblesFromBytes(stopOffset) + 1,
+				getNumberOfNibbles());
+		if (!pattern.matchable || startIndex > stopIndex)
+		{
+			return 0;
+		}
+
+		for (auto i = startIndex; i + pattern.length <= stopIndex; ++i)
+		{
+			if (hasPatternOnPosition(pattern, i))
+			{
+				return countImpNibbles(signPattern);
+			}
+		}
+
+		return 0;
+	}
+
 	const auto startIterator = nibbles.begin() + nibblesFromBytes(startOffset);
 	const auto stopIndex = nibblesFromBytes(stopOffset) + 1;
 	const auto stopIterator = stopIndex < nibbles.size()
@@ -363,7 +538,7 @@ unsigned long long Search::exactComparison(
 {
 	for (std::size_t sigIndex = 0,
 			fileIndex = nibblesFromBytes(fileOffset) + shift,
-			fileLen = nibbles.length()
+			fileLen = getNumberOfNibbles()
 			;
 			fileIndex < fileLen
 			;
@@ -398,7 +573,7 @@ unsigned long long Search::exactComparison(
 					+ moveSize
 					- 1;
 		}
-		else if (signPattern[sigIndex] != nibbles[fileIndex]
+		else if (signPattern[sigIndex] != getNibble(fileIndex)
 				&& signPattern[sigIndex] != '-'
 				&& signPattern[sigIndex] != '?')
 		{
@@ -430,7 +605,7 @@ bool Search::countSimilarity(
 
 	for (std::size_t sigIndex = 0,
 			fileIndex = nibblesFromBytes(fileOffset) + shift,
-			fileLen = nibbles.length()
+			fileLen = getNumberOfNibbles()
 			;
 			fileIndex < fileLen
 			;
@@ -475,7 +650,7 @@ bool Search::countSimilarity(
 			}
 			continue;
 		}
-		else if (signPattern[sigIndex] == nibbles[fileIndex])
+		else if (signPattern[sigIndex] == getNibble(fileIndex))
 		{
 			++result.same;
 		}
@@ -641,7 +816,7 @@ bool Search::createSignature(
 
 	for (std::size_t i = 0,
 			fileIndex = nibblesFromBytes(fileOffset),
-			fileLen = nibbles.length(),
+			fileLen = getNumberOfNibbles(),
 			nibbleSize = nibblesFromBytes(size)
 			;
 			fileIndex < fileLen && i < nibbleSize
@@ -664,7 +839,7 @@ bool Search::createSignature(
 		}
 		else
 		{
-			pattern += nibbles[fileIndex];
+			pattern += getNibble(fileIndex);
 		}
 	}
 
@@ -286,7 +286,7 @@ void CoffFormat::initStructures()
 		loadSymbols();
 		loadRelocations();
 		computeSectionTableHashes();
-		loadStrings();
+		setLazyLoader(LazyPart::Strings, [this]() { loadStrings(); });
 	}
 }
 
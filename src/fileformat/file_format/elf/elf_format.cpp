@@ -1133,7 +1133,7 @@ void ElfFormat::initStructures()
 	loadDynamicSegmentSection();
 
 	computeSectionTableHashes();
-	loadStrings();
+	setLazyLoader(LazyPart::Strings, [this]() { loadStrings(); });
 	loadNotes(); // must be done after sections and segments
 	loadCoreInfo(); // must be done after notes
 }
@@ -14,6 +14,8 @@
 
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/file_io.h"
+#include "retdec/utils/parallel.h"
+#include "retdec/utils/profiler.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/system.h"
 #include "retdec/utils/io/log.h"
@@ -39,6 +41,161 @@ namespace
 {
 
 const std::size_t DefaultMinStringLength = 4;
+/// Sections and segments with fewer bytes in total are searched for strings
+/// on a single thread.
+const std::size_t ParallelStringsMinDataSize = 0x100000;
+
+/**
+ * Get name of lazily loaded part of file used in the profile
+ */
+const char* getLazyPartName(std::size_t part)
+{
+	static const char* names[] =
+	{
+		"load strings",
+		"load certificates",
+		"load PDB info",
+		"load Visual Basic info",
+		"load .NET types"
+	};
+
+	return part < sizeof(names) / sizeof(names[0]) ? names[part] : "load";
+}
+
+/**
+ * Check whether @a c is a printable ASCII character
+ */
+inline bool isPrintableChar(unsigned char c)
+{
+	return c >= 0x20 && c < 0x7f;
+}
+
+/**
+ * Find the first printable ASCII character in @a data
+ * @param data Searched data
+ * @param pos Index where the search starts
+ * @param size Size of @a data
+ * @return Index of the found character or value not less than @a size
+ *    if there is no such character
+ *
+ * Data are checked by whole words, so long runs of zeros and other
+ * non-printable bytes are skipped quickly.
+ */
+std::size_t findPrintableChar(
+		const unsigned char *data,
+		std::size_t pos,
+		std::size_t size)
+{
+	const std::uint64_t ones = 0x0101010101010101ULL;
+	for (; pos + sizeof(std::uint64_t) <= size; pos += sizeof(std::uint64_t))
+	{
+		std::uint64_t word;
+		std::memcpy(&word, data + pos, sizeof(word));
+		// Highest bit of a byte is set if 0x1f < byte < 0x7f.
+		const auto low = word & (ones * 0x7f);
+		const auto inRange = (ones * (0x7f + 0x7f) - low) & ~word
+				& (low + ones * (0x7f - 0x1f)) & (ones * 0x80);
+		if (inRange)
+		{
+			break;
+		}
+	}
+
+	while (pos < size && !isPrintableChar(data[pos]))
+	{
+		++pos;
+	}
+	return pos;
+}
+
+/**
+ * Find strings in section or segment
+ * @param secSeg Searched section or segment
+ * @param type Type of the strings
+ * @param charSize Character size
+ * @param endian Endianness of characters with more than one byte
+ * @param result Into this parameter are appended found strings
+ *
+ * Character is valid if its byte selected by @a endian is printable and
+ * its remaining bytes are zero. Strings of at least @c DefaultMinStringLength
+ * valid characters are stored.
+ */
+void findStrings(
+		const SecSeg *secSeg,
+		StringType type,
+		std::size_t charSize,
+		CharacterEndianness endian,
+		std::vector<String> &result)
+{
+	const auto bytes = secSeg->getBytes();
+	const auto *data = reinterpret_cast<const unsigned char*>(bytes.data());
+	const auto size = bytes.size();
+	if (!data || !charSize || size < charSize)
+	{
+		return;
+	}
+
+	const std::size_t charOffset = endian == CharacterEndianness::Little ? 0 : charSize - 1;
+	auto isValidChar = [&](std::size_t pos)
+	{
+		if (pos + charSize > size || !isPrintableChar(data[pos + charOffset]))
+		{
+			return false;
+		}
+
+		for (std::size_t i = 0; i < charSize; ++i)
+		{
+			if (i != charOffset && data[pos + i])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	const auto secSegOffset = secSeg->getOffset();
+	std::string secSegName;
+	for (std::size_t pos = 0; ; )
+	{
+		const auto printable = findPrintableChar(data, pos + charOffset, size);
+		if (printable >= size)
+		{
+			break;
+		}
+
+		pos = printable - charOffset;
+		if (!isValidChar(pos))
+		{
+			++pos;
+			continue;
+		}
+
+		auto end = pos + charSize;
+		while (isValidChar(end))
+		{
+			end += charSize;
+		}
+
+		if ((end - pos) / charSize >= DefaultMinStringLength)
+		{
+			std::string content;
+			content.reserve((end - pos) / charSize);
+			for (auto i = pos; i < end; i += charSize)
+			{
+				content.push_back(static_cast<char>(data[i + charOffset]));
+			}
+
+			if (secSegName.empty())
+			{
+				secSegName = secSeg->getName();
+			}
+			result.emplace_back(type, secSegOffset + pos, secSegName, std::move(content));
+		}
+
+		pos = end;
+	}
+}
 
 /**
  * Decide whether @a offset is part of region (section or segment) @a newRegion
@@ -119,16 +276,15 @@ bool isAddressFromRegion(const SecSeg *actualRegion, const SecSeg *newRegion, st
  * @param loadFlags Load flags
  */
 FileFormat::FileFormat(const std::string & pathToFile, LoadFlags loadFlags) :
-		auxBuff(nullptr, nullptr),
+		mappedFile(retdec::utils::MappedFile::open(pathToFile)),
+		auxBuff(mappedFile ? mappedFile->data() : nullptr, mappedFile ? mappedFile->size() : 0),
 		auxIStream(&auxBuff),
-		loadedBytes(&bytes),
 		loadFlags(loadFlags),
 		filePath(pathToFile),
-		fileStream(auxFStream),
+		fileStream(auxIStream),
 		_ldrErrInfo()
 {
-	auxFStream.open(filePath, std::ifstream::binary);
-	stateIsValid = auxFStream.is_open();
+	stateIsValid = mappedFile != nullptr;
 	init();
 }
 
@@ -140,7 +296,6 @@ FileFormat::FileFormat(const std::string & pathToFile, LoadFlags loadFlags) :
 FileFormat::FileFormat(std::istream &inputStream, LoadFlags loadFlags) :
 		auxBuff(nullptr, nullptr),
 		auxIStream(&auxBuff),
-		loadedBytes(&bytes),
 		loadFlags(loadFlags),
 		fileStream(inputStream),
 		_ldrErrInfo()
@@ -158,7 +313,6 @@ FileFormat::FileFormat(std::istream &inputStream, LoadFlags loadFlags) :
 FileFormat::FileFormat(const std::uint8_t *data, std::size_t size, LoadFlags loadFlags) :
 		auxBuff(data, size),
 		auxIStream(&auxBuff),
-		loadedBytes(&bytes),
 		loadFlags(loadFlags),
 		fileStream(auxIStream),
 		_ldrErrInfo()
@@ -190,7 +344,18 @@ void FileFormat::init()
 	tlsInfo = nullptr;
 	elfCoreInfo = nullptr;
 	fileFormat = Format::UNDETECTABLE;
-	stateIsValid = readFile(fileStream, bytes) && stateIsValid;
+	// Content of a mapped file is used directly, the stream is read only if
+	// there is no mapping.
+	if (mappedFile)
+	{
+		bytes = llvm::ArrayRef<unsigned char>(mappedFile->data(), mappedFile->size());
+	}
+	else
+	{
+		stateIsValid = readFile(fileStream, ownedBytes) && stateIsValid;
+		bytes = ownedBytes;
+	}
+	loadedBytes = bytes;
 	if (getLoadFlags() & LoadFlags::NO_FILE_HASHES)
 	{
 		crc32.clear();
@@ -199,9 +364,10 @@ void FileFormat::init()
 	}
 	else
 	{
-		crc32 = retdec::fileformat::getCrc32(bytes.data(), bytes.size());
-		md5 = retdec::fileformat::getMd5(bytes.data(), bytes.size());
-		sha256 = retdec::fileformat::getSha256(bytes.data(), bytes.size());
+		auto digests = computeDigests(bytes.data(), bytes.size());
+		crc32 = std::move(digests.crc32);
+		md5 = std::move(digests.md5);
+		sha256 = std::move(digests.sha256);
 	}
 	initStream();
 }
@@ -316,9 +482,10 @@ void FileFormat::computeSectionTableHashes()
 
 	if(!data.empty())
 	{
-		sectionCrc32 = retdec::fileformat::getCrc32(data.data(), data.size());
-		sectionMd5 = retdec::fileformat::getMd5(data.data(), data.size());
-		sectionSha256 = retdec::fileformat::getSha256(data.data(), data.size());
+		auto digests = computeDigests(data.data(), data.size());
+		sectionCrc32 = std::move(digests.crc32);
+		sectionMd5 = std::move(digests.md5);
+		sectionSha256 = std::move(digests.sha256);
 	}
 }
 
@@ -330,7 +497,27 @@ void FileFormat::computeSectionTableHashes()
  */
 void FileFormat::setLoadedBytes(std::vector<unsigned char> *lBytes)
 {
-	loadedBytes = lBytes;
+	loadedBytes = *lBytes;
+}
+
+/**
+ * Append bytes to the content of input file. Content of a memory-mapped file
+ * is copied first, because the mapping is read-only.
+ * @param aBytes Bytes to append
+ */
+void FileFormat::appendBytes(const std::vector<unsigned char> &aBytes)
+{
+	const bool loadedAreBytes = loadedBytes.data() == bytes.data();
+	if(ownedBytes.empty())
+	{
+		ownedBytes.assign(bytes.begin(), bytes.end());
+	}
+	ownedBytes.insert(ownedBytes.end(), aBytes.begin(), aBytes.end());
+	bytes = ownedBytes;
+	if(loadedAreBytes)
+	{
+		loadedBytes = bytes;
+	}
 }
 
 /**
@@ -371,14 +558,48 @@ void FileFormat::initArchitecture(
 
 /**
  * Load strings from data sections
+ *
+ * Sections (or segments) are searched in parallel when there is enough data.
  */
 void FileFormat::loadStrings()
 {
 	if (!(getLoadFlags() & LoadFlags::DETECT_STRINGS))
 		return;
 
-	loadStrings(StringType::Ascii, 1);
-	loadStrings(StringType::Wide, 2);
+	std::vector<const SecSeg*> secSegs;
+	std::size_t dataSize = 0;
+	auto addSecSeg = [&](const SecSeg* secSeg)
+	{
+		if (!secSeg->isSomeData() && !secSeg->isDebug())
+			return;
+
+		secSegs.push_back(secSeg);
+		dataSize += secSeg->getBytes().size();
+	};
+	if (!sections.empty())
+		std::for_each(sections.begin(), sections.end(), addSecSeg);
+	else
+		std::for_each(segments.begin(), segments.end(), addSecSeg);
+
+	const auto endian = isLittleEndian() ? CharacterEndianness::Little : CharacterEndianness::Big;
+	const auto jobs = dataSize < ParallelStringsMinDataSize ? 1u : getHardwareConcurrency();
+	std::vector<std::vector<String>> asciiStrings(secSegs.size()), wideStrings(secSegs.size());
+	parallelFor(secSegs.size(), jobs, [&](std::size_t i)
+	{
+		findStrings(secSegs[i], StringType::Ascii, 1, endian, asciiStrings[i]);
+		findStrings(secSegs[i], StringType::Wide, 2, endian, wideStrings[i]);
+	});
+
+	for (auto* found : {&asciiStrings, &wideStrings})
+	{
+		for (auto& secSegStrings : *found)
+		{
+			strings.insert(
+					strings.end(),
+					std::make_move_iterator(secSegStrings.begin()),
+					std::make_move_iterator(secSegStrings.end()));
+		}
+	}
 
 	// Sort and remove duplicates
 	std::sort(strings.begin(), strings.end());
@@ -418,25 +639,41 @@ void FileFormat::loadStrings(StringType type, std::size_t charSize)
 void FileFormat::loadStrings(StringType type, std::size_t charSize, const SecSeg* secSeg)
 {
 	CharacterEndianness endian = isLittleEndian() ? CharacterEndianness::Little : CharacterEndianness::Big;
+	findStrings(secSeg, type, charSize, endian, strings);
+}
+
+/**
+ * Set loader of part of file which is loaded on first use
+ * @param part Part of file
+ * @param loader Function which loads the part
+ *
+ * Loader must be set during construction of instance, i.e. before the part
+ * is requested for the first time.
+ */
+void FileFormat::setLazyLoader(LazyPart part, std::function<void()> loader)
+{
+	lazyLoaders[static_cast<std::size_t>(part)].load = std::move(loader);
+}
 
-	for (auto begin = secSeg->getBytes().begin(), end = secSeg->getBytes().end(), itr = begin; itr != end;)
+/**
+ * Load part of file if it has not been loaded yet
+ * @param part Part of file
+ *
+ * This method is thread-safe. Loading of every part is measured by
+ * retdec::utils::Profiler.
+ */
+void FileFormat::loadLazily(LazyPart part) const
+{
+	const auto index = static_cast<std::size_t>(part);
+	auto &loader = lazyLoaders[index];
+	std::call_once(loader.loaded, [&]()
 	{
-		if (makeCharacterIterator(itr, begin, end, charSize).pointsToValidCharacter(endian))
+		if (loader.load)
 		{
-			auto stringBeginItr = makeCharacterIterator(itr, begin, end, charSize);
-			auto stringDataEndItr = makeCharacterIterator(end, begin, end, charSize);
-			auto stringEndItr = stringBeginItr + 1;
-			while (stringEndItr != stringDataEndItr && stringEndItr.pointsToValidCharacter(endian))
-				++stringEndItr;
-
-			if (static_cast<std::size_t>(stringEndItr - stringBeginItr) >= DefaultMinStringLength)
-				strings.emplace_back(type, secSeg->getOffset() + (itr - begin), secSeg->getName(), std::string{stringBeginItr, stringEndItr});
-
-			itr = stringEndItr.getUnderlyingIterator();
+			retdec::utils::Profiler::Scope profile(getLazyPartName(index));
+			loader.load();
 		}
-		else
-			++itr;
-	}
+	});
 }
 
 /**
@@ -1060,7 +1297,7 @@ std::size_t FileFormat::getFileLength() const
  */
 std::size_t FileFormat::getLoadedFileLength() const
 {
-	return loadedBytes->size();
+	return loadedBytes.size();
 }
 
 /**
@@ -1194,7 +1431,7 @@ bool FileFormat::getBytes(std::vector<std::uint8_t> &result, unsigned long long
 	numberOfBytes = offset + numberOfBytes > getLoadedFileLength() ? getLoadedFileLength() - offset : numberOfBytes;
 	result.clear();
 	result.reserve(numberOfBytes);
-	std::copy(loadedBytes->begin() + offset, loadedBytes->begin() + offset + numberOfBytes, std::back_inserter(result));
+	std::copy(loadedBytes.begin() + offset, loadedBytes.begin() + offset + numberOfBytes, std::back_inserter(result));
 	return true;
 }
 
@@ -1230,7 +1467,7 @@ bool FileFormat::getEpBytes(std::vector<std::uint8_t> &result, unsigned long lon
  */
 bool FileFormat::getHexBytes(std::string &result, unsigned long long offset, unsigned long long numberOfBytes) const
 {
-	bytesToHexString(*loadedBytes, result, offset, numberOfBytes);
+	bytesToHexString(loadedBytes.data(), loadedBytes.size(), result, offset, numberOfBytes);
 	return offset < getLoadedFileLength();
 }
 
@@ -1281,7 +1518,7 @@ bool FileFormat::getHexBytesFromEnd(std::string &result, unsigned long long numb
  */
 bool FileFormat::getString(std::string &result, unsigned long long offset, unsigned long long numberOfBytes) const
 {
-	bytesToString(*loadedBytes, result, offset, numberOfBytes);
+	bytesToString(loadedBytes.data(), loadedBytes.size(), result, offset, numberOfBytes);
 	return offset < getLoadedFileLength();
 }
 
@@ -1576,6 +1813,7 @@ const RichHeader* FileFormat::getRichHeader() const
  */
 const PdbInfo* FileFormat::getPdbInfo() const
 {
+	loadLazily(LazyPart::PdbInfo);
 	return pdbInfo;
 }
 
@@ -1585,6 +1823,7 @@ const PdbInfo* FileFormat::getPdbInfo() const
  */
 const CertificateTable* FileFormat::getCertificateTable() const
 {
+	loadLazily(LazyPart::Certificates);
 	return certificateTable;
 }
 
@@ -1877,8 +2116,12 @@ const std::vector<DynamicTable*>& FileFormat::getDynamicTables() const
 /**
  * Get content of input file as bytes
  * @return Content of input file as bytes
+ *
+ * Bytes are not copied -- if the input was given as a path, they are a view
+ * of the memory-mapped file. They are valid only during the lifetime of this
+ * instance.
  */
-const std::vector<unsigned char>& FileFormat::getBytes() const
+llvm::ArrayRef<unsigned char> FileFormat::getBytes() const
 {
 	return bytes;
 }
@@ -1887,9 +2130,9 @@ const std::vector<unsigned char>& FileFormat::getBytes() const
  * Get serialized loaded content of input file as bytes
  * @return Serialized content of input file as bytes
  */
-const std::vector<unsigned char>& FileFormat::getLoadedBytes() const
+llvm::ArrayRef<unsigned char> FileFormat::getLoadedBytes() const
 {
-	return *loadedBytes;
+	return loadedBytes;
 }
 
 /**
@@ -1907,7 +2150,7 @@ const unsigned char* FileFormat::getBytesData() const
  */
 const unsigned char* FileFormat::getLoadedBytesData() const
 {
-	return loadedBytes->data();
+	return loadedBytes.data();
 }
 
 /**
@@ -1916,6 +2159,7 @@ const unsigned char* FileFormat::getLoadedBytesData() const
  */
 const std::vector<String>& FileFormat::getStrings() const
 {
+	loadLazily(LazyPart::Strings);
 	return strings;
 }
 
@@ -1966,7 +2210,7 @@ bool FileFormat::getXByte(std::uint64_t address, std::uint64_t x, std::uint64_t
 	const auto secOffset = address - secSeg->getAddress();
 	const auto offset = secSeg->getOffset() + secOffset;
 	return (secOffset + x > secSeg->getLoadedSize() || offset + x > getLoadedFileLength()) ?
-		false : createValueFromBytes(*loadedBytes, res, e, offset, x);
+		false : createValueFromBytes(loadedBytes.data(), loadedBytes.size(), res, e, offset, x);
 }
 
 /**
@@ -2106,7 +2350,7 @@ bool FileFormat::getXByteOffset(std::uint64_t offset, std::uint64_t x, std::uint
 		return true;
 	}
 
-	return createValueFromBytes(*loadedBytes, res, e, offset, x);
+	return createValueFromBytes(loadedBytes.data(), loadedBytes.size(), res, e, offset, x);
 }
 
 /**
@@ -2121,7 +2365,7 @@ bool FileFormat::getXBytesOffset(std::uint64_t offset, std::uint64_t x, std::vec
 	res.clear();
 	if(offset + x <= getLoadedFileLength())
 	{
-		res.assign(loadedBytes->begin() + offset, loadedBytes->begin() + offset + x);
+		res.assign(loadedBytes.begin() + offset, loadedBytes.begin() + offset + x);
 		return res.size() == x;
 	}
 
@@ -57,7 +57,7 @@ void IntelHexFormat::initStructures()
 		fileFormat = Format::INTEL_HEX;
 		initializeSections();
 		computeSectionTableHashes();
-		loadStrings();
+		setLazyLoader(LazyPart::Strings, [this]() { loadStrings(); });
 	}
 }
 
@@ -273,7 +273,7 @@ void MachOFormat::initStructures()
 		}
 		fileFormat = Format::MACHO;
 		loadCommands();
-		loadStrings();
+		setLazyLoader(LazyPart::Strings, [this]() { loadStrings(); });
 		loadImpHash();
 		loadExpHash();
 	}
@@ -24,6 +24,7 @@
 #include "retdec/fileformat/types/certificate_table/certificate_table.h"
 #include "retdec/utils/container.h"
 #include "retdec/utils/conversion.h"
+#include "retdec/utils/profiler.h"
 #include "retdec/utils/scope_exit.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/dynamic_buffer.h"
@@ -612,10 +613,10 @@ void PeFormat::initStructures(const std::string & dllListFile)
 	{
 		try
 		{
-			if(file->loadPeHeaders(bytes) == ERROR_NONE)
+			if(file->loadPeHeaders(PeLib::ByteView(bytes.data(), bytes.size())) == ERROR_NONE)
 				stateIsValid = true;
 
-			file->readCoffSymbolTable(bytes);
+			file->readCoffSymbolTable(PeLib::ByteView(bytes.data(), bytes.size()));
 			file->readImportDirectory();
 			file->readIatDirectory();
 			file->readBoundImportDirectory();
@@ -641,21 +642,37 @@ void PeFormat::initStructures(const std::string & dllListFile)
 
 	if(stateIsValid)
 	{
+		auto load = [this](const char *name, void (PeFormat::*loader)())
+		{
+			retdec::utils::Profiler::Scope profile(name);
+			(this->*loader)();
+		};
+
 		fileFormat = Format::PE;
-		loadRichHeader();
-		loadSections();
-		loadSymbols();
-		loadImports();
-		loadExports();
-		loadPdbInfo();
-		loadResources();
-		loadCertificates();
-		loadTlsInformation();
-		loadDotnetHeaders();
-		loadVisualBasicHeader();
+		load("load rich header", &PeFormat::loadRichHeader);
+		load("load sections", &PeFormat::loadSections);
+		load("load symbols", &PeFormat::loadSymbols);
+		load("load imports", &PeFormat::loadImports);
+		load("load exports", &PeFormat::loadExports);
+		load("load resources", &PeFormat::loadResources);
+		load("load TLS information", &PeFormat::loadTlsInformation);
+		load("load .NET headers", &PeFormat::loadDotnetHeaders);
 		computeSectionTableHashes();
-		loadStrings();
-		scanForAnomalies();
+		load("scan for anomalies", &PeFormat::scanForAnomalies);
+
+		// Debug directory must not be decoded even if PDB info is never
+		// requested, so its ranges are not loaded together with PDB info.
+		for (auto&& addressRange : formatParser->getDebugDirectoryOccupiedAddresses())
+		{
+			nonDecodableRanges.insert(std::move(addressRange));
+		}
+
+		// Expensive parts which are not needed by all users are loaded
+		// on first use.
+		setLazyLoader(LazyPart::PdbInfo, [this]() { loadPdbInfo(); });
+		setLazyLoader(LazyPart::Certificates, [this]() { loadCertificates(); });
+		setLazyLoader(LazyPart::VisualBasicInfo, [this]() { loadVisualBasicHeader(); });
+		setLazyLoader(LazyPart::Strings, [this]() { loadStrings(); });
 	}
 }
 
@@ -766,7 +783,7 @@ void PeFormat::loadRichHeader()
 	}
 
 	std::string plainText;
-	bytesToString(bytes, plainText, getMzHeaderSize(), getPeHeaderOffset() - getMzHeaderSize());
+	bytesToString(bytes.data(), bytes.size(), plainText, getMzHeaderSize(), getPeHeaderOffset() - getMzHeaderSize());
 	auto offset = getRichHeaderOffset(plainText);
 	auto standardOffset = (offset == STANDARD_RICH_HEADER_OFFSET);
 	if(offset >= getPeHeaderOffset())
@@ -859,13 +876,11 @@ void PeFormat::loadRichHeader()
 	auto decrypted_bytes = header.getDecryptedHeaderBytes();
 	richHeader->setBytes(decrypted_bytes);
 
-	auto crc32 = retdec::fileformat::getCrc32(decrypted_bytes.data(), decrypted_bytes.size());
-	auto md5 = retdec::fileformat::getMd5(decrypted_bytes.data(), decrypted_bytes.size());
-	auto sha256 = retdec::fileformat::getSha256(decrypted_bytes.data(), decrypted_bytes.size());
+	auto digests = computeDigests(decrypted_bytes.data(), decrypted_bytes.size());
 
-	richHeader->setCrc32(crc32);
-	richHeader->setMd5(md5);
-	richHeader->setSha256(sha256);
+	richHeader->setCrc32(digests.crc32);
+	richHeader->setMd5(digests.md5);
+	richHeader->setSha256(digests.sha256);
 }
 
 /**
@@ -1624,11 +1639,6 @@ void PeFormat::loadPdbInfo()
 		}
 		break;
 	}
-
-	for (auto&& addressRange : formatParser->getDebugDirectoryOccupiedAddresses())
-	{
-		nonDecodableRanges.insert(std::move(addressRange));
-	}
 }
 
 /**
@@ -2194,7 +2204,7 @@ void PeFormat::loadDotnetHeaders()
 
 	detectModuleVersionId();
 	detectTypeLibId();
-	detectDotnetTypes();
+	setLazyLoader(LazyPart::DotnetTypes, [this]() { detectDotnetTypes(); });
 }
 
 /**
@@ -2985,9 +2995,10 @@ void PeFormat::computeTypeRefHashes()
 		}
 	}
 
-	typeRefHashCrc32 = retdec::fileformat::getCrc32(typeRefHashBytes.data(), typeRefHashBytes.size());
-	typeRefHashMd5 = retdec::fileformat::getMd5(typeRefHashBytes.data(), typeRefHashBytes.size());
-	typeRefHashSha256 = retdec::fileformat::getSha256(typeRefHashBytes.data(), typeRefHashBytes.size());
+	auto digests = computeDigests(typeRefHashBytes.data(), typeRefHashBytes.size());
+	typeRefHashCrc32 = std::move(digests.crc32);
+	typeRefHashMd5 = std::move(digests.md5);
+	typeRefHashSha256 = std::move(digests.sha256);
 }
 
 retdec::utils::Endianness PeFormat::getEndianness() const
@@ -3733,31 +3744,37 @@ const std::string& PeFormat::getTypeLibId() const
 
 const std::vector<std::shared_ptr<DotnetClass>>& PeFormat::getDefinedDotnetClasses() const
 {
+	loadLazily(LazyPart::DotnetTypes);
 	return definedClasses;
 }
 
 const std::vector<std::shared_ptr<DotnetClass>>& PeFormat::getImportedDotnetClasses() const
 {
+	loadLazily(LazyPart::DotnetTypes);
 	return importedClasses;
 }
 
 const std::string& PeFormat::getTypeRefhashCrc32() const
 {
+	loadLazily(LazyPart::DotnetTypes);
 	return typeRefHashCrc32;
 }
 
 const std::string& PeFormat::getTypeRefhashMd5() const
 {
+	loadLazily(LazyPart::DotnetTypes);
 	return typeRefHashMd5;
 }
 
 const std::string& PeFormat::getTypeRefhashSha256() const
 {
+	loadLazily(LazyPart::DotnetTypes);
 	return typeRefHashSha256;
 }
 
 const VisualBasicInfo* PeFormat::getVisualBasicInfo() const
 {
+	loadLazily(LazyPart::VisualBasicInfo);
 	return &visualBasicInfo;
 }
 
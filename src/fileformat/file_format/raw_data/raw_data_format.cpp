@@ -69,7 +69,7 @@ void RawDataFormat::initStructures()
 	section->load(this);
 	sections.push_back(section);
 	computeSectionTableHashes();
-	loadStrings();
+	setLazyLoader(LazyPart::Strings, [this]() { loadStrings(); });
 }
 
 std::size_t RawDataFormat::initSectionTableHashOffsets()
@@ -173,9 +173,10 @@ void ExportTable::computeHashes()
 		}
 	}
 
-	expHashCrc32 = getCrc32(expHashBytes.data(), expHashBytes.size());
-	expHashMd5 = getMd5(expHashBytes.data(), expHashBytes.size());
-	expHashSha256 = getSha256(expHashBytes.data(), expHashBytes.size());
+	auto digests = computeDigests(expHashBytes.data(), expHashBytes.size());
+	expHashCrc32 = std::move(digests.crc32);
+	expHashMd5 = std::move(digests.md5);
+	expHashSha256 = std::move(digests.sha256);
 }
 
 /**
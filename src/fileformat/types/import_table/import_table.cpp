@@ -286,9 +286,10 @@ void ImportTable::computeHashes()
 		const int show_version = 1;
 		impHashTlsh = tlsh.getHash(show_version);
 
-		impHashCrc32 = getCrc32(data, impHashBytes.size());
-		impHashMd5 = getMd5(data, impHashBytes.size());
-		impHashSha256 = getSha256(data, impHashBytes.size());
+		auto digests = computeDigests(data, impHashBytes.size());
+		impHashCrc32 = std::move(digests.crc32);
+		impHashMd5 = std::move(digests.md5);
+		impHashSha256 = std::move(digests.sha256);
 	}
 }
 
@@ -439,9 +439,10 @@ void Resource::load(const FileFormat *rOwner)
 
 	if (!(rOwner->getLoadFlags() & LoadFlags::NO_VERBOSE_HASHES))
 	{
-		crc32 = retdec::fileformat::getCrc32(origBytes, bytes.size());
-		md5 = retdec::fileformat::getMd5(origBytes, bytes.size());
-		sha256 = retdec::fileformat::getSha256(origBytes, bytes.size());
+		auto digests = computeDigests(origBytes, bytes.size());
+		crc32 = std::move(digests.crc32);
+		md5 = std::move(digests.md5);
+		sha256 = std::move(digests.sha256);
 	}
 }
 
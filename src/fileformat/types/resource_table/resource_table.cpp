@@ -8,6 +8,7 @@
 
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/dynamic_buffer.h"
+#include "retdec/utils/profiler.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/alignment.h"
 #include "retdec/fileformat/utils/crypto.h"
@@ -342,6 +343,7 @@ const Resource* ResourceTable::getResourceWithLanguage(std::size_t rId) const
  */
 const std::string& ResourceTable::getResourceIconhashCrc32() const
 {
+	loadIconHashes();
 	return iconHashCrc32;
 }
 
@@ -351,6 +353,7 @@ const std::string& ResourceTable::getResourceIconhashCrc32() const
  */
 const std::string& ResourceTable::getResourceIconhashMd5() const
 {
+	loadIconHashes();
 	return iconHashMd5;
 }
 
@@ -360,6 +363,7 @@ const std::string& ResourceTable::getResourceIconhashMd5() const
  */
 const std::string& ResourceTable::getResourceIconhashSha256() const
 {
+	loadIconHashes();
 	return iconHashSha256;
 }
 
@@ -369,6 +373,7 @@ const std::string& ResourceTable::getResourceIconhashSha256() const
  */
 const std::string& ResourceTable::getResourceIconPerceptualAvgHash() const
 {
+	loadIconHashes();
 	return iconPerceptualAvgHash;
 }
 
@@ -495,27 +500,48 @@ ResourceTable::resourcesIterator ResourceTable::end() const
 }
 
 /**
- * Compute icon hashes - CRC32, MD5, SHA256.
+ * Compute icon hashes - CRC32, MD5, SHA256 and perceptual hash.
+ *
+ * Hashes are computed on first access to them, so users which do not
+ * need them do not pay for decoding of the icon.
  */
 void ResourceTable::computeIconHashes()
 {
-	std::vector<std::uint8_t> iconHashBytes;
+	iconHashesRequested = true;
+}
 
-	auto priorIcon = getIconForIconHash();
-	if(!priorIcon)
+/**
+ * Compute icon hashes if they were requested and not computed yet
+ */
+void ResourceTable::loadIconHashes() const
+{
+	if (!iconHashesRequested)
 	{
 		return;
 	}
 
-	if (!priorIcon->getBytes(iconHashBytes))
+	std::call_once(iconHashesComputed, [this]()
 	{
-		return;
-	}
+		retdec::utils::Profiler::Scope profile("compute icon hashes");
+		std::vector<std::uint8_t> iconHashBytes;
+
+		auto priorIcon = getIconForIconHash();
+		if(!priorIcon)
+		{
+			return;
+		}
+
+		if (!priorIcon->getBytes(iconHashBytes))
+		{
+			return;
+		}
 
-	iconHashCrc32 = getCrc32(iconHashBytes.data(), iconHashBytes.size());
-	iconHashMd5 = getMd5(iconHashBytes.data(), iconHashBytes.size());
-	iconHashSha256 = getSha256(iconHashBytes.data(), iconHashBytes.size());
-	iconPerceptualAvgHash = computePerceptualAvgHash(*priorIcon);
+		auto digests = computeDigests(iconHashBytes.data(), iconHashBytes.size());
+		iconHashCrc32 = std::move(digests.crc32);
+		iconHashMd5 = std::move(digests.md5);
+		iconHashSha256 = std::move(digests.sha256);
+		iconPerceptualAvgHash = computePerceptualAvgHash(*priorIcon);
+	});
 }
 
 /**
@@ -23,13 +23,24 @@ namespace fileformat {
 
 /**
  * Compute all supported hashes
+ *
+ * Entropy is computed in the same pass over the data.
  */
 void SecSeg::computeHashes()
 {
 	const auto *hashData = reinterpret_cast<const unsigned char*>(bytes.data());
-	crc32 = retdec::fileformat::getCrc32(hashData, bytes.size());
-	md5 = retdec::fileformat::getMd5(hashData, bytes.size());
-	sha256 = retdec::fileformat::getSha256(hashData, bytes.size());
+	auto digests = computeDigests(
+			hashData,
+			bytes.size(),
+			DIGEST_CRC32 | DIGEST_MD5 | DIGEST_SHA256 | DIGEST_ENTROPY);
+	crc32 = std::move(digests.crc32);
+	md5 = std::move(digests.md5);
+	sha256 = std::move(digests.sha256);
+	if (loaded && hashData && !bytes.empty())
+	{
+		entropy = digests.entropy;
+		isEntropyValid = true;
+	}
 }
 
 /**
@@ -523,7 +534,8 @@ void SecSeg::setMemory(bool sMemory)
  */
 void SecSeg::computeEntropy()
 {
-	if (!loaded)
+	// Entropy may have been already computed together with hashes.
+	if (!loaded || isEntropyValid)
 	{
 		return;
 	}
@@ -571,6 +583,8 @@ void SecSeg::invalidateEntrySize()
  */
 void SecSeg::load(const FileFormat *sOwner)
 {
+	isEntropyValid = false;
+
 	if(!fileSize || !sOwner || offset >= sOwner->getLoadedFileLength())
 	{
 		bytes = "";
@@ -684,9 +684,10 @@ void VisualBasicInfo::computeExternTableHashes()
 		}
 	}
 
-	externTableHashCrc32 = getCrc32(hashBytes.data(), hashBytes.size());
-	externTableHashMd5 = getMd5(hashBytes.data(), hashBytes.size());
-	externTableHashSha256 = getSha256(hashBytes.data(), hashBytes.size());
+	auto digests = computeDigests(hashBytes.data(), hashBytes.size());
+	externTableHashCrc32 = std::move(digests.crc32);
+	externTableHashMd5 = std::move(digests.md5);
+	externTableHashSha256 = std::move(digests.sha256);
 }
 
 /**
@@ -726,9 +727,10 @@ void VisualBasicInfo::computeObjectTableHashes()
 		}
 	}
 
-	objectTableHashCrc32 = getCrc32(hashBytes.data(), hashBytes.size());
-	objectTableHashMd5 = getMd5(hashBytes.data(), hashBytes.size());
-	objectTableHashSha256 = getSha256(hashBytes.data(), hashBytes.size());
+	auto digests = computeDigests(hashBytes.data(), hashBytes.size());
+	objectTableHashCrc32 = std::move(digests.crc32);
+	objectTableHashMd5 = std::move(digests.md5);
+	objectTableHashSha256 = std::move(digests.sha256);
 }
 
 /**
@@ -4,6 +4,8 @@
  * @copyright (c) 2020 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+#include <array>
 #include <climits>
 #include <cmath>
 #include <vector>
@@ -12,12 +14,21 @@
 #include <openssl/sha.h>
 
 #include "retdec/fileformat/utils/crypto.h"
+#include "retdec/fileformat/utils/other.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/crc32.h"
 
 namespace retdec {
 namespace fileformat {
 
+namespace {
+
+/// Data are digested in blocks of this size, which stay in cache while all
+/// the requested digests are updated.
+const std::uint64_t DIGEST_BLOCK_SIZE = 64 * 1024;
+
+} // anonymous namespace
+
 /**
  * @brief Count CRC32 of @a data.
  * @param[in] data Input data.
@@ -78,5 +89,98 @@ std::string getSha256(const unsigned char *data, std::uint64_t length)
 	return sha;
 }
 
+/**
+ * @brief Compute several digests of @a data in a single pass over it.
+ * @param[in] data Input data.
+ * @param[in] length Length of input data.
+ * @param[in] digests Requested digests (combination of @c Digest values).
+ * @return Requested digests of input data, the same as if they were computed
+ *         by the separate functions (e.g. @c getMd5()).
+ */
+DataDigests computeDigests(
+		const unsigned char *data,
+		std::uint64_t length,
+		unsigned digests)
+{
+	retdec::utils::CRC32 crc;
+	MD5_CTX md5;
+	SHA_CTX sha1;
+	SHA256_CTX sha256;
+	std::array<std::size_t, 256> histogram{};
+
+	if (digests & DIGEST_MD5)
+	{
+		MD5_Init(&md5);
+	}
+	if (digests & DIGEST_SHA1)
+	{
+		SHA1_Init(&sha1);
+	}
+	if (digests & DIGEST_SHA256)
+	{
+		SHA256_Init(&sha256);
+	}
+
+	for (std::uint64_t offset = 0; offset < length; offset += DIGEST_BLOCK_SIZE)
+	{
+		const auto *block = data + offset;
+		const auto blockSize = std::min(DIGEST_BLOCK_SIZE, length - offset);
+
+		if (digests & DIGEST_CRC32)
+		{
+			crc.add(block, blockSize);
+		}
+		if (digests & DIGEST_MD5)
+		{
+			MD5_Update(&md5, block, blockSize);
+		}
+		if (digests & DIGEST_SHA1)
+		{
+			SHA1_Update(&sha1, block, blockSize);
+		}
+		if (digests & DIGEST_SHA256)
+		{
+			SHA256_Update(&sha256, block, blockSize);
+		}
+		if (digests & DIGEST_ENTROPY)
+		{
+			for (std::uint64_t i = 0; i < blockSize; ++i)
+			{
+				histogram[block[i]]++;
+			}
+		}
+	}
+
+	DataDigests result;
+	if (digests & DIGEST_CRC32)
+	{
+		result.crc32 = crc.getHash();
+	}
+	if (digests & DIGEST_MD5)
+	{
+		std::vector<unsigned char> digest(MD5_DIGEST_LENGTH);
+		MD5_Final(digest.data(), &md5);
+		retdec::utils::bytesToHexString(digest, result.md5, 0, 0, false);
+	}
+	if (digests & DIGEST_SHA1)
+	{
+		std::vector<unsigned char> digest(SHA_DIGEST_LENGTH);
+		SHA1_Final(digest.data(), &sha1);
+		retdec::utils::bytesToHexString(digest, result.sha1, 0, 0, false);
+	}
+	if (digests & DIGEST_SHA256)
+	{
+		std::vector<unsigned char> digest(SHA256_DIGEST_LENGTH);
+		SHA256_Final(digest.data(), &sha256);
+		retdec::utils::bytesToHexString(digest, result.sha256, 0, 0, false);
+	}
+	if ((digests & DIGEST_ENTROPY) && data)
+	{
+		result.entropy = computeHistogramEntropy(histogram, length);
+	}
+
+	return result;
+}
+
 } // namespace fileformat
 } // namespace retdec
@@ -489,7 +489,6 @@ std::string codePageToStr(std::size_t cpage)
 double computeDataEntropy(const std::uint8_t *data, std::size_t dataLen)
 {
 	std::array<std::size_t, 256> histogram{};
-	double entropy = 0;
 
 	if (!data)
 	{
@@ -501,6 +500,21 @@ double computeDataEntropy(const std::uint8_t *data, std::size_t dataLen)
 		histogram[data[i]]++;
 	}
 
+	return computeHistogramEntropy(histogram, dataLen);
+}
+
+/**
+ * Compute entropy of data from histogram of its bytes
+ * @param histogram Number of occurrences of each byte value in data
+ * @param dataLen Length of data
+ * @return entropy in <0,8>
+ */
+double computeHistogramEntropy(
+		const std::array<std::size_t, 256> &histogram,
+		std::size_t dataLen)
+{
+	double entropy = 0;
+
 	for (auto frequency : histogram)
 	{
 		if (frequency)
@@ -115,6 +115,15 @@ std::string FileInformation::getAnalysisTime() const
 	return analysisTime;
 }
 
+/**
+ * Get times of loading parts of input file
+ * @return Names of loaded parts with loading times in seconds
+ */
+const std::vector<std::pair<std::string, double>>& FileInformation::getLoadTimes() const
+{
+	return loadTimes;
+}
+
 std::string FileInformation::getTelfhash() const
 {
 	return telfhash;
@@ -3324,6 +3333,16 @@ void FileInformation::setAnalysisTime(const std::string &analysistime)
 	analysisTime = analysistime;
 }
 
+/**
+ * Add time of loading part of input file
+ * @param name Name of loaded part
+ * @param seconds Loading time in seconds
+ */
+void FileInformation::addLoadTime(const std::string &name, double seconds)
+{
+	loadTimes.emplace_back(name, seconds);
+}
+
 void FileInformation::setTelfhash(const std::string &hash)
 {
 	telfhash = hash;
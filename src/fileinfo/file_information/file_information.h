@@ -8,6 +8,9 @@
 #define FILEINFO_FILE_INFORMATION_FILE_INFORMATION_H
 
 #include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "retdec/cpdetect/cpdetect.h"
 #include "fileinfo/file_information/file_information_types/file_information_types.h"
@@ -27,6 +30,7 @@ class FileInformation
 		retdec::cpdetect::ReturnCode status = retdec::cpdetect::ReturnCode::OK;
 		std::string filePath;                          ///< path to input file
 		std::string analysisTime;                      ///< time when the analysis was done
+		std::vector<std::pair<std::string, double>> loadTimes; ///< times of loading parts of input file (in seconds)
 		std::string telfhash;                          ///< telfhash of ELF input file
 		std::string crc32;                             ///< CRC32 of input file
 		std::string md5;                               ///< MD5 of input file
@@ -80,6 +84,7 @@ class FileInformation
 		retdec::cpdetect::ReturnCode getStatus() const;
 		std::string getPathToFile() const;
 		std::string getAnalysisTime() const;
+		const std::vector<std::pair<std::string, double>>& getLoadTimes() const;
 		std::string getTelfhash() const;
 		std::string getCrc32() const;
 		std::string getMd5() const;
@@ -507,6 +512,7 @@ class FileInformation
 		void setStatus(retdec::cpdetect::ReturnCode state);
 		void setPathToFile(const std::string &filepath);
 		void setAnalysisTime(const std::string &analysistime);
+		void addLoadTime(const std::string &name, double seconds);
 		void setTelfhash(const std::string &telfhash);
 		void setCrc32(const std::string &fileCrc32);
 		void setMd5(const std::string &fileMd5);
@@ -1324,6 +1324,22 @@ bool JsonPresentation::present()
 	if(analysisTime)
 	{
 		serializeString(writer, "analysisTime", fileinfo.getAnalysisTime());
+
+		const auto &loadTimes = fileinfo.getLoadTimes();
+		if(!loadTimes.empty())
+		{
+			writer.Key("loadTimes");
+			writer.StartArray();
+			for(const auto &loadTime : loadTimes)
+			{
+				writer.StartObject();
+				serializeString(writer, "name", loadTime.first);
+				writer.Key("time");
+				writer.Double(loadTime.second);
+				writer.EndObject();
+			}
+			writer.EndArray();
+		}
 	}
 
 	serializeString(writer, "inputFile", fileinfo.getPathToFile());
@@ -14,6 +14,8 @@
 #include "fileinfo/file_presentation/getters/format.h"
 #include "fileinfo/file_presentation/getters/plain_getters.h"
 #include "fileinfo/file_presentation/plain_presentation.h"
+#include <iomanip>
+#include <sstream>
 #include <string>
 
 using namespace retdec::utils;
@@ -832,6 +834,17 @@ bool PlainPresentation::present()
 	{
 		Log::info() << "Analysis time            : "
 				<< fileinfo.getAnalysisTime() << "\n";
+		// labels are aligned to the column of the other labels, longer ones
+		// are separated from the colon by a single space
+		const std::size_t labelWidth = 25;
+		for(const auto &loadTime : fileinfo.getLoadTimes())
+		{
+			const std::string label = "Time to " + loadTime.first;
+			const auto padding = label.length() < labelWidth ? labelWidth - label.length() : 1;
+			std::ostringstream seconds;
+			seconds << std::fixed << std::setprecision(6) << loadTime.second;
+			Log::info() << label << std::string(padding, ' ') << ": " << seconds.str() << " s\n";
+		}
 	}
 	Log::info() << "Input file               : " << fileinfo.getPathToFile() << "\n";
 
@@ -12,6 +12,7 @@
 #include "retdec/utils/binary_path.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/memory.h"
+#include "retdec/utils/profiler.h"
 #include "retdec/utils/io/log.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/time.h"
@@ -22,6 +23,7 @@
 #include "retdec/fileformat/utils/format_detection.h"
 #include "retdec/fileformat/utils/other.h"
 #include "retdec/serdes/std.h"
+#include "retdec/yaracpp/yara_rule_cache.h"
 #include "fileinfo/file_detector/detector_factory.h"
 #include "fileinfo/file_detector/macho_detector.h"
 #include "fileinfo/file_presentation/config_presentation.h"
@@ -70,6 +72,8 @@ struct ProgParams
 	std::set<std::string> yaraCryptoPaths;
 	///< paths to YARA other rules
 	std::set<std::string> yaraOtherPaths;
+	///< store compiled YARA text rules next to their sources
+	bool persistCompiledRules = false;
 	std::size_t maxMemory = 0;
 	/// limit maximal memory to half of system RAM
 	bool maxMemoryHalfRAM = false;
@@ -100,6 +104,7 @@ std::ostream& operator<<(std::ostream& os, const ProgParams& pp)
 	os << "ep bytes count     : " << pp.epBytesCount << "\n";
 	os << "load flags         : " << pp.loadFlags << "\n";
 	os << "analysis time      : " << pp.analysisTime << "\n";
+	os << "persist yara rules : " << pp.persistCompiledRules << "\n";
 
 	os << "yara malware rules : " << "\n";
 	for (auto& r : pp.yaraMalwarePaths)
@@ -190,6 +195,10 @@ void printHelp()
 				<< "                          and functions.\n"
 				<< "    --other=fileOrDir, -o=fileOrDir\n"
 				<< "                          Path to other YARA rules.\n"
+				<< "    --persist-compiled-rules\n"
+				<< "                          Store compiled text YARA rules next to their\n"
+				<< "                          sources (as .yarac files) and use them in later\n"
+				<< "                          runs while they are not older than the sources.\n"
 				<< "\n"
 				<< "Options for specifying output format:\n"
 				<< "  From this group, only one option can be used. If no option is used, program\n"
@@ -210,7 +219,8 @@ void printHelp()
 				<< "                          Without this parameter program print only\n"
 				<< "                          basic information.\n"
 				<< "    --explanatory, -X     Print explanatory notes (only in plain text output).\n"
-				<< "    --analysis-time       Print also analysis time into output.\n"
+				<< "    --analysis-time       Print also analysis time and time spent loading\n"
+				<< "                          individual parts of input file into output.\n"
 				<< "\n"
 				<< "Options for specifying configuration file:\n"
 				<< "    --config=file, -c=file\n"
@@ -396,6 +406,7 @@ bool doConfigString(
 	params.explanatory = retdec::serdes::deserializeBool(root, "explanatory", params.explanatory);
 	params.maxMemoryHalfRAM = retdec::serdes::deserializeBool(root, "maxMemoryHalf", params.maxMemoryHalfRAM);
 	params.analysisTime = retdec::serdes::deserializeBool(root, "analysisTime", params.analysisTime);
+	params.persistCompiledRules = retdec::serdes::deserializeBool(root, "persistCompiledYaraRules", params.persistCompiledRules);
 
 	if (root.HasMember("loadStrings"))
 	{
@@ -641,6 +652,10 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 		{
 			params.yaraOtherPaths.insert(getParamOrDie(argv, i));
 		}
+		else if (c == "--persist-compiled-rules")
+		{
+			params.persistCompiledRules = true;
+		}
 		else if (c == "--max-memory")
 		{
 			auto maxMemoryString = getParamOrDie(argv, i);
@@ -760,6 +775,17 @@ int main(int argc, char* argv[])
 
 	limitMaximalMemoryIfRequested(params);
 
+	// Detectors (e.g. cpdetect) load their rules already when they are
+	// created, so this must be set before that.
+	retdec::yaracpp::YaraRuleCache::getInstance().setPersistCompiledRules(
+			params.persistCompiledRules);
+
+	// Loading of individual parts of input file is measured by profiler.
+	if(params.analysisTime)
+	{
+		retdec::utils::Profiler::enable();
+	}
+
 	bool useConfig = true;
 	retdec::config::Config config;
 	if(params.generateConfigFile && !params.configFile.empty())
@@ -841,6 +867,11 @@ int main(int argc, char* argv[])
 		}
 	}
 
+	for(const auto &phase : retdec::utils::Profiler::getPhases())
+	{
+		fileinfo.addLoadTime(phase.name, phase.wallTime);
+	}
+
 	// print results on standard output
 	if(params.plainText)
 	{
@@ -345,7 +345,15 @@ void PatternDetector::analyze()
 			yara.addRuleFile(item);
 		}
 
-		yara.analyze(fileinfo.getPathToFile());
+		if(fileParser)
+		{
+			const auto bytes = fileParser->getBytes();
+			yara.analyze(bytes.data(), bytes.size());
+		}
+		else
+		{
+			yara.analyze(fileinfo.getPathToFile());
+		}
 
 		for(const auto &rule : yara.getDetectedRules())
 		{
@@ -0,0 +1,664 @@
+/**
+* @file src/llvmir2hll/hll/func_output_cache.cpp
+* @brief Implementation of FuncOutputCache.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <llvm/ADT/SCCIterator.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Analysis/CallGraph.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/ModuleSlotTracker.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "retdec/config/config.h"
+#include "retdec/llvmir2hll/hll/func_output_cache.h"
+#include "retdec/llvmir2hll/hll/output_manager.h"
+#include "retdec/llvmir2hll/ir/function.h"
+#include "retdec/llvmir2hll/ir/global_var_def.h"
+#include "retdec/llvmir2hll/ir/module.h"
+#include "retdec/llvmir2hll/ir/variable.h"
+#include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/utils/container.h"
+#include "retdec/utils/version.h"
+
+using retdec::utils::hasItem;
+using retdec::utils::mapGetValueOrDefault;
+
+namespace retdec {
+namespace llvmir2hll {
+
+namespace {
+
+/// The first line of every entry. Change it whenever the format of entries or
+/// the computation of keys changes.
+const std::string ENTRY_HEADER = "retdec-func-output 1";
+
+/// Kinds of tokens whose values are names of global variables or functions.
+const std::set<RecordingOutputManager::TokenKind> NAME_TOKEN_KINDS = {
+	RecordingOutputManager::TokenKind::GlobalVariableId,
+	RecordingOutputManager::TokenKind::FunctionId
+};
+
+/// Marks a token value that is a name of a global variable or a function.
+const char NAME_VALUE = 'n';
+
+/// Marks a token value that is stored as it is.
+const char LITERAL_VALUE = 'l';
+
+/**
+* @brief Returns the MD5 hash of @a data as a hexadecimal string.
+*/
+std::string computeHash(const std::string &data) {
+	llvm::MD5 hash;
+	hash.update(data);
+	llvm::MD5::MD5Result result;
+	hash.final(result);
+	llvm::SmallString<32> str;
+	llvm::MD5::stringifyResult(result, str);
+	return str.str().str();
+}
+
+/**
+* @brief Returns a textual representation of @a address, @c "-" if it is
+*        undefined.
+*/
+std::string addressToString(Address address) {
+	return address.isDefined() ? std::to_string(address.getValue()) : "-";
+}
+
+/**
+* @brief Reverts addressToString().
+*/
+Address stringToAddress(const std::string &str) {
+	return str == "-"
+		? Address()
+		: Address(std::strtoull(str.c_str(), nullptr, 10));
+}
+
+/**
+* @brief Appends @a field to @a out in an unambiguous way.
+*/
+void addField(std::ostream &out, const std::string &field) {
+	out << field.size() << ':' << field << '\n';
+}
+
+/**
+* @brief Removes metadata attachments (like <tt>, !dbg !12</tt>) from the end
+*        of the given textual representation of an instruction.
+*
+* The numbers of metadata nodes depend on the whole module, so they cannot be
+* a part of keys.
+*/
+std::string stripMetadataAttachments(std::string line) {
+	for (;;) {
+		auto pos = line.rfind(", !");
+		if (pos == std::string::npos) {
+			break;
+		}
+
+		// ", !name !N"
+		auto nodePos = line.find(" !", pos + 3);
+		if (nodePos == std::string::npos || nodePos + 2 >= line.size()
+				|| !std::all_of(line.begin() + nodePos + 2, line.end(),
+					[](char c) { return c >= '0' && c <= '9'; })) {
+			break;
+		}
+		line.erase(pos);
+	}
+	return line;
+}
+
+/**
+* @brief Adds global variables and functions referenced from @a c into @a refs.
+*/
+void collectReferencedGlobals(const llvm::Constant *c,
+		std::set<const llvm::GlobalValue *> &refs,
+		std::set<const llvm::Constant *> &visited) {
+	if (!visited.insert(c).second) {
+		return;
+	}
+
+	if (auto gv = llvm::dyn_cast<llvm::GlobalValue>(c)) {
+		refs.insert(gv);
+		auto var = llvm::dyn_cast<llvm::GlobalVariable>(gv);
+		if (var && var->hasInitializer()) {
+			collectReferencedGlobals(var->getInitializer(), refs, visited);
+		}
+		return;
+	}
+
+	for (const auto &op : c->operands()) {
+		if (auto opc = llvm::dyn_cast<llvm::Constant>(op)) {
+			collectReferencedGlobals(opc, refs, visited);
+		}
+	}
+}
+
+/**
+* @brief Returns a textual representation of the given global value, which
+*        may be referenced from a function.
+*
+* For functions, only their signature is returned (their bodies are taken
+* into account by hashing the call graph).
+*/
+std::string getGlobalValueContent(const llvm::GlobalValue &gv) {
+	std::string str;
+	llvm::raw_string_ostream os(str);
+	if (auto f = llvm::dyn_cast<llvm::Function>(&gv)) {
+		os << "@" << f->getName() << " ";
+		f->getFunctionType()->print(os);
+	} else {
+		gv.print(os);
+	}
+	return stripMetadataAttachments(os.str());
+}
+
+/**
+* @brief Returns a textual representation of the LLVM IR of the given function,
+*        including everything it refers to.
+*/
+std::string getLLVMFuncContent(const llvm::Function &f,
+		llvm::ModuleSlotTracker &mst) {
+	std::string str;
+	llvm::raw_string_ostream os(str);
+	os << f.getName() << " ";
+	f.getFunctionType()->print(os);
+	for (const auto &arg : f.args()) {
+		os << " %" << arg.getName();
+	}
+	os << "\n";
+	if (f.isDeclaration()) {
+		return os.str();
+	}
+
+	mst.incorporateFunction(f);
+	std::set<const llvm::GlobalValue *> refs;
+	std::set<const llvm::Constant *> visited;
+	for (const auto &bb : f) {
+		bb.printAsOperand(os, false, mst);
+		os << ":\n";
+		for (const auto &i : bb) {
+			std::string line;
+			llvm::raw_string_ostream ls(line);
+			i.print(ls, mst);
+			os << stripMetadataAttachments(ls.str()) << "\n";
+
+			for (const auto &op : i.operands()) {
+				if (auto c = llvm::dyn_cast<llvm::Constant>(op)) {
+					collectReferencedGlobals(c, refs, visited);
+				}
+			}
+		}
+	}
+
+	// Sort the referenced globals so that the content does not depend on the
+	// addresses of the objects in memory.
+	std::vector<std::string> refContents;
+	for (auto gv : refs) {
+		refContents.push_back(getGlobalValueContent(*gv));
+	}
+	std::sort(refContents.begin(), refContents.end());
+	for (const auto &content : refContents) {
+		os << content << "\n";
+	}
+	return os.str();
+}
+
+/**
+* @brief Returns information about the given function from the config that
+*        affect the emitted code.
+*
+* @param[in] module Module containing @a func (may be null).
+* @param[in] func Function from the module (may be null).
+* @param[in] config Config of the decompilation.
+* @param[in] name Name of the function in LLVM IR.
+*/
+std::string getFuncInfo(ShPtr<Module> module, ShPtr<Function> func,
+		const retdec::config::Config &config, const std::string &name) {
+	std::ostringstream info;
+	if (auto cf = config.functions.getFunctionByName(name)) {
+		addField(info, std::to_string(
+			static_cast<int>(cf->callingConvention.getID())));
+	}
+	if (!func) {
+		return info.str();
+	}
+
+	auto addressRange = module->getAddressRangeForFunc(func);
+	addField(info, addressToString(addressRange.getStart()));
+	addField(info, addressToString(addressRange.getEnd()));
+	auto lineRange = module->getLineRangeForFunc(func);
+	addField(info, std::to_string(lineRange.first));
+	addField(info, std::to_string(lineRange.second));
+	addField(info, module->getRealNameForFunc(func));
+	addField(info, module->getDeclarationStringForFunc(func));
+	addField(info, module->getCommentForFunc(func));
+	addField(info, module->getWrappedFuncName(func));
+	addField(info, module->getDemangledNameOfFunc(func));
+	addField(info, module->getClassForFunc(func));
+	addField(info, module->getDebugModuleNameForFunc(func));
+	for (const auto &pattern : module->getDetectedCryptoPatternsForFunc(func)) {
+		addField(info, pattern);
+	}
+	return info.str();
+}
+
+/**
+* @brief Escapes @a str so that it can be stored on a single line.
+*/
+std::string escapeValue(const std::string &str) {
+	std::string escaped;
+	escaped.reserve(str.size());
+	for (char c : str) {
+		switch (c) {
+			case '\\': escaped += "\\\\"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\r': escaped += "\\r"; break;
+			default: escaped += c;
+		}
+	}
+	return escaped;
+}
+
+/**
+* @brief Reverts escapeValue().
+*/
+std::string unescapeValue(const std::string &str) {
+	std::string value;
+	value.reserve(str.size());
+	for (std::size_t i = 0; i < str.size(); ++i) {
+		if (str[i] != '\\' || i + 1 == str.size()) {
+			value += str[i];
+			continue;
+		}
+		switch (str[++i]) {
+			case 'n': value += '\n'; break;
+			case 'r': value += '\r'; break;
+			default: value += str[i];
+		}
+	}
+	return value;
+}
+
+/**
+* @brief Returns the range of addresses of @a func as it is stored in entries.
+*/
+std::string getAddressRangeLine(ShPtr<Module> module, ShPtr<Function> func) {
+	auto range = module->getAddressRangeForFunc(func);
+	return addressToString(range.getStart()) + " "
+		+ addressToString(range.getEnd());
+}
+
+} // anonymous namespace
+
+/**
+* @brief Creates a cache stored in the directory @a dir.
+*
+* @param[in] dir Directory with the cache. It is created if it does not exist.
+* @param[in] maxSize Maximal size of the cache (in bytes).
+* @param[in] context Options of the decompilation that affect the emitted code.
+*                    Functions are found in the cache only if they were stored
+*                    with the same context.
+*/
+FuncOutputCache::FuncOutputCache(const std::string &dir, std::uint64_t maxSize,
+		const std::string &context):
+	cache(dir, maxSize), context(context) {}
+
+/**
+* @brief Loads outputs of functions from @a module from the cache.
+*
+* @param[in] module Module whose functions are searched in the cache.
+* @param[in] llvmModule LLVM module from which @a module has been created.
+* @param[in] config Config of the decompilation.
+*
+* @return Number of functions whose output has been found in the cache.
+*
+* The found functions are marked in @a module by
+* Module::markFuncOutputAsCached(). This function has to be called before
+* optimizations because it relies on functions being in the same state as
+* they were in LLVM IR.
+*
+* @par Preconditions
+*  - @a module is non-null
+*/
+std::size_t FuncOutputCache::loadOutputs(ShPtr<Module> module,
+		llvm::Module &llvmModule, const retdec::config::Config &config) {
+	PRECONDITION_NON_NULL(module);
+
+	this->module = module;
+	keys.clear();
+	outputs.clear();
+	nameMapsComputed = false;
+	if (!cache.isUsable()) {
+		return 0;
+	}
+
+	computeKeys(llvmModule, config);
+
+	auto vars = getInitialNameToVarMap();
+	for (const auto &p : keys) {
+		auto content = cache.get(p.second);
+		if (!content) {
+			continue;
+		}
+
+		std::istringstream entry(*content);
+		std::string line;
+		if (!std::getline(entry, line) || line != ENTRY_HEADER) {
+			continue;
+		}
+		// The address range of the function from the decoder has to be the
+		// same as when the entry was stored.
+		if (!std::getline(entry, line)
+				|| line != getAddressRangeLine(module, p.first)) {
+			continue;
+		}
+
+		// The whole entry is checked now, so the output can be emitted later
+		// without any further checks (see dropUnusableOutputs() for the
+		// exception).
+		CachedOutput output;
+		std::size_t addressDepth = 0;
+		bool valid = true;
+		while (valid && std::getline(entry, line)) {
+			// <kind> <value type> <address> <escaped value>
+			std::istringstream tokenLine(line);
+			unsigned kind = 0;
+			char valueType = 0;
+			std::string address;
+			if (!(tokenLine >> kind >> valueType >> address)
+					|| kind > static_cast<unsigned>(
+						RecordingOutputManager::TokenKind::AddressPop)
+					|| (valueType != NAME_VALUE && valueType != LITERAL_VALUE)
+					|| (address != "-" && !std::all_of(address.begin(),
+						address.end(),
+						[](char c) { return c >= '0' && c <= '9'; }))) {
+				valid = false;
+				break;
+			}
+			std::string value;
+			tokenLine.get();
+			std::getline(tokenLine, value);
+
+			RecordingOutputManager::Token token{
+				static_cast<RecordingOutputManager::TokenKind>(kind),
+				unescapeValue(value),
+				stringToAddress(address)
+			};
+			switch (token.kind) {
+				case RecordingOutputManager::TokenKind::Punctuation:
+					valid = token.value.size() == 1;
+					break;
+				case RecordingOutputManager::TokenKind::AddressPush:
+					++addressDepth;
+					break;
+				case RecordingOutputManager::TokenKind::AddressPop:
+					// Every pop has to match a push.
+					valid = addressDepth-- > 0;
+					break;
+				default:
+					break;
+			}
+			if (valueType == NAME_VALUE) {
+				valid = valid && hasItem(NAME_TOKEN_KINDS, token.kind);
+				output.nameTokens.push_back(output.tokens.size());
+			}
+			output.tokens.push_back(std::move(token));
+		}
+		// Every referenced global variable or function has to exist.
+		if (!valid || addressDepth != 0
+				|| !refersOnlyToExistingVars(output, vars)) {
+			continue;
+		}
+
+		// Optimizations must not remove what the output refers to.
+		for (auto i : output.nameTokens) {
+			module->preventRemovalOfVar(vars[output.tokens[i].value]);
+		}
+		outputs.emplace(p.first, std::move(output));
+		module->markFuncOutputAsCached(p.first);
+	}
+	return outputs.size();
+}
+
+/**
+* @brief Drops outputs of functions that cannot be emitted anymore.
+*
+* The output of a function cannot be emitted when a global variable or a
+* function it refers to has been removed from the module since the outputs
+* were loaded. Such functions are no longer marked as cached in the module, so
+* they have to be optimized and emitted normally.
+*
+* @return Functions whose outputs have been dropped.
+*/
+FuncVector FuncOutputCache::dropUnusableOutputs() {
+	FuncVector funcs;
+	auto vars = getInitialNameToVarMap();
+	for (auto i = outputs.begin(); i != outputs.end();) {
+		if (refersOnlyToExistingVars(i->second, vars)) {
+			++i;
+			continue;
+		}
+
+		module->unmarkFuncOutputAsCached(i->first);
+		funcs.push_back(i->first);
+		i = outputs.erase(i);
+	}
+	return funcs;
+}
+
+/**
+* @brief Emits the output of the given function loaded from the cache into
+*        @a out.
+*
+* @return @c true if the output has been emitted, @c false if there is no
+*         output of @a func in the cache or if it cannot be emitted (e.g. when
+*         a function it calls has been removed in the meantime). In the latter
+*         case, nothing is emitted.
+*/
+bool FuncOutputCache::emitCachedOutput(ShPtr<Function> func,
+		OutputManager &out) const {
+	auto it = outputs.find(func);
+	if (it == outputs.end()) {
+		return false;
+	}
+
+	// Global variables and functions might have been renamed or removed.
+	computeNameMapsForEmission();
+	auto tokens = it->second.tokens;
+	for (auto i : it->second.nameTokens) {
+		auto nameIt = currentNames.find(tokens[i].value);
+		if (nameIt == currentNames.end()) {
+			return false;
+		}
+		tokens[i].value = nameIt->second;
+	}
+
+	RecordingOutputManager::replay(tokens, out);
+	return true;
+}
+
+/**
+* @brief Stores the given emitted output of @a func into the cache.
+*
+* Nothing is stored if @a func has no key (e.g. it was not in the module when
+* the outputs were loaded) or if its output was taken from the cache.
+*/
+void FuncOutputCache::storeOutput(ShPtr<Function> func,
+		const RecordingOutputManager::Tokens &tokens) {
+	auto key = mapGetValueOrDefault(keys, func);
+	if (key.empty() || module->isFuncOutputCached(func)) {
+		return;
+	}
+
+	computeNameMapsForEmission();
+	std::ostringstream entry;
+	entry << ENTRY_HEADER << "\n"
+		<< getAddressRangeLine(module, func) << "\n";
+	for (const auto &token : tokens) {
+		auto value = token.value;
+		auto valueType = LITERAL_VALUE;
+		if (hasItem(NAME_TOKEN_KINDS, token.kind)) {
+			auto nameIt = initialNames.find(value);
+			if (nameIt != initialNames.end()) {
+				value = nameIt->second;
+				valueType = NAME_VALUE;
+			}
+		}
+		entry << static_cast<unsigned>(token.kind) << " " << valueType << " "
+			<< addressToString(token.address) << " " << escapeValue(value)
+			<< "\n";
+	}
+	cache.put(key, entry.str());
+}
+
+/**
+* @brief Removes the least recently used entries if the cache is too large.
+*/
+void FuncOutputCache::evict() {
+	cache.evict();
+}
+
+/**
+* @brief Computes the keys of all function definitions in the module.
+*
+* The key of a function is a hash of its own content and of the contents of
+* all the functions it (transitively) calls. To handle recursion, the call
+* graph is split into strongly connected components, which are hashed from
+* callees to callers.
+*/
+void FuncOutputCache::computeKeys(llvm::Module &llvmModule,
+		const retdec::config::Config &config) {
+	std::map<std::string, ShPtr<Function>> funcs;
+	for (auto i = module->func_begin(), e = module->func_end(); i != e; ++i) {
+		funcs.emplace((*i)->getInitialName(), *i);
+	}
+
+	llvm::ModuleSlotTracker mst(&llvmModule, false);
+	std::map<const llvm::Function *, std::string> ownHashes;
+	for (const auto &f : llvmModule) {
+		auto name = f.getName().str();
+		ownHashes[&f] = computeHash(getLLVMFuncContent(f, mst)
+			+ getFuncInfo(module, mapGetValueOrDefault(funcs, name),
+				config, name));
+	}
+
+	llvm::CallGraph cg(llvmModule);
+	std::map<const llvm::Function *, std::string> sccHashes;
+	for (auto i = llvm::scc_begin(&cg); !i.isAtEnd(); ++i) {
+		std::set<const llvm::Function *> members;
+		for (auto node : *i) {
+			if (auto f = node->getFunction()) {
+				members.insert(f);
+			}
+		}
+
+		std::vector<std::string> memberHashes;
+		for (auto f : members) {
+			memberHashes.push_back(ownHashes[f]);
+		}
+		// Callees are always visited before callers.
+		std::vector<std::string> calleeHashes;
+		for (auto node : *i) {
+			for (const auto &callee : *node) {
+				auto f = callee.second->getFunction();
+				if (f && !hasItem(members, f)) {
+					calleeHashes.push_back(sccHashes[f]);
+				}
+			}
+		}
+		std::sort(memberHashes.begin(), memberHashes.end());
+		std::sort(calleeHashes.begin(), calleeHashes.end());
+
+		std::string sccContent;
+		for (const auto &hash : memberHashes) {
+			sccContent += hash + "\n";
+		}
+		sccContent += "\n";
+		for (const auto &hash : calleeHashes) {
+			sccContent += hash + "\n";
+		}
+		auto sccHash = computeHash(sccContent);
+		for (auto f : members) {
+			sccHashes[f] = sccHash;
+		}
+	}
+
+	auto prefix = ENTRY_HEADER + "\n" + retdec::utils::version::getCommitHash()
+		+ "\n" + context + "\n";
+	for (const auto &p : funcs) {
+		auto f = llvmModule.getFunction(p.first);
+		if (!f || f->isDeclaration() || !p.second->isDefinition()) {
+			continue;
+		}
+		keys[p.second] = computeHash(prefix + ownHashes[f] + "\n"
+			+ sccHashes[f]);
+	}
+}
+
+/**
+* @brief Returns a mapping of initial names of global variables and functions
+*        into their variables.
+*
+* The current name of a global variable or a function is the name of its
+* variable.
+*/
+StringVarMap FuncOutputCache::getInitialNameToVarMap() const {
+	StringVarMap vars;
+	for (auto i = module->global_var_begin(), e = module->global_var_end();
+			i != e; ++i) {
+		auto var = (*i)->getVar();
+		vars.emplace(var->getInitialName(), var);
+	}
+	for (auto i = module->func_begin(), e = module->func_end(); i != e; ++i) {
+		vars.emplace((*i)->getInitialName(), (*i)->getAsVar());
+	}
+	return vars;
+}
+
+/**
+* @brief Do all global variables and functions @a output refers to exist?
+*
+* @param[in] output Output of a function loaded from the cache.
+* @param[in] vars Existing global variables and functions (see
+*                 getInitialNameToVarMap()).
+*/
+bool FuncOutputCache::refersOnlyToExistingVars(const CachedOutput &output,
+		const StringVarMap &vars) const {
+	return std::all_of(output.nameTokens.begin(), output.nameTokens.end(),
+		[&](std::size_t i) { return hasItem(vars, output.tokens[i].value); });
+}
+
+/**
+* @brief Computes mappings between initial and current names of global
+*        variables and functions, unless they have already been computed.
+*/
+void FuncOutputCache::computeNameMapsForEmission() const {
+	if (nameMapsComputed) {
+		return;
+	}
+
+	currentNames.clear();
+	for (const auto &p : getInitialNameToVarMap()) {
+		currentNames.emplace(p.first, p.second->getName());
+	}
+	initialNames.clear();
+	for (const auto &p : currentNames) {
+		initialNames.emplace(p.second, p.first);
+	}
+	nameMapsComputed = true;
+}
+
+} // namespace llvmir2hll
+} // namespace retdec
@@ -9,10 +9,12 @@
 #include <sstream>
 
 #include "retdec/llvmir2hll/hll/bracket_manager.h"
+#include "retdec/llvmir2hll/hll/func_output_cache.h"
 #include "retdec/llvmir2hll/hll/hll_writer.h"
 #include "retdec/llvmir2hll/hll/output_manager.h"
 #include "retdec/llvmir2hll/hll/output_managers/json_manager.h"
 #include "retdec/llvmir2hll/hll/output_managers/plain_manager.h"
+#include "retdec/llvmir2hll/hll/output_managers/recording_manager.h"
 #include "retdec/llvmir2hll/ir/array_type.h"
 #include "retdec/llvmir2hll/ir/binary_op_expr.h"
 #include "retdec/llvmir2hll/ir/call_expr.h"
@@ -39,6 +41,7 @@
 #include "retdec/llvmir2hll/utils/string.h"
 #include "retdec/utils/container.h"
 #include "retdec/utils/conversion.h"
+#include "retdec/utils/scope_exit.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/time.h"
 
@@ -153,6 +156,8 @@ HLLWriter::HLLWriter(llvm::raw_ostream &o, const std::string& outputFormat):
 		out = UPtr<OutputManager>(new JsonOutputManagerPlain(o));
 	} else if (outputFormat == "json-human") {
 		out = UPtr<OutputManager>(new JsonOutputManagerPretty(o));
+	} else if (outputFormat == "json-compact") {
+		out = UPtr<OutputManager>(new JsonOutputManagerPlain(o, true));
 	} else {
 		out = UPtr<OutputManager>(new PlainOutputManager(o));
 	}
@@ -198,6 +203,17 @@ void HLLWriter::setOptionUseCompoundOperators(bool use) {
 	optionUseCompoundOperators = use;
 }
 
+/**
+* @brief Sets a cache of the emitted code of functions.
+*
+* When set, the code of functions found in the cache is taken from it, and the
+* code of the other functions is stored into it. When @a cache is the null
+* pointer, no cache is used.
+*/
+void HLLWriter::setFuncOutputCache(ShPtr<FuncOutputCache> cache) {
+	funcOutputCache = cache;
+}
+
 /**
 * @brief Emits the code from the given module.
 *
@@ -523,7 +539,7 @@ bool HLLWriter::emitFunctions() {
 			// To produce an empty line between functions.
 			out->newLine();
 		}
-		somethingEmitted |= emitFunction(func);
+		somethingEmitted |= emitFunctionUsingCache(func);
 	}
 	return somethingEmitted;
 }
@@ -567,6 +583,41 @@ bool HLLWriter::emitFunction(ShPtr<Function> func) {
 	return true;
 }
 
+/**
+* @brief Emits the given function, taking its code from the cache of function
+*        outputs when possible.
+*
+* If the code of @a func is not in the cache, it is emitted by emitFunction()
+* and stored into the cache. Cached code that cannot be emitted anymore is
+* dropped before, right after the optimizations (see
+* FuncOutputCache::dropUnusableOutputs()), so such functions are optimized and
+* emitted normally.
+*/
+bool HLLWriter::emitFunctionUsingCache(ShPtr<Function> func) {
+	if (!funcOutputCache) {
+		return emitFunction(func);
+	}
+
+	if (funcOutputCache->emitCachedOutput(func, *out)) {
+		return true;
+	}
+
+	// Record the emitted tokens while passing them to the original output.
+	auto recorder = new RecordingOutputManager(*out);
+	UPtr<OutputManager> otherOut(recorder);
+	out.swap(otherOut);
+	bool emitted = false;
+	{
+		SCOPE_EXIT {
+			out.swap(otherOut);
+		};
+		emitted = emitFunction(func);
+	}
+
+	funcOutputCache->storeOutput(func, recorder->getTokens());
+	return emitted;
+}
+
 /**
 * @brief Emits the header of the <em>statically linked functions</em> block.
 *
@@ -4,6 +4,8 @@
 * @copyright (c) 2019 Avast Software, licensed under the MIT license
 */
 
+#include <vector>
+
 #include "retdec/llvmir2hll/hll/output_managers/json_manager.h"
 #include "retdec/utils/string.h"
 
@@ -15,30 +17,65 @@ namespace {
 const std::string JSON_KEY_LANGUAGE        = "language";
 const std::string JSON_KEY_ADDRESS         = "addr";
 const std::string JSON_KEY_TOKENS          = "tokens";
+const std::string JSON_KEY_KINDS           = "kinds";
 const std::string JSON_KEY_KIND            = "kind";
 const std::string JSON_KEY_VALUE           = "val";
 
-const std::string JSON_TOKEN_NEWLINE       = "nl";
-const std::string JSON_TOKEN_SPACE         = "ws";
-const std::string JSON_TOKEN_PUNCTUATION   = "punc";
-const std::string JSON_TOKEN_OPERATOR      = "op";
-const std::string JSON_TOKEN_ID_GVAR       = "i_gvar";
-const std::string JSON_TOKEN_ID_LVAR       = "i_lvar";
-const std::string JSON_TOKEN_ID_MEMBER     = "i_mem";
-const std::string JSON_TOKEN_ID_LABEL      = "i_lab";
-const std::string JSON_TOKEN_ID_FUNCTION   = "i_fnc";
-const std::string JSON_TOKEN_ID_PARAMETER  = "i_arg";
-const std::string JSON_TOKEN_KEYWORD       = "keyw";
-const std::string JSON_TOKEN_DATA_TYPE     = "type";
-const std::string JSON_TOKEN_PREPROCESSOR  = "preproc";
-const std::string JSON_TOKEN_INCLUDE       = "inc";
-const std::string JSON_TOKEN_CONST_BOOL    = "l_bool";
-const std::string JSON_TOKEN_CONST_INT     = "l_int";
-const std::string JSON_TOKEN_CONST_FLOAT   = "l_fp";
-const std::string JSON_TOKEN_CONST_STRING  = "l_str";
-const std::string JSON_TOKEN_CONST_SYMBOL  = "l_sym";
-const std::string JSON_TOKEN_CONST_POINTER = "l_ptr";
-const std::string JSON_TOKEN_COMMENT       = "cmnt";
+/**
+ * Kinds of tokens. Their values are indexes to @c JSON_TOKEN_KINDS and they
+ * are emitted instead of kind names in the compact output, so new kinds must
+ * be added to the end.
+ */
+enum JsonTokenKind : std::size_t
+{
+	TOKEN_NEWLINE,
+	TOKEN_SPACE,
+	TOKEN_PUNCTUATION,
+	TOKEN_OPERATOR,
+	TOKEN_ID_GVAR,
+	TOKEN_ID_LVAR,
+	TOKEN_ID_MEMBER,
+	TOKEN_ID_LABEL,
+	TOKEN_ID_FUNCTION,
+	TOKEN_ID_PARAMETER,
+	TOKEN_KEYWORD,
+	TOKEN_DATA_TYPE,
+	TOKEN_PREPROCESSOR,
+	TOKEN_INCLUDE,
+	TOKEN_CONST_BOOL,
+	TOKEN_CONST_INT,
+	TOKEN_CONST_FLOAT,
+	TOKEN_CONST_STRING,
+	TOKEN_CONST_SYMBOL,
+	TOKEN_CONST_POINTER,
+	TOKEN_COMMENT,
+};
+
+/// Names of token kinds indexed by @c JsonTokenKind.
+const std::vector<std::string> JSON_TOKEN_KINDS =
+{
+	"nl",        // TOKEN_NEWLINE
+	"ws",        // TOKEN_SPACE
+	"punc",      // TOKEN_PUNCTUATION
+	"op",        // TOKEN_OPERATOR
+	"i_gvar",    // TOKEN_ID_GVAR
+	"i_lvar",    // TOKEN_ID_LVAR
+	"i_mem",     // TOKEN_ID_MEMBER
+	"i_lab",     // TOKEN_ID_LABEL
+	"i_fnc",     // TOKEN_ID_FUNCTION
+	"i_arg",     // TOKEN_ID_PARAMETER
+	"keyw",      // TOKEN_KEYWORD
+	"type",      // TOKEN_DATA_TYPE
+	"preproc",   // TOKEN_PREPROCESSOR
+	"inc",       // TOKEN_INCLUDE
+	"l_bool",    // TOKEN_CONST_BOOL
+	"l_int",     // TOKEN_CONST_INT
+	"l_fp",      // TOKEN_CONST_FLOAT
+	"l_str",     // TOKEN_CONST_STRING
+	"l_sym",     // TOKEN_CONST_SYMBOL
+	"l_ptr",     // TOKEN_CONST_POINTER
+	"cmnt",      // TOKEN_COMMENT
+};
 
 /**
  * We don't like macros, but we potentially need to return from methods calling
@@ -56,13 +93,34 @@ const std::string JSON_TOKEN_COMMENT       = "cmnt";
 
 } // anonymous namespace
 
+/**
+ * @param[in] out Output into which the tokens are written as soon as they are
+ *                added. They are not kept in memory until @c finalize().
+ * @param[in] compact If @c true, kinds of tokens are emitted only once in
+ *                    the @c kinds array, and every token is emitted as
+ *                    @c [kind_index,value] array instead of an object.
+ */
 template <typename Writer>
-JsonOutputManager<Writer>::JsonOutputManager(llvm::raw_ostream& out) :
-		_out(out),
-		writer(sb)
+JsonOutputManager<Writer>::JsonOutputManager(
+		llvm::raw_ostream& out,
+		bool compact) :
+		_stream(out),
+		writer(_stream),
+		_compact(compact)
 {
 	writer.StartObject();
 
+	if (_compact)
+	{
+		writer.String(JSON_KEY_KINDS);
+		writer.StartArray();
+		for (const auto& k : JSON_TOKEN_KINDS)
+		{
+			writer.String(k);
+		}
+		writer.EndArray();
+	}
+
 	writer.String(JSON_KEY_TOKENS);
 	writer.StartArray();
 
@@ -78,8 +136,6 @@ void JsonOutputManager<Writer>::finalize()
 	writer.String(getOutputLanguage());
 
 	writer.EndObject();
-
-	_out << sb.GetString();
 }
 
 template <typename Writer>
@@ -97,140 +153,140 @@ void JsonOutputManager<Writer>::newLine()
 		}
 	}
 
-	jsonToken(JSON_TOKEN_NEWLINE, "\n");
+	jsonToken(TOKEN_NEWLINE, "\n");
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::space(const std::string& space)
 {
 	HANDLE_COMMENT_MODIFIER(space);
-	jsonToken(JSON_TOKEN_SPACE, space);
+	jsonToken(TOKEN_SPACE, space);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::punctuation(char p)
 {
 	HANDLE_COMMENT_MODIFIER(p);
-	jsonToken(JSON_TOKEN_PUNCTUATION, std::string(1, p));
+	jsonToken(TOKEN_PUNCTUATION, std::string(1, p));
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::operatorX(const std::string& op)
 {
 	HANDLE_COMMENT_MODIFIER(op);
-	jsonToken(JSON_TOKEN_OPERATOR, op);
+	jsonToken(TOKEN_OPERATOR, op);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::globalVariableId(const std::string& id)
 {
 	HANDLE_COMMENT_MODIFIER(id);
-	jsonToken(JSON_TOKEN_ID_GVAR, id);
+	jsonToken(TOKEN_ID_GVAR, id);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::localVariableId(const std::string& id)
 {
 	HANDLE_COMMENT_MODIFIER(id);
-	jsonToken(JSON_TOKEN_ID_LVAR, id);
+	jsonToken(TOKEN_ID_LVAR, id);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::memberId(const std::string& id)
 {
 	HANDLE_COMMENT_MODIFIER(id);
-	jsonToken(JSON_TOKEN_ID_MEMBER, id);
+	jsonToken(TOKEN_ID_MEMBER, id);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::labelId(const std::string& id)
 {
 	HANDLE_COMMENT_MODIFIER(id);
-	jsonToken(JSON_TOKEN_ID_LABEL, id);
+	jsonToken(TOKEN_ID_LABEL, id);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::functionId(const std::string& id)
 {
 	HANDLE_COMMENT_MODIFIER(id);
-	jsonToken(JSON_TOKEN_ID_FUNCTION, id);
+	jsonToken(TOKEN_ID_FUNCTION, id);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::parameterId(const std::string& id)
 {
 	HANDLE_COMMENT_MODIFIER(id);
-	jsonToken(JSON_TOKEN_ID_PARAMETER, id);
+	jsonToken(TOKEN_ID_PARAMETER, id);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::keyword(const std::string& k)
 {
 	HANDLE_COMMENT_MODIFIER(k);
-	jsonToken(JSON_TOKEN_KEYWORD, k);
+	jsonToken(TOKEN_KEYWORD, k);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::dataType(const std::string& t)
 {
 	HANDLE_COMMENT_MODIFIER(t);
-	jsonToken(JSON_TOKEN_DATA_TYPE, t);
+	jsonToken(TOKEN_DATA_TYPE, t);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::preprocessor(const std::string& p)
 {
 	HANDLE_COMMENT_MODIFIER(p);
-	jsonToken(JSON_TOKEN_PREPROCESSOR, p);
+	jsonToken(TOKEN_PREPROCESSOR, p);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::include(const std::string& i)
 {
 	HANDLE_COMMENT_MODIFIER(i);
-	jsonToken(JSON_TOKEN_INCLUDE, "<" + i + ">");
+	jsonToken(TOKEN_INCLUDE, "<" + i + ">");
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::constantBool(const std::string& c)
 {
 	HANDLE_COMMENT_MODIFIER(c);
-	jsonToken(JSON_TOKEN_CONST_BOOL, c);
+	jsonToken(TOKEN_CONST_BOOL, c);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::constantInt(const std::string& c)
 {
 	HANDLE_COMMENT_MODIFIER(c);
-	jsonToken(JSON_TOKEN_CONST_INT, c);
+	jsonToken(TOKEN_CONST_INT, c);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::constantFloat(const std::string& c)
 {
 	HANDLE_COMMENT_MODIFIER(c);
-	jsonToken(JSON_TOKEN_CONST_FLOAT, c);
+	jsonToken(TOKEN_CONST_FLOAT, c);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::constantString(const std::string& c)
 {
 	HANDLE_COMMENT_MODIFIER(c);
-	jsonToken(JSON_TOKEN_CONST_STRING, c);
+	jsonToken(TOKEN_CONST_STRING, c);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::constantSymbol(const std::string& c)
 {
 	HANDLE_COMMENT_MODIFIER(c);
-	jsonToken(JSON_TOKEN_CONST_SYMBOL, c);
+	jsonToken(TOKEN_CONST_SYMBOL, c);
 }
 
 template <typename Writer>
 void JsonOutputManager<Writer>::constantPointer(const std::string& c)
 {
 	HANDLE_COMMENT_MODIFIER(c);
-	jsonToken(JSON_TOKEN_CONST_POINTER, c);
+	jsonToken(TOKEN_CONST_POINTER, c);
 }
 
 template <typename Writer>
@@ -242,7 +298,7 @@ void JsonOutputManager<Writer>::comment(const std::string& c)
 	{
 		str += " " + utils::replaceCharsWithStrings(c, '\n', " ");
 	}
-	jsonToken(JSON_TOKEN_COMMENT, str);
+	jsonToken(TOKEN_COMMENT, str);
 }
 
 template <typename Writer>
@@ -324,7 +380,7 @@ void JsonOutputManager<Writer>::generateAddressEntry(Address a)
 
 template <typename Writer>
 void JsonOutputManager<Writer>::jsonToken(
-		const std::string& k,
+		std::size_t k,
 		const std::string& v)
 {
 	if (_addrToGenerate.second)
@@ -333,10 +389,19 @@ void JsonOutputManager<Writer>::jsonToken(
 		_addrToGenerate = std::make_pair(Address::Undefined, false);
 	}
 
+	if (_compact)
+	{
+		writer.StartArray();
+		writer.Uint64(k);
+		writer.String(v);
+		writer.EndArray();
+		return;
+	}
+
 	writer.StartObject();
 
 	writer.String(JSON_KEY_KIND);
-	writer.String(k);
+	writer.String(JSON_TOKEN_KINDS[k]);
 
 	writer.String(JSON_KEY_VALUE);
 	writer.String(v);
@@ -344,8 +409,8 @@ void JsonOutputManager<Writer>::jsonToken(
 	writer.EndObject();
 }
 
-template class JsonOutputManager<rapidjson::Writer<rapidjson::StringBuffer, rapidjson::ASCII<>>>;
-template class JsonOutputManager<rapidjson::PrettyWriter<rapidjson::StringBuffer, rapidjson::ASCII<>>>;
+template class JsonOutputManager<rapidjson::Writer<JsonOutputStream, rapidjson::ASCII<>>>;
+template class JsonOutputManager<rapidjson::PrettyWriter<JsonOutputStream, rapidjson::ASCII<>>>;
 
 } // namespace llvmir2hll
 } // namespace retdec
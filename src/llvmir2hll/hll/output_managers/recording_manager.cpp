@@ -0,0 +1,262 @@
+/**
+* @file src/llvmir2hll/hll/output_managers/recording_manager.cpp
+* @brief Implementation of RecordingOutputManager.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include "retdec/llvmir2hll/hll/output_managers/recording_manager.h"
+
+namespace retdec {
+namespace llvmir2hll {
+
+RecordingOutputManager::RecordingOutputManager(OutputManager& out) :
+		_out(out)
+{
+	setCommentPrefix(out.getCommentPrefix());
+	setOutputLanguage(out.getOutputLanguage());
+}
+
+/**
+* @brief Returns the tokens recorded so far.
+*/
+const RecordingOutputManager::Tokens& RecordingOutputManager::getTokens() const
+{
+	return _tokens;
+}
+
+/**
+* @brief Passes the given recorded @a tokens to @a out.
+*/
+void RecordingOutputManager::replay(const Tokens& tokens, OutputManager& out)
+{
+	for (const auto& t : tokens)
+	{
+		switch (t.kind)
+		{
+			case TokenKind::NewLine:
+				out.newLine();
+				break;
+			case TokenKind::Space:
+				out.space(t.value);
+				break;
+			case TokenKind::Punctuation:
+				out.punctuation(t.value.empty() ? ' ' : t.value[0]);
+				break;
+			case TokenKind::Operator:
+				out.operatorX(t.value);
+				break;
+			case TokenKind::GlobalVariableId:
+				out.globalVariableId(t.value);
+				break;
+			case TokenKind::LocalVariableId:
+				out.localVariableId(t.value);
+				break;
+			case TokenKind::MemberId:
+				out.memberId(t.value);
+				break;
+			case TokenKind::LabelId:
+				out.labelId(t.value);
+				break;
+			case TokenKind::FunctionId:
+				out.functionId(t.value);
+				break;
+			case TokenKind::ParameterId:
+				out.parameterId(t.value);
+				break;
+			case TokenKind::Keyword:
+				out.keyword(t.value);
+				break;
+			case TokenKind::DataType:
+				out.dataType(t.value);
+				break;
+			case TokenKind::Preprocessor:
+				out.preprocessor(t.value);
+				break;
+			case TokenKind::Include:
+				out.include(t.value);
+				break;
+			case TokenKind::ConstantBool:
+				out.constantBool(t.value);
+				break;
+			case TokenKind::ConstantInt:
+				out.constantInt(t.value);
+				break;
+			case TokenKind::ConstantFloat:
+				out.constantFloat(t.value);
+				break;
+			case TokenKind::ConstantString:
+				out.constantString(t.value);
+				break;
+			case TokenKind::ConstantSymbol:
+				out.constantSymbol(t.value);
+				break;
+			case TokenKind::ConstantPointer:
+				out.constantPointer(t.value);
+				break;
+			case TokenKind::Comment:
+				out.comment(t.value);
+				break;
+			case TokenKind::CommentModifier:
+				out.commentModifier();
+				break;
+			case TokenKind::AddressPush:
+				out.addressPush(t.address);
+				break;
+			case TokenKind::AddressPop:
+				out.addressPop();
+				break;
+		}
+	}
+}
+
+void RecordingOutputManager::record(TokenKind kind, const std::string& value)
+{
+	_tokens.push_back(Token{kind, value, Address()});
+}
+
+void RecordingOutputManager::newLine()
+{
+	_out.newLine();
+	record(TokenKind::NewLine);
+}
+
+void RecordingOutputManager::space(const std::string& space)
+{
+	_out.space(space);
+	record(TokenKind::Space, space);
+}
+
+void RecordingOutputManager::punctuation(char p)
+{
+	_out.punctuation(p);
+	record(TokenKind::Punctuation, std::string(1, p));
+}
+
+void RecordingOutputManager::operatorX(const std::string& op)
+{
+	_out.operatorX(op);
+	record(TokenKind::Operator, op);
+}
+
+void RecordingOutputManager::globalVariableId(const std::string& id)
+{
+	_out.globalVariableId(id);
+	record(TokenKind::GlobalVariableId, id);
+}
+
+void RecordingOutputManager::localVariableId(const std::string& id)
+{
+	_out.localVariableId(id);
+	record(TokenKind::LocalVariableId, id);
+}
+
+void RecordingOutputManager::memberId(const std::string& id)
+{
+	_out.memberId(id);
+	record(TokenKind::MemberId, id);
+}
+
+void RecordingOutputManager::labelId(const std::string& id)
+{
+	_out.labelId(id);
+	record(TokenKind::LabelId, id);
+}
+
+void RecordingOutputManager::functionId(const std::string& id)
+{
+	_out.functionId(id);
+	record(TokenKind::FunctionId, id);
+}
+
+void RecordingOutputManager::parameterId(const std::string& id)
+{
+	_out.parameterId(id);
+	record(TokenKind::ParameterId, id);
+}
+
+void RecordingOutputManager::keyword(const std::string& k)
+{
+	_out.keyword(k);
+	record(TokenKind::Keyword, k);
+}
+
+void RecordingOutputManager::dataType(const std::string& t)
+{
+	_out.dataType(t);
+	record(TokenKind::DataType, t);
+}
+
+void RecordingOutputManager::preprocessor(const std::string& p)
+{
+	_out.preprocessor(p);
+	record(TokenKind::Preprocessor, p);
+}
+
+void RecordingOutputManager::include(const std::string& i)
+{
+	_out.include(i);
+	record(TokenKind::Include, i);
+}
+
+void RecordingOutputManager::constantBool(const std::string& c)
+{
+	_out.constantBool(c);
+	record(TokenKind::ConstantBool, c);
+}
+
+void RecordingOutputManager::constantInt(const std::string& c)
+{
+	_out.constantInt(c);
+	record(TokenKind::ConstantInt, c);
+}
+
+void RecordingOutputManager::constantFloat(const std::string& c)
+{
+	_out.constantFloat(c);
+	record(TokenKind::ConstantFloat, c);
+}
+
+void RecordingOutputManager::constantString(const std::string& c)
+{
+	_out.constantString(c);
+	record(TokenKind::ConstantString, c);
+}
+
+void RecordingOutputManager::constantSymbol(const std::string& c)
+{
+	_out.constantSymbol(c);
+	record(TokenKind::ConstantSymbol, c);
+}
+
+void RecordingOutputManager::constantPointer(const std::string& c)
+{
+	_out.constantPointer(c);
+	record(TokenKind::ConstantPointer, c);
+}
+
+void RecordingOutputManager::comment(const std::string& c)
+{
+	_out.comment(c);
+	record(TokenKind::Comment, c);
+}
+
+void RecordingOutputManager::commentModifier()
+{
+	_out.commentModifier();
+	record(TokenKind::CommentModifier);
+}
+
+void RecordingOutputManager::addressPush(Address a)
+{
+	_out.addressPush(a);
+	_tokens.push_back(Token{TokenKind::AddressPush, "", a});
+}
+
+void RecordingOutputManager::addressPop()
+{
+	_out.addressPop();
+	record(TokenKind::AddressPop);
+}
+
+} // namespace llvmir2hll
+} // namespace retdec
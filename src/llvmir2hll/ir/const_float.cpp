@@ -9,6 +9,7 @@
 #include "retdec/llvmir2hll/ir/const_float.h"
 #include "retdec/llvmir2hll/ir/float_type.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/visitor.h"
 #include "retdec/utils/string.h"
 
@@ -206,6 +207,7 @@ ConstFloat::ToStringArgs ConstFloat::getToStringArgsForMostReadableString() cons
 * @brief Flip the sign of value.
 */
 void ConstFloat::flipSign() {
+	ModificationRecorder::recordModification();
 	llvm::APFloat apFloat = getValue();
 	apFloat.changeSign();
 	value = apFloat;
@@ -8,6 +8,7 @@
 #include "retdec/llvmir2hll/ir/int_type.h"
 #include "retdec/llvmir2hll/ir/unknown_type.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/visitor.h"
 #include "retdec/utils/string.h"
 
@@ -153,6 +154,7 @@ void ConstInt::flipSign() {
 	PRECONDITION(isSigned(), "the constant is not signed");
 	PRECONDITION(!isMinSigned(), "the constant is minimal value on bitwidth");
 
+	ModificationRecorder::recordModification();
 	value = getValue().operator -();
 }
 
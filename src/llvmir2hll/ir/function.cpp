@@ -12,6 +12,7 @@
 #include "retdec/llvmir2hll/ir/type.h"
 #include "retdec/llvmir2hll/ir/variable.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/visitor.h"
 #include "retdec/utils/container.h"
 
@@ -298,6 +299,7 @@ bool Function::hasParam(std::size_t n) const {
 * @brief Sets a new return type;
 */
 void Function::setRetType(ShPtr<Type> newRetType) {
+	ModificationRecorder::recordModification();
 	retType = newRetType;
 
 	updateUnderlyingVarType();
@@ -307,6 +309,7 @@ void Function::setRetType(ShPtr<Type> newRetType) {
 * @brief Sets a new name.
 */
 void Function::setName(const std::string &newName) {
+	ModificationRecorder::recordModification();
 	funcVar->setName(newName);
 }
 
@@ -330,6 +333,7 @@ void Function::setParams(VarVector newParams) {
 * @brief Sets a new set of local variables.
 */
 void Function::setLocalVars(VarSet newLocalVars) {
+	ModificationRecorder::recordModification();
 	localVars = newLocalVars;
 }
 
@@ -364,6 +368,7 @@ void Function::addParam(ShPtr<Variable> var) {
 void Function::addLocalVar(ShPtr<Variable> var) {
 	PRECONDITION_NON_NULL(var);
 
+	ModificationRecorder::recordModification();
 	localVars.insert(var);
 }
 
@@ -399,6 +404,7 @@ void Function::replaceLocalVar(ShPtr<Variable> oldVar, ShPtr<Variable> newVar) {
 	PRECONDITION_NON_NULL(oldVar);
 	PRECONDITION_NON_NULL(newVar);
 
+	ModificationRecorder::recordModification();
 	// Does oldVar correspond to a local variable?
 	auto oldVarIter = localVars.find(oldVar);
 	if (oldVarIter != localVars.end()) {
@@ -422,6 +428,7 @@ void Function::replaceLocalVar(ShPtr<Variable> oldVar, ShPtr<Variable> newVar) {
 void Function::removeLocalVar(ShPtr<Variable> var) {
 	PRECONDITION_NON_NULL(var);
 
+	ModificationRecorder::recordModification();
 	if (!hasParam(var)) {
 		localVars.erase(var);
 	}
@@ -438,6 +445,7 @@ void Function::removeLocalVar(ShPtr<Variable> var) {
 void Function::removeParam(ShPtr<Variable> param) {
 	PRECONDITION_NON_NULL(param);
 
+	ModificationRecorder::recordModification();
 	removeItem(params, param);
 	localVars.erase(param);
 	updateUnderlyingVarType();
@@ -467,6 +475,7 @@ void Function::setBody(ShPtr<Statement> newBody) {
 * arguments.
 */
 void Function::setVarArg(bool isVarArg) {
+	ModificationRecorder::recordModification();
 	varArg = isVarArg;
 
 	updateUnderlyingVarType();
@@ -483,6 +492,7 @@ void Function::setVarArg(bool isVarArg) {
 * observers are notified.
 */
 void Function::convertToDeclaration() {
+	ModificationRecorder::recordModification();
 	if (!isDefinition()) {
 		return;
 	}
@@ -616,6 +626,7 @@ void Function::accept(Visitor *v) {
 * changed (e.g. its return type or parameters).
 */
 void Function::updateUnderlyingVarType() {
+	ModificationRecorder::recordModification();
 	funcVar->setType(getType());
 }
 
@@ -625,6 +636,7 @@ void Function::updateUnderlyingVarType() {
 * Parameters are local variables, too.
 */
 void Function::includeParamsIntoLocalVars() {
+	ModificationRecorder::recordModification();
 	localVars.insert(params.begin(), params.end());
 }
 
@@ -7,6 +7,7 @@
 #include "retdec/llvmir2hll/ir/function_type.h"
 #include "retdec/llvmir2hll/ir/void_type.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/visitor.h"
 #include "retdec/utils/container.h"
 
@@ -68,6 +69,7 @@ bool FunctionType::isEqualTo(ShPtr<Value> otherValue) const {
 * @brief Sets a new return type.
 */
 void FunctionType::setRetType(ShPtr<Type> retType) {
+	ModificationRecorder::recordModification();
 	this->retType = retType;
 }
 
@@ -112,6 +114,7 @@ std::size_t FunctionType::getNumOfParams() const {
 * @brief Adds a new parameter.
 */
 void FunctionType::addParam(ShPtr<Type> paramType) {
+	ModificationRecorder::recordModification();
 	params.push_back(paramType);
 }
 
@@ -151,6 +154,7 @@ FunctionType::param_iterator FunctionType::param_end() const {
 *        not.
 */
 void FunctionType::setVarArg(bool isVarArg) {
+	ModificationRecorder::recordModification();
 	varArg = isVarArg;
 }
 
@@ -8,6 +8,7 @@
 #include "retdec/llvmir2hll/ir/global_var_def.h"
 #include "retdec/llvmir2hll/ir/variable.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/visitor.h"
 
 namespace retdec {
@@ -123,6 +124,7 @@ void GlobalVarDef::setInitializer(ShPtr<Expression> newInit) {
 * @brief Removes the initializer.
 */
 void GlobalVarDef::removeInitializer() {
+	ModificationRecorder::recordModification();
 	setInitializer(ShPtr<Expression>());
 }
 
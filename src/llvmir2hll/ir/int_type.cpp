@@ -78,6 +78,8 @@ bool IntType::isBool() const {
 ShPtr<IntType> IntType::create(unsigned size, bool isSigned) {
 	PRECONDITION(size > 0, "invalid size " << size);
 
+	std::lock_guard<std::mutex> lock(createdTypesMutex);
+
 	// There are two maps, one for signed integers and one for unsigned integers.
 	if (isSigned) {
 		// To reduce the amount of created types, we use a set of already created
@@ -108,6 +110,7 @@ void IntType::accept(Visitor *v) {
 // Static variables and constants definitions.
 std::map<unsigned, ShPtr<IntType>> IntType::createdSignedTypes;
 std::map<unsigned, ShPtr<IntType>> IntType::createdUnsignedTypes;
+std::mutex IntType::createdTypesMutex;
 
 } // namespace llvmir2hll
 } // namespace retdec
@@ -17,6 +17,7 @@
 #include "retdec/llvmir2hll/ir/variable.h"
 #include "retdec/llvmir2hll/semantics/semantics.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/utils/container.h"
 #include "retdec/utils/string.h"
 
@@ -61,6 +62,7 @@ Module::Module(const llvm::Module *llvmModule, const std::string &identifier,
 * module.
 */
 void Module::addGlobalVar(ShPtr<Variable> var, ShPtr<Expression> init) {
+	ModificationRecorder::recordModification();
 	// Check whether the variable has already been added.
 	for (auto i = globalVars.begin(), e = globalVars.end(); i != e; ++i) {
 		if ((*i)->getVar() == var) {
@@ -83,6 +85,7 @@ void Module::addGlobalVar(ShPtr<Variable> var, ShPtr<Expression> init) {
 * module.
 */
 void Module::removeGlobalVar(ShPtr<Variable> var) {
+	ModificationRecorder::recordModification();
 	for (auto i = globalVars.begin(), e = globalVars.end(); i != e; ++i) {
 		if ((*i)->getVar() == var) {
 			globalVars.erase(i);
@@ -267,6 +270,7 @@ Module::global_var_iterator Module::global_var_end() const {
 * If the function already exists in the module, nothing is done.
 */
 void Module::addFunc(ShPtr<Function> func) {
+	ModificationRecorder::recordModification();
 	if (!hasItem(funcs, func)) {
 		funcs.push_back(func);
 	}
@@ -278,7 +282,9 @@ void Module::addFunc(ShPtr<Function> func) {
 * If there is no matching function, nothing is removed.
 */
 void Module::removeFunc(ShPtr<Function> func) {
+	ModificationRecorder::recordModification();
 	removeItem(funcs, func);
+	funcsWithCachedOutput.erase(func);
 }
 
 /**
@@ -448,6 +454,7 @@ FuncSet Module::getStaticallyLinkedFuncs() const {
 * @brief Marks the given function as statically linked.
 */
 void Module::markFuncAsStaticallyLinked(ShPtr<Function> func) {
+	ModificationRecorder::recordModification();
 	config->markFuncAsStaticallyLinked(func->getInitialName());
 }
 
@@ -532,6 +539,62 @@ bool Module::isExportedFunc(ShPtr<Function> func) const {
 	return config->isExportedFunc(func->getInitialName());
 }
 
+/**
+* @brief Is the output of the given function taken from the cache of function
+*        outputs?
+*
+* The bodies of such functions do not need to be optimized because they are
+* not emitted.
+*/
+bool Module::isFuncOutputCached(ShPtr<Function> func) const {
+	return hasItem(funcsWithCachedOutput, func);
+}
+
+/**
+* @brief Returns all functions whose output is taken from the cache of function
+*        outputs.
+*/
+FuncSet Module::getFuncsWithCachedOutput() const {
+	return funcsWithCachedOutput;
+}
+
+/**
+* @brief Marks the output of the given function as taken from the cache of
+*        function outputs.
+*/
+void Module::markFuncOutputAsCached(ShPtr<Function> func) {
+	funcsWithCachedOutput.insert(func);
+}
+
+/**
+* @brief Marks the output of the given function as not taken from the cache of
+*        function outputs, i.e. the function has to be optimized and emitted.
+*/
+void Module::unmarkFuncOutputAsCached(ShPtr<Function> func) {
+	funcsWithCachedOutput.erase(func);
+}
+
+/**
+* @brief Can optimizations remove the given global variable or function?
+*
+* A function is given by its variable (see Function::getAsVar()). Removal is
+* prevented, for example, for global variables and functions that are referred
+* to by the code of functions taken from the cache of function outputs.
+*/
+bool Module::canRemoveVar(ShPtr<Variable> var) const {
+	return !hasItem(varsPreventedFromRemoval, var);
+}
+
+/**
+* @brief Prevents optimizations from removing the given global variable or
+*        function.
+*
+* See canRemoveVar() for more details.
+*/
+void Module::preventRemovalOfVar(ShPtr<Variable> var) {
+	varsPreventedFromRemoval.insert(var);
+}
+
 /**
 * @brief Returns the real name of the given function.
 *
@@ -853,6 +916,7 @@ bool Module::hasAssignedDebugName(ShPtr<Variable> var) const {
 * The new name overwrites any name that has already been set for @a var.
 */
 void Module::addDebugNameForVar(ShPtr<Variable> var, const std::string &name) {
+	ModificationRecorder::recordModification();
 	debugVarNameMap[var] = name;
 }
 
@@ -889,5 +953,68 @@ std::string Module::getDetectedLanguage() const {
 	return config->getDetectedLanguage();
 }
 
+/**
+* @brief Returns the current modification epoch.
+*
+* It changes whenever a function is marked as modified, so if it is the same
+* before and after an optimization, the optimization has modified nothing.
+*/
+std::size_t Module::getModificationEpoch() const {
+	return modificationEpoch;
+}
+
+/**
+* @brief Marks the given function as modified.
+*/
+void Module::markFuncAsModified(ShPtr<Function> func) {
+	funcModificationEpochs[func] = ++modificationEpoch;
+}
+
+/**
+* @brief Marks all functions as modified.
+*
+* Use it after modifications that cannot be attributed to particular
+* functions (e.g. modifications of global variables).
+*/
+void Module::markAllFuncsAsModified() {
+	allFuncsModificationEpoch = ++modificationEpoch;
+}
+
+/**
+* @brief Records that the optimizer with @a optId has optimized @a func
+*        without modifying it.
+*
+* @see isFuncOptimizedBy()
+*/
+void Module::markFuncAsOptimizedBy(ShPtr<Function> func,
+		const std::string &optId) {
+	funcOptimizationEpochs[optId][func] = modificationEpoch;
+}
+
+/**
+* @brief Returns @c true if the optimizer with @a optId has optimized @a func
+*        without modifying it and @a func has not been modified since then,
+*        @c false otherwise.
+*
+* If the optimizer is deterministic and it depends only on the optimized
+* function, running it on @a func again would not modify anything.
+*/
+bool Module::isFuncOptimizedBy(ShPtr<Function> func,
+		const std::string &optId) const {
+	auto optEpochs = funcOptimizationEpochs.find(optId);
+	if (optEpochs == funcOptimizationEpochs.end()) {
+		return false;
+	}
+	auto optEpoch = optEpochs->second.find(func);
+	if (optEpoch == optEpochs->second.end()) {
+		return false;
+	}
+
+	auto modEpoch = funcModificationEpochs.find(func);
+	return optEpoch->second >= allFuncsModificationEpoch &&
+		(modEpoch == funcModificationEpochs.end() ||
+			optEpoch->second >= modEpoch->second);
+}
+
 } // namespace llvmir2hll
 } // namespace retdec
@@ -6,6 +6,7 @@
 
 #include "retdec/llvmir2hll/ir/pointer_type.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/visitor.h"
 
 namespace retdec {
@@ -40,6 +41,7 @@ bool PointerType::isEqualTo(ShPtr<Value> otherValue) const {
 void PointerType::setContainedType(ShPtr<Type> newContainedType) {
 	PRECONDITION_NON_NULL(newContainedType);
 
+	ModificationRecorder::recordModification();
 	containedType = newContainedType;
 }
 
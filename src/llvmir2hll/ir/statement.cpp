@@ -10,6 +10,7 @@
 #include "retdec/llvmir2hll/ir/statement.h"
 #include "retdec/llvmir2hll/llvm/llvm_support.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/utils/conversion.h"
 
 namespace retdec {
@@ -55,6 +56,7 @@ Statement::Statement(Address a):
 * discarded, use appendStatement() instead.
 */
 void Statement::setSuccessor(ShPtr<Statement> newSucc) {
+	ModificationRecorder::recordModification();
 	if (succ) {
 		// Update the predecessors of the old successor.
 		succ->preds.erase(succ);
@@ -235,6 +237,7 @@ bool Statement::hasPredecessors() const {
 * comes handy in terms of goto statements.
 */
 void Statement::addPredecessor(ShPtr<Statement> stmt) {
+	ModificationRecorder::recordModification();
 	preds.insert(stmt);
 }
 
@@ -587,6 +590,7 @@ ShPtr<Statement> Statement::getLastStatement(ShPtr<Statement> stmts) {
 * nothing.
 */
 void Statement::removePredecessor(ShPtr<Statement> stmt) {
+	ModificationRecorder::recordModification();
 	preds.erase(stmt);
 }
 
@@ -599,6 +603,7 @@ void Statement::removePredecessor(ShPtr<Statement> stmt) {
 * doesn't delete them.
 */
 void Statement::removePredecessors(bool onlyNonGoto) {
+	ModificationRecorder::recordModification();
 	if (!onlyNonGoto) {
 		preds.clear();
 		return;
@@ -708,6 +713,7 @@ bool Statement::isGotoTarget() const {
 void Statement::redirectGotosTo(ShPtr<Statement> stmt) {
 	PRECONDITION_NON_NULL(stmt);
 
+	ModificationRecorder::recordModification();
 	// We need to iterate over a copy of predecessors because we may need to
 	// modify them during the iteration.
 	for (auto pred : StmtSet(preds)) {
@@ -739,6 +745,7 @@ std::string Statement::getLabel() const {
 * @brief Removes the statement's label (if any).
 */
 void Statement::removeLabel() {
+	ModificationRecorder::recordModification();
 	label.clear();
 }
 
@@ -751,6 +758,7 @@ void Statement::removeLabel() {
 void Statement::setLabel(const std::string &newLabel) {
 	PRECONDITION(!newLabel.empty(), "the statement's label cannot be empty");
 
+	ModificationRecorder::recordModification();
 	label = newLabel;
 }
 
@@ -758,6 +766,7 @@ void Statement::setLabel(const std::string &newLabel) {
 * @brief Transfers the label from the given statement to the current statement.
 */
 void Statement::transferLabelFrom(ShPtr<Statement> stmt) {
+	ModificationRecorder::recordModification();
 	label = stmt->label;
 	stmt->label.clear();
 }
@@ -766,6 +775,7 @@ void Statement::transferLabelFrom(ShPtr<Statement> stmt) {
 * @brief Transfers the label from the current statement to the given statement.
 */
 void Statement::transferLabelTo(ShPtr<Statement> stmt) {
+	ModificationRecorder::recordModification();
 	stmt->label = label;
 	label.clear();
 }
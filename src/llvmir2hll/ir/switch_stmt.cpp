@@ -8,6 +8,7 @@
 #include "retdec/llvmir2hll/ir/switch_stmt.h"
 #include "retdec/llvmir2hll/ir/variable.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/visitor.h"
 
 namespace retdec {
@@ -227,6 +228,7 @@ ShPtr<Statement> SwitchStmt::getDefaultClauseBody() const {
 *  - @a body is non-null
 */
 void SwitchStmt::addDefaultClause(ShPtr<Statement> body) {
+	ModificationRecorder::recordModification();
 	PRECONDITION_NON_NULL(body);
 	PRECONDITION(!hasDefaultClause(),
 		"adding a default clause when there already is one");
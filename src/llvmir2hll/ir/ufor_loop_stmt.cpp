@@ -7,6 +7,7 @@
 #include "retdec/llvmir2hll/ir/expression.h"
 #include "retdec/llvmir2hll/ir/ufor_loop_stmt.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/visitor.h"
 
 namespace retdec {
@@ -171,6 +172,7 @@ bool UForLoopStmt::isInitDefinition() const {
 *        variable assigned in the part.
 */
 void UForLoopStmt::markInitAsDefinition() {
+	ModificationRecorder::recordModification();
 	initIsDefinition = true;
 }
 
@@ -8,6 +8,7 @@
 #include "retdec/llvmir2hll/ir/var_def_stmt.h"
 #include "retdec/llvmir2hll/ir/variable.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/visitor.h"
 
 namespace retdec {
@@ -115,6 +116,7 @@ void VarDefStmt::setInitializer(ShPtr<Expression> newInit) {
 * @brief Removes the initializer.
 */
 void VarDefStmt::removeInitializer() {
+	ModificationRecorder::recordModification();
 	setInitializer(ShPtr<Expression>());
 }
 
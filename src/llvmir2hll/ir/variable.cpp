@@ -7,6 +7,7 @@
 #include "retdec/llvmir2hll/ir/type.h"
 #include "retdec/llvmir2hll/ir/variable.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/visitor.h"
 
 namespace retdec {
@@ -124,6 +125,7 @@ ShPtr<Variable> Variable::copy() const {
 * @brief Sets the variable's name to @a newName.
 */
 void Variable::setName(const std::string &newName) {
+	ModificationRecorder::recordModification();
 	name = newName;
 }
 
@@ -136,10 +138,12 @@ void Variable::setName(const std::string &newName) {
 void Variable::setType(ShPtr<Type> newType) {
 	PRECONDITION_NON_NULL(newType);
 
+	ModificationRecorder::recordModification();
 	type = std::move(newType);
 }
 
 void Variable::setAddress(Address a) {
+	ModificationRecorder::recordModification();
 	address = a;
 }
 
@@ -150,6 +154,7 @@ void Variable::setAddress(Address a) {
 * internal variables.
 */
 void Variable::markAsInternal() {
+	ModificationRecorder::recordModification();
 	internal = true;
 }
 
@@ -160,6 +165,7 @@ void Variable::markAsInternal() {
 * external variables.
 */
 void Variable::markAsExternal() {
+	ModificationRecorder::recordModification();
 	internal = false;
 }
 
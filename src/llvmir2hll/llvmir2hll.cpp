@@ -1,14 +1,21 @@
 
 #include <algorithm>
 #include <fstream>
+#include <map>
 #include <memory>
+#include <sstream>
 
 #include "retdec/llvmir2hll/llvmir2hll.h"
+#include "retdec/llvmir2hll/ir/global_var_def.h"
+#include "retdec/llvmir2hll/support/statements_counter.h"
+#include "retdec/llvmir2hll/support/value_allocator.h"
 #include "retdec/utils/io/log.h"
+#include "retdec/utils/scope_exit.h"
 
 using namespace llvm;
 using namespace retdec::utils::io;
 using retdec::llvmir2hll::ShPtr;
+using retdec::utils::getNumberOfJobs;
 using retdec::utils::hasItem;
 using retdec::utils::joinStrings;
 using retdec::utils::limitSystemMemory;
@@ -150,23 +157,28 @@ void LlvmIr2Hll::getAnalysisUsage(llvm::AnalysisUsage &au) const
 bool LlvmIr2Hll::runOnModule(llvm::Module &m)
 {
 	Log::phase("initialization");
+	startProfiledPhase("initialize");
 
 	bool decompilationShouldContinue = initialize(m);
 	if (!decompilationShouldContinue)
 	{
+		stopProfiledPhase();
 		return false;
 	}
 
 	Log::phase("conversion of LLVM IR into BIR");
+	startProfiledPhase("convertLLVMIRToBIR");
 	decompilationShouldContinue = convertLLVMIRToBIR();
 	if (!decompilationShouldContinue)
 	{
+		stopProfiledPhase();
 		return false;
 	}
 
 	if (!globalConfig->parameters.isBackendKeepLibraryFuncs())
 	{
 		Log::phase("removing functions from standard libraries");
+		startProfiledPhase("removeLibraryFuncs");
 		removeLibraryFuncs();
 	}
 
@@ -176,77 +188,136 @@ bool LlvmIr2Hll::runOnModule(llvm::Module &m)
 	// unreachable code. This causes problems later during optimizations
 	// because the code exists in BIR, but not in a CFG.
 	Log::phase("removing code that is not reachable in a CFG");
+	startProfiledPhase("removeCodeUnreachableInCFG");
 	removeCodeUnreachableInCFG();
 
 	Log::phase("signed/unsigned types fixing");
+	startProfiledPhase("fixSignedUnsignedTypes");
 	fixSignedUnsignedTypes();
 
 	Log::phase("converting LLVM intrinsic functions to standard functions");
+	startProfiledPhase("convertLLVMIntrinsicFunctions");
 	convertLLVMIntrinsicFunctions();
 
 	if (resModule->isDebugInfoAvailable())
 	{
 		Log::phase("obtaining debug information");
+		startProfiledPhase("obtainDebugInfo");
 		obtainDebugInfo();
 	}
 
+	if (!globalConfig->parameters.getCacheDir().empty())
+	{
+		Log::phase("loading cached outputs of functions");
+		startProfiledPhase("loadCachedFuncOutputs");
+		loadCachedFuncOutputs();
+	}
+
 	if (!globalConfig->parameters.isBackendNoOpts())
 	{
 		Log::phase("alias analysis [" + aliasAnalysis->getId() + "]");
+		startProfiledPhase("initAliasAnalysis");
 		initAliasAnalysis();
 
 		Log::phase("optimizations");
+		startProfiledPhase("runOptimizations");
 		runOptimizations();
 	}
 
 	if (!globalConfig->parameters.isBackendNoVarRenaming())
 	{
 		Log::phase("variable renaming [" + varRenamer->getId() + "]");
+		startProfiledPhase("renameVariables");
 		renameVariables();
 	}
 
 	if (!globalConfig->parameters.isBackendNoSymbolicNames())
 	{
 		Log::phase("converting constants to symbolic names");
+		startProfiledPhase("convertConstantsToSymbolicNames");
 		convertConstantsToSymbolicNames();
 	}
 
 	if (ValidateModule)
 	{
 		Log::phase("module validation");
+		startProfiledPhase("validateResultingModule");
 		validateResultingModule();
 	}
 
 	if (!FindPatterns.empty())
 	{
 		Log::phase("finding patterns");
+		startProfiledPhase("findPatterns");
 		findPatterns();
 	}
 
 	if (globalConfig->parameters.isBackendEmitCfg())
 	{
 		Log::phase("emission of control-flow graphs");
+		startProfiledPhase("emitCFGs");
 		emitCFGs();
 	}
 
 	if (globalConfig->parameters.isBackendEmitCg())
 	{
 		Log::phase("emission of a call graph");
+		startProfiledPhase("emitCG");
 		emitCG();
 	}
 
 	Log::phase("emission of the target code [" + hllWriter->getId() + "]");
+	startProfiledPhase("emitTargetHLLCode");
 	emitTargetHLLCode();
 
 	Log::phase("finalization");
+	startProfiledPhase("finalize");
 	finalize();
 
 	Log::phase("cleanup");
+	startProfiledPhase("cleanup");
 	cleanup();
+	stopProfiledPhase();
 
 	return false;
 }
 
+/**
+* @brief Stops profiling of the current phase (if any) and starts profiling of
+*        the phase @a name.
+*
+* Phases are profiled only if the profiler is enabled.
+*/
+void LlvmIr2Hll::startProfiledPhase(const std::string &name)
+{
+	stopProfiledPhase();
+	profiledPhase.emplace(name);
+}
+
+/**
+* @brief Stops profiling of the current phase (if any).
+*
+* The numbers of functions and statements in the resulting module are
+* recorded with the phase.
+*/
+void LlvmIr2Hll::stopProfiledPhase()
+{
+	if (!profiledPhase)
+	{
+		return;
+	}
+
+	profiledPhase->stop();
+	if (profiledPhase->isActive() && resModule)
+	{
+		profiledPhase->setCounts(
+			resModule->getNumOfFuncDefinitions(),
+			llvmir2hll::StatementsCounter::count(resModule)
+		);
+	}
+	profiledPhase.reset();
+}
+
 /**
 * @brief Initializes all the needed private variables.
 *
@@ -582,6 +653,63 @@ void LlvmIr2Hll::obtainDebugInfo()
 	llvmir2hll::LLVMDebugInfoObtainer::obtainVarNames(resModule);
 }
 
+/**
+* @brief Loads the already emitted code of functions from the cache.
+*
+* Functions whose code is found in the cache are neither optimized nor
+* emitted again.
+*/
+void LlvmIr2Hll::loadCachedFuncOutputs()
+{
+	funcOutputCache = std::make_shared<llvmir2hll::FuncOutputCache>(
+			globalConfig->parameters.getCacheDir(),
+			globalConfig->parameters.getCacheMaxSize(),
+			getFuncOutputCacheContext()
+	);
+	auto numOfCachedFuncs = funcOutputCache->loadOutputs(
+			resModule,
+			*llvmModule,
+			*globalConfig
+	);
+	hllWriter->setFuncOutputCache(funcOutputCache);
+
+	Log::phase(
+		"found " + std::to_string(numOfCachedFuncs) + " of "
+			+ std::to_string(resModule->getNumOfFuncDefinitions())
+			+ " functions in the cache",
+		Log::SubPhase
+	);
+}
+
+/**
+* @brief Returns the options that affect the code emitted for functions.
+*
+* The code of functions is taken from the cache only when it was emitted with
+* the same options.
+*/
+std::string LlvmIr2Hll::getFuncOutputCacheContext() const
+{
+	const auto &params = globalConfig->parameters;
+	std::ostringstream context;
+	context << TargetHLL << "\n"
+		<< Debug << EmitDebugComments
+		<< params.isBackendNoOpts()
+		<< params.isBackendKeepAllBrackets()
+		<< params.isBackendKeepLibraryFuncs()
+		<< params.isBackendNoTimeVaryingInfo()
+		<< params.isBackendNoVarRenaming()
+		<< params.isBackendNoCompoundOperators()
+		<< params.isBackendNoSymbolicNames() << "\n"
+		<< params.getBackendEnabledOpts() << "\n"
+		<< params.getBackendDisabledOpts() << "\n"
+		<< params.getBackendCallInfoObtainer() << "\n"
+		<< params.getBackendVarRenamer() << "\n"
+		<< oVarNameGen << " " << VarNameGenPrefix << "\n"
+		<< oAliasAnalysis << " " << oArithmExprEvaluator << "\n"
+		<< oSemantics;
+	return context.str();
+}
+
 /**
 * @brief Initializes the alias analysis.
 */
@@ -592,9 +720,77 @@ void LlvmIr2Hll::initAliasAnalysis()
 
 /**
 * @brief Runs the optimizations over the resulting module.
+*
+* Functions whose code is taken from the cache are not optimized, see
+* runOptimizationsWithoutFuncs().
 */
 void LlvmIr2Hll::runOptimizations()
 {
+	runOptimizationsWithoutFuncs(resModule->getFuncsWithCachedOutput());
+	if (!funcOutputCache)
+	{
+		return;
+	}
+
+	// Optimizations keep global variables and functions that the code from
+	// the cache refers to. Should anything still be missing, the function is
+	// optimized now and emitted normally. Other functions have already been
+	// optimized, so nothing is removed from the module this time.
+	auto uncachedFuncs = funcOutputCache->dropUnusableOutputs();
+	if (uncachedFuncs.empty())
+	{
+		return;
+	}
+
+	Log::phase(
+		"optimizing " + std::to_string(uncachedFuncs.size())
+			+ " functions whose cached outputs cannot be used",
+		Log::SubPhase
+	);
+	llvmir2hll::FuncSet otherFuncs;
+	for (auto i = resModule->func_begin(), e = resModule->func_end();
+			i != e; ++i)
+	{
+		resModule->preventRemovalOfVar((*i)->getAsVar());
+		if (!hasItem(uncachedFuncs, *i))
+		{
+			otherFuncs.insert(*i);
+		}
+	}
+	for (auto i = resModule->global_var_begin(), e = resModule->global_var_end();
+			i != e; ++i)
+	{
+		resModule->preventRemovalOfVar((*i)->getVar());
+	}
+	runOptimizationsWithoutFuncs(otherFuncs);
+}
+
+/**
+* @brief Runs the optimizations over the resulting module, except for the
+*        given functions.
+*
+* Bodies of @a funcs are hidden from the optimizations (the functions are
+* temporarily converted into declarations), so the optimizations neither change
+* them nor take them into account when optimizing other functions.
+*/
+void LlvmIr2Hll::runOptimizationsWithoutFuncs(const llvmir2hll::FuncSet &funcs)
+{
+	std::map<ShPtr<llvmir2hll::Function>, ShPtr<llvmir2hll::Statement>> bodies;
+	for (const auto &func : funcs)
+	{
+		if (func->isDefinition())
+		{
+			bodies.emplace(func, func->getBody());
+			func->convertToDeclaration();
+		}
+	}
+	SCOPE_EXIT {
+		for (const auto &p : bodies)
+		{
+			p.first->setBody(p.second);
+		}
+	};
+
 	ShPtr<llvmir2hll::OptimizerManager> optManager(
 			new llvmir2hll::OptimizerManager(
 					parseListOfOpts(globalConfig->parameters.getBackendEnabledOpts()),
@@ -603,7 +799,8 @@ void LlvmIr2Hll::runOptimizations()
 					llvmir2hll::ValueAnalysis::create(aliasAnalysis, true),
 					cio,
 					arithmExprEvaluator,
-					Debug
+					Debug,
+					getNumberOfJobs(globalConfig->parameters.getJobs())
 			)
 	);
 	optManager->optimize(resModule);
@@ -687,6 +884,7 @@ void LlvmIr2Hll::finalize()
 {
 	saveConfig();
 	if (outFile) outFile->keep();
+	if (funcOutputCache) funcOutputCache->evict();
 }
 
 /**
@@ -694,12 +892,22 @@ void LlvmIr2Hll::finalize()
 */
 void LlvmIr2Hll::cleanup()
 {
-	// Nothing to do.
-
-	// Note: Do not remove this phase, even if there is nothing to do. The
-	// presence of this phase is needed for the analyzing scripts in
-	// scripts/decompiler_tests (it marks the very last phase of a successful
-	// decompilation).
+	// Destroy the resulting module and everything that refers to its values,
+	// so that the memory of the values can be returned to the system. This
+	// matters when several files are decompiled in a single process.
+	varRenamer.reset();
+	varNameGen.reset();
+	arithmExprEvaluator.reset();
+	cio.reset();
+	aliasAnalysis.reset();
+	funcOutputCache.reset();
+	hllWriter.reset();
+	resModule.reset();
+	llvmir2hll::ValueAllocator::trim();
+
+	// Note: Do not remove this phase. The presence of this phase is needed for
+	// the analyzing scripts in scripts/decompiler_tests (it marks the very
+	// last phase of a successful decompilation).
 }
 
 /**
@@ -4,14 +4,32 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <vector>
+
 #include "retdec/llvmir2hll/ir/function.h"
 #include "retdec/llvmir2hll/ir/module.h"
 #include "retdec/llvmir2hll/optimizer/func_optimizer.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
+#include "retdec/llvmir2hll/support/subject.h"
+#include "retdec/utils/parallel.h"
 
 namespace retdec {
 namespace llvmir2hll {
 
+namespace {
+
+/**
+* @brief Enables locking of observers of subjects for its lifetime.
+*/
+class SubjectLocksGuard {
+public:
+	SubjectLocksGuard() { SubjectLocks::enable(true); }
+	~SubjectLocksGuard() { SubjectLocks::enable(false); }
+};
+
+} // anonymous namespace
+
 /**
 * @brief Constructs a new function optimizer.
 *
@@ -21,10 +39,39 @@ namespace llvmir2hll {
 *  - @a module is non-null
 */
 FuncOptimizer::FuncOptimizer(ShPtr<Module> module):
-	Optimizer(module), currFunc() {
+	Optimizer(module), currFunc(), fixedPointReached(false), jobs(1),
+	createOptimizer(), skipUnmodifiedFuncs(false) {
 		PRECONDITION_NON_NULL(module);
 	}
 
+/**
+* @brief Makes the optimizer optimize functions in parallel.
+*
+* @param[in] jobs Maximal number of functions optimized in parallel.
+* @param[in] createOptimizer Creates a new instance of the optimizer. Every
+*                            function is optimized by its own instance.
+*
+* The optimizer has to be safe to be run in parallel on different functions
+* (see the class description). If @a jobs is lower than 2, the functions are
+* optimized serially.
+*/
+void FuncOptimizer::enableParallelOptimization(unsigned jobs,
+		FuncOptimizerFactory createOptimizer) {
+	this->jobs = jobs;
+	this->createOptimizer = createOptimizer;
+}
+
+/**
+* @brief Makes the optimizer skip functions that it has already optimized
+*        without modifying them and that have not been modified since then.
+*
+* The optimizer has to be deterministic and its result has to depend only on
+* the optimized function (see the class description).
+*/
+void FuncOptimizer::enableSkippingOfUnmodifiedFuncs() {
+	skipUnmodifiedFuncs = true;
+}
+
 /**
 * @brief Performs the optimization on all functions in the module.
 *
@@ -34,9 +81,20 @@ FuncOptimizer::FuncOptimizer(ShPtr<Module> module):
 * optimized; otherwise, just override runOnFunction().
 */
 void FuncOptimizer::doOptimization() {
+	if (jobs > 1 && createOptimizer) {
+		optimizeFuncsInParallel();
+		return;
+	}
+
 	// For each function in the module...
 	for (auto i = module->func_begin(), e = module->func_end(); i != e; ++i) {
-		runOnFunction(*i);
+		if (shouldBeOptimized(*i)) {
+			ModificationRecorder modifications;
+			fixedPointReached = false;
+			runOnFunction(*i);
+			recordOptimizationOf(*i, modifications.hasModifications(),
+				fixedPointReached);
+		}
 	}
 }
 
@@ -53,5 +111,71 @@ void FuncOptimizer::runOnFunction(ShPtr<Function> func) {
 	func->accept(this);
 }
 
+/**
+* @brief Optimizes all functions in the module in parallel.
+*
+* Since every function is optimized by its own instance of the optimizer and
+* the optimizations of functions are independent, the result is the same as if
+* the functions were optimized serially.
+*/
+void FuncOptimizer::optimizeFuncsInParallel() {
+	FuncVector funcs;
+	for (auto i = module->func_begin(), e = module->func_end(); i != e; ++i) {
+		if (shouldBeOptimized(*i)) {
+			funcs.push_back(*i);
+		}
+	}
+
+	// Modifications are recorded by every thread separately, so they are
+	// attributed to the functions after all of them have been optimized.
+	std::vector<char> modified(funcs.size(), false);
+	std::vector<char> fixedPointsReached(funcs.size(), false);
+	{
+		SubjectLocksGuard subjectLocksGuard;
+		retdec::utils::parallelFor(funcs.size(), jobs, [&](std::size_t i) {
+			ModificationRecorder modifications;
+			auto optimizer = createOptimizer();
+			optimizer->runOnFunction(funcs[i]);
+			modified[i] = modifications.hasModifications();
+			fixedPointsReached[i] = optimizer->fixedPointReached;
+		});
+	}
+
+	for (std::size_t i = 0; i < funcs.size(); ++i) {
+		recordOptimizationOf(funcs[i], modified[i], fixedPointsReached[i]);
+	}
+}
+
+/**
+* @brief Should the given function be optimized?
+*/
+bool FuncOptimizer::shouldBeOptimized(ShPtr<Function> func) const {
+	// The output of functions taken from the cache is not emitted, so there
+	// is no need to optimize them.
+	if (module->isFuncOutputCached(func)) {
+		return false;
+	}
+
+	return !skipUnmodifiedFuncs || !module->isFuncOptimizedBy(func, getId());
+}
+
+/**
+* @brief Records the optimization of @a func into the module.
+*
+* @param[in] func Optimized function.
+* @param[in] modified Has @a func been modified during its optimization?
+* @param[in] fixedPointReached Would another optimization of @a func leave it
+*                              unmodified?
+*/
+void FuncOptimizer::recordOptimizationOf(ShPtr<Function> func,
+		bool modified, bool fixedPointReached) {
+	if (modified) {
+		module->markFuncAsModified(func);
+	}
+	if (skipUnmodifiedFuncs && (!modified || fixedPointReached)) {
+		module->markFuncAsOptimizedBy(func, getId());
+	}
+}
+
 } // namespace llvmir2hll
 } // namespace retdec
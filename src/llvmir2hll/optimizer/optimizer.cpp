@@ -7,6 +7,7 @@
 #include "retdec/llvmir2hll/ir/module.h"
 #include "retdec/llvmir2hll/optimizer/optimizer.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 
 namespace retdec {
 namespace llvmir2hll {
@@ -35,11 +36,19 @@ Optimizer::Optimizer(ShPtr<Module> module):
 *  (1) doInitialization()
 *  (2) doOptimization()
 *  (3) doFinalization()
+*
+* If the optimizer modifies the module and the modifications are not
+* attributed to particular functions (see FuncOptimizer), all functions in the
+* module are marked as modified.
 */
 ShPtr<Module> Optimizer::optimize() {
+	ModificationRecorder modifications;
 	doInitialization();
 	doOptimization();
 	doFinalization();
+	if (modifications.hasModifications()) {
+		module->markAllFuncsAsModified();
+	}
 	return module;
 }
 
@@ -8,6 +8,7 @@
 #include <thread>
 
 #include "retdec/llvmir2hll/analysis/value_analysis.h"
+#include "retdec/llvmir2hll/evaluator/arithm_expr_evaluator_factory.h"
 #include "retdec/llvmir2hll/graphs/cg/cg_builder.h"
 #include "retdec/llvmir2hll/hll/hll_writer.h"
 #include "retdec/llvmir2hll/obtainer/call_info_obtainer.h"
@@ -45,7 +46,9 @@
 #include "retdec/llvmir2hll/optimizer/optimizers/while_true_to_ufor_loop_optimizer.h"
 #include "retdec/llvmir2hll/optimizer/optimizers/while_true_to_while_cond_optimizer.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/statements_counter.h"
 #include "retdec/utils/container.h"
+#include "retdec/utils/profiler.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/system.h"
 #include "retdec/utils/io/log.h"
@@ -97,6 +100,8 @@ StringSet trimOptimizerSuffix(const StringSet &opts) {
 * @param[in] cio Call info obtainer.
 * @param[in] arithmExprEvaluator Used evaluator of arithmetical expressions.
 * @param[in] enableDebug Enables emission of debug messages.
+* @param[in] jobs Maximal number of functions optimized in parallel by
+*                 optimizations that can be run on functions independently.
 *
 * To perform the actual optimizations, call optimize(). To get a list of
 * available optimizations and their names, see our wiki.
@@ -116,12 +121,13 @@ StringSet trimOptimizerSuffix(const StringSet &opts) {
 OptimizerManager::OptimizerManager(const StringSet &enabledOpts,
 	const StringSet &disabledOpts, ShPtr<HLLWriter> hllWriter,
 	ShPtr<ValueAnalysis> va, ShPtr<CallInfoObtainer> cio,
-	ShPtr<ArithmExprEvaluator> arithmExprEvaluator, bool enableDebug):
+	ShPtr<ArithmExprEvaluator> arithmExprEvaluator, bool enableDebug,
+	unsigned jobs):
 		enabledOpts(trimOptimizerSuffix(enabledOpts)),
 		disabledOpts(trimOptimizerSuffix(disabledOpts)),
 		hllWriter(hllWriter), va(va), cio(cio),
 		arithmExprEvaluator(arithmExprEvaluator),
-		enableDebug(enableDebug),
+		enableDebug(enableDebug), jobs(jobs),
 		recoverFromOutOfMemory(true), backendRunOpts() {
 			PRECONDITION_NON_NULL(hllWriter);
 			PRECONDITION_NON_NULL(va);
@@ -139,6 +145,14 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	//
 	// Of course, if some optimization depend on another one, the order is
 	// clear.
+	//
+	// Optimizations run by runOnFuncsInParallel() optimize every function
+	// independently of the others and do not use any module-level analyses,
+	// so they may optimize functions in parallel without affecting the
+	// result. The same holds for optimizations run by
+	// runOnFuncsInParallelWithEvaluator(), which only get their own evaluator
+	// of arithmetical expressions. The other optimizations are always run
+	// serially.
 
 	//
 	// Perform HLL-independent optimizations.
@@ -146,11 +160,11 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	if (!enableDebug) {
 		// Since we will not emit debug comments, empty statements are useless,
 		// so we can remove them.
-		run<EmptyStmtOptimizer>(m);
+		runOnFuncsInParallel<EmptyStmtOptimizer>(m);
 	}
 
-	run<GotoStmtOptimizer>(m);
-	run<RemoveUselessCastsOptimizer>(m);
+	runOnFuncsInParallel<GotoStmtOptimizer>(m);
+	runOnFuncsInParallel<RemoveUselessCastsOptimizer>(m);
 
 	// Data-flow optimizations.
 	// The following optimizations should be run before CopyPropagation to
@@ -161,16 +175,16 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	run<CopyPropagationOptimizer>(m, va, cio);
 
 	// SimplifyArithmExprOptimizer should be run before loop optimizations.
-	run<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
+	runOnFuncsInParallelWithEvaluator<SimplifyArithmExprOptimizer>(m);
 
 	// Structure optimizations.
 	// IfStructureOptimizer should be run before loop optimizations because
 	// it may make induction variables easier to find.
-	run<IfStructureOptimizer>(m);
+	runOnFuncsInParallel<IfStructureOptimizer>(m);
 	// LoopLastContinueOptimizer should be run after IfStructureOptimizer
 	// because IfBeforeLoopOptimizer may introduce continue statements to the
 	// end of loops.
-	run<LoopLastContinueOptimizer>(m);
+	runOnFuncsInParallel<LoopLastContinueOptimizer>(m);
 	// PreWhileTrueLoopConvOptimizer should be run before other `while True`
 	// loop optimizers.
 	run<PreWhileTrueLoopConvOptimizer>(m, va);
@@ -188,20 +202,20 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 		run<WhileTrueToUForLoopOptimizer>(m, va);
 	}
 	#endif
-	run<WhileTrueToWhileCondOptimizer>(m);
+	runOnFuncsInParallel<WhileTrueToWhileCondOptimizer>(m);
 	run<IfBeforeLoopOptimizer>(m, va);
 
 	// The second part of removal of non-compound statements.
 	run<LLVMIntrinsicsOptimizer>(m);
-	run<VoidReturnOptimizer>(m);
-	run<BreakContinueReturnOptimizer>(m);
+	runOnFuncsInParallel<VoidReturnOptimizer>(m);
+	runOnFuncsInParallel<BreakContinueReturnOptimizer>(m);
 
 	// Expression optimizations.
 	run<BitShiftOptimizer>(m);
-	run<DerefAddressOptimizer>(m);
+	runOnFuncsInParallel<DerefAddressOptimizer>(m);
 	run<EmptyArrayToStringOptimizer>(m);
 	run<BitOpToLogOpOptimizer>(m, va);
-	run<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
+	runOnFuncsInParallelWithEvaluator<SimplifyArithmExprOptimizer>(m);
 
 	// Data-flow optimizations.
 	// Run the CopyPropagationOptimizer once more to produce more readable
@@ -217,7 +231,7 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	// This is best to be run after DeadLocalAssignOptimizer and
 	// CopyPropagationOptimizer because it can get rid of statements like `v =
 	// v`, where v is a variable.
-	run<SelfAssignOptimizer>(m);
+	runOnFuncsInParallel<SelfAssignOptimizer>(m);
 
 	// VarDefForLoopOptimizer and VarDefStmtOptimizer are utilized also if the
 	// output is Python because in this way, we may emit addresses of
@@ -225,21 +239,21 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	// Indeed, recall that in Python, we do not emit definitions without an
 	// initializer, so if we didn't move the definitions to the usages, there
 	// wouldn't be initializers.
-	run<VarDefForLoopOptimizer>(m);
+	runOnFuncsInParallel<VarDefForLoopOptimizer>(m);
 	run<VarDefStmtOptimizer>(m, va);
 
-	run<EmptyStmtOptimizer>(m);
-	run<GotoStmtOptimizer>(m);
+	runOnFuncsInParallel<EmptyStmtOptimizer>(m);
+	runOnFuncsInParallel<GotoStmtOptimizer>(m);
 
 	// SimplifyArithmExprOptimizer should be run at the end to produce the most
 	// readable output.
-	run<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
+	runOnFuncsInParallelWithEvaluator<SimplifyArithmExprOptimizer>(m);
 
 	// DeadCodeOptimizer should be run at the end because it is better when
 	// SimplifyArithmExprOptimizer optimizes expressions in conditions and then
 	// DeadCodeOptimizer is called. The same holds for
 	// DerefToArrayIndexOptimizer and IfToSwitchOptimizer.
-	run<DeadCodeOptimizer>(m, arithmExprEvaluator);
+	runOnFuncsInParallelWithEvaluator<DeadCodeOptimizer>(m);
 	run<DerefToArrayIndexOptimizer>(m);
 	run<IfToSwitchOptimizer>(m, va);
 
@@ -247,7 +261,7 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	// Perform final, HLL-dependent optimizations.
 	//
 	run<CCastOptimizer>(m);
-	run<CArrayArgOptimizer>(m);
+	runOnFuncsInParallel<CArrayArgOptimizer>(m);
 }
 
 /**
@@ -269,16 +283,24 @@ bool OptimizerManager::optShouldBeRun(const std::string &optId) const {
 }
 
 /**
-* @brief Runs the given optimizer provided that it should be run.
+* @brief Runs the given optimizer of @a m provided that it should be run.
 */
-void OptimizerManager::runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimizer) {
+void OptimizerManager::runOptimizerProvidedItShouldBeRun(ShPtr<Module> m,
+		ShPtr<Optimizer> optimizer) {
 	const std::string OPT_ID = optimizer->getId();
 	if (!optShouldBeRun(OPT_ID)) {
 		return;
 	}
 
 	printOptimization(OPT_ID);
+	retdec::utils::Profiler::Scope profile(OPT_ID + OPT_SUFFIX);
+
+	// If the optimization modifies nothing, the results of value analysis
+	// remain valid even if the optimization invalidates them.
+	auto modificationEpoch = m->getModificationEpoch();
+	bool vaWasInValidState = va->isInValidState();
 
+	ShPtr<Module> module;
 	if (recoverFromOutOfMemory) {
 		// Some optimizations, most notable CopyPropagation, may run out of
 		// memory on huge inputs. We try to recover from such situations by
@@ -287,14 +309,25 @@ void OptimizerManager::runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimi
 		// memory requirements of the optimizations, or to generate smaller
 		// code in the first place.
 		try {
-			optimizer->optimize();
+			module = optimizer->optimize();
 		} catch (const std::bad_alloc &) {
 			Log::error() << Log::Warning << "out of memory; trying to recover" << std::endl;
 			std::this_thread::sleep_for(std::chrono::seconds(1));
 		}
 	} else {
 		// Just run the optimizer and let std::bad_alloc propagate.
-		optimizer->optimize();
+		module = optimizer->optimize();
+	}
+
+	if (module && vaWasInValidState &&
+			module->getModificationEpoch() == modificationEpoch) {
+		va->validateState();
+	}
+
+	profile.stop();
+	if (profile.isActive() && module) {
+		profile.setCounts(module->getNumOfFuncDefinitions(),
+			StatementsCounter::count(module));
 	}
 
 	backendRunOpts.insert(OPT_ID);
@@ -353,7 +386,71 @@ template<typename Optimization, typename... Args>
 void OptimizerManager::run(ShPtr<Module> m, Args &&... args) {
 	auto optimizer = std::make_shared<Optimization>(m,
 		std::forward<Args>(args)...);
-	runOptimizerProvidedItShouldBeRun(optimizer);
+	runOptimizerProvidedItShouldBeRun(m, optimizer);
+}
+
+/**
+* @brief Runs the given function optimization (specified in the template
+*        parameter) over @a m, optimizing functions in parallel.
+*
+* @tparam Optimization Function optimization to be performed. It has to be
+*                      safe to be run in parallel on different functions (see
+*                      FuncOptimizer).
+*
+* @param[in] m Module to be optimized.
+*
+* The same as run(), except that functions are optimized in parallel if more
+* than one job is allowed.
+*/
+template<typename Optimization>
+void OptimizerManager::runOnFuncsInParallel(ShPtr<Module> m) {
+	auto optimizer = std::make_shared<Optimization>(m);
+	optimizer->enableParallelOptimization(jobs, [m]() {
+		return std::make_shared<Optimization>(m);
+	});
+	// Such optimizations depend only on the optimized function, so functions
+	// that have not been modified since their last optimization can be
+	// skipped.
+	optimizer->enableSkippingOfUnmodifiedFuncs();
+	runOptimizerProvidedItShouldBeRun(m, optimizer);
+}
+
+/**
+* @brief Runs the given function optimization (specified in the template
+*        parameter), which uses the evaluator of arithmetical expressions,
+*        over @a m, optimizing functions in parallel.
+*
+* @tparam Optimization Function optimization to be performed. It has to be
+*                      constructible from the module and the evaluator and
+*                      safe to be run in parallel on different functions (see
+*                      FuncOptimizer).
+*
+* @param[in] m Module to be optimized.
+*
+* The same as runOnFuncsInParallel(), except that the optimization is given
+* the used evaluator. Evaluators keep state between evaluations, so every
+* instance optimizing a function in parallel gets its own evaluator of the same
+* type. If such an evaluator cannot be created, functions are optimized
+* serially.
+*/
+template<typename Optimization>
+void OptimizerManager::runOnFuncsInParallelWithEvaluator(ShPtr<Module> m) {
+	auto optimizer = std::make_shared<Optimization>(m, arithmExprEvaluator);
+	auto evaluatorId = arithmExprEvaluator->getId();
+	auto &evaluatorFactory = ArithmExprEvaluatorFactory::getInstance();
+	if (evaluatorFactory.createObject(evaluatorId)) {
+		optimizer->enableParallelOptimization(jobs,
+			[m, evaluatorId, &evaluatorFactory]() {
+				return std::make_shared<Optimization>(m,
+					evaluatorFactory.createObject(evaluatorId));
+			}
+		);
+	}
+	// Such optimizations depend only on the optimized function, so functions
+	// that have not been modified since their last optimization can be
+	// skipped.
+	optimizer->enableSkippingOfUnmodifiedFuncs();
+	runOptimizerProvidedItShouldBeRun(m, optimizer);
 }
 
 } // namespace llvmir2hll
@@ -38,7 +38,8 @@ void LLVMIntrinsicsOptimizer::doOptimization() {
 
 	// Remove the declarations of unused functions.
 	for (const auto &func : removedCalls) {
-		if (!hasItem(doNotRemoveFuncs, func)) {
+		if (!hasItem(doNotRemoveFuncs, func)
+				&& module->canRemoveVar(func->getAsVar())) {
 			module->removeFunc(func);
 		}
 	}
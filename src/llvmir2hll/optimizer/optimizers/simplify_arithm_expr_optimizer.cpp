@@ -28,6 +28,7 @@
 #include "retdec/llvmir2hll/ir/ternary_op_expr.h"
 #include "retdec/llvmir2hll/optimizer/optimizers/simplify_arithm_expr_optimizer.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "retdec/llvmir2hll/support/types.h"
 
 namespace retdec {
@@ -47,11 +48,15 @@ namespace llvmir2hll {
 */
 SimplifyArithmExprOptimizer::SimplifyArithmExprOptimizer(ShPtr<Module> module,
 		ShPtr<ArithmExprEvaluator> arithmExprEvaluator):
-			Optimizer(module) {
+			FuncOptimizer(module), codeChanged(false) {
 	PRECONDITION_NON_NULL(module);
 	PRECONDITION_NON_NULL(arithmExprEvaluator);
 
 	createSubOptimizers(arithmExprEvaluator);
+
+	// A function that has not been modified since we left it unchanged would
+	// be left unchanged again.
+	enableSkippingOfUnmodifiedFuncs();
 }
 
 void SimplifyArithmExprOptimizer::doOptimization() {
@@ -68,15 +73,27 @@ void SimplifyArithmExprOptimizer::doOptimization() {
 	}
 
 	// Visit all functions.
-	for (auto i = module->func_definition_begin(),
-			e = module->func_definition_end(); i != e; ++i) {
-		// Keep optimizing until there are no changes.
-		do {
-			codeChanged = false;
-			restart();
-			(*i)->accept(this);
-		} while (codeChanged);
+	FuncOptimizer::doOptimization();
+}
+
+void SimplifyArithmExprOptimizer::runOnFunction(ShPtr<Function> func) {
+	// Keep optimizing until there are no changes.
+	bool modified = false;
+	bool lastIterationModified = false;
+	do {
+		codeChanged = false;
+		ModificationRecorder modifications;
+		FuncOptimizer::runOnFunction(func);
+		lastIterationModified = modifications.hasModifications();
+		modified = modified || lastIterationModified;
+	} while (codeChanged);
+
+	// Modifications of the particular iterations are not propagated to the
+	// recorder of the caller.
+	if (modified) {
+		ModificationRecorder::recordModification();
 	}
+	fixedPointReached = !lastIterationModified;
 }
 
 void SimplifyArithmExprOptimizer::visit(ShPtr<AddOpExpr> expr) {
@@ -62,10 +62,13 @@ void UnusedGlobalVarOptimizer::computeUsedGlobalVars() {
 
 /**
 * @brief Removes unused global variables from the module.
+*
+* Global variables whose removal is prevented by the module (see
+* Module::canRemoveVar()) are kept.
 */
 void UnusedGlobalVarOptimizer::removeUnusedGlobalVars() {
 	for (auto &var : globalVars) {
-		if (!isUsed(var)) {
+		if (!isUsed(var) && module->canRemoveVar(var)) {
 			module->removeGlobalVar(var);
 		}
 	}
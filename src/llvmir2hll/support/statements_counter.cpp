@@ -58,6 +58,23 @@ unsigned StatementsCounter::count(ShPtr<Statement> block, bool recursive,
 	return counter->countInternal(block, recursive, includeEmptyStmts);
 }
 
+/**
+* @brief Returns the number of statements in bodies of all function
+*        definitions in @a module (including nested statements).
+*
+* @param[in] module Module whose statements are counted.
+* @param[in] includeEmptyStmts Count also empty statements?
+*/
+std::size_t StatementsCounter::count(ShPtr<Module> module,
+		bool includeEmptyStmts) {
+	std::size_t numOfStmts = 0;
+	for (auto i = module->func_definition_begin(),
+			e = module->func_definition_end(); i != e; ++i) {
+		numOfStmts += count((*i)->getBody(), true, includeEmptyStmts);
+	}
+	return numOfStmts;
+}
+
 /**
 * @brief Internal implementation of count().
 *
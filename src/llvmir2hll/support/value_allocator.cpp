@@ -0,0 +1,287 @@
+/**
+* @file src/llvmir2hll/support/value_allocator.cpp
+* @brief Implementation of ValueAllocator.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <map>
+#include <mutex>
+#include <new>
+
+#include "retdec/llvmir2hll/support/value_allocator.h"
+
+namespace retdec {
+namespace llvmir2hll {
+
+namespace {
+
+/// Sizes of blocks are multiples of this value.
+constexpr std::size_t GRANULARITY = alignof(std::max_align_t);
+
+/// Number of different sizes of blocks.
+constexpr std::size_t NUM_OF_SIZE_CLASSES =
+	ValueAllocator::MAX_POOLED_SIZE / GRANULARITY;
+
+/**
+* @brief A free block (its memory is reused for the link to the next one).
+*/
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+/**
+* @brief Free blocks of threads that have exited and the allocated chunks.
+*/
+struct GlobalPool {
+	std::mutex mutex;
+	FreeBlock *freeLists[NUM_OF_SIZE_CLASSES] = {};
+	/// Size classes of the allocated chunks, indexed by their starts.
+	std::map<char *, std::size_t> chunks;
+};
+
+/**
+* @brief Free blocks of the current thread.
+*/
+struct ThreadPool {
+	~ThreadPool();
+
+	FreeBlock *freeLists[NUM_OF_SIZE_CLASSES] = {};
+};
+
+/// Has the pool of the current thread been destroyed?
+thread_local bool threadPoolDestroyed = false;
+
+/// Pool of the current thread.
+thread_local ThreadPool threadPool;
+
+/**
+* @brief Returns the global pool.
+*
+* It is never destroyed because values may be freed during the destruction of
+* static objects.
+*/
+GlobalPool &getGlobalPool() {
+	static auto *pool = new GlobalPool();
+	return *pool;
+}
+
+/**
+* @brief Returns the index of the size class of blocks of @a size bytes.
+*/
+std::size_t getSizeClass(std::size_t size) {
+	return size == 0 ? 0 : (size - 1) / GRANULARITY;
+}
+
+/**
+* @brief Returns the size of blocks in the size class @a sizeClass.
+*/
+std::size_t getBlockSize(std::size_t sizeClass) {
+	return (sizeClass + 1) * GRANULARITY;
+}
+
+/**
+* @brief Prepends the list starting with @a first to @a list.
+*/
+void prependList(FreeBlock *&list, FreeBlock *first) {
+	if (!first) {
+		return;
+	}
+
+	FreeBlock *last = first;
+	while (last->next) {
+		last = last->next;
+	}
+	last->next = list;
+	list = first;
+}
+
+/**
+* @brief Hands over the free blocks of the exiting thread to other threads.
+*/
+ThreadPool::~ThreadPool() {
+	threadPoolDestroyed = true;
+
+	auto &globalPool = getGlobalPool();
+	std::lock_guard<std::mutex> lock(globalPool.mutex);
+	for (std::size_t i = 0; i < NUM_OF_SIZE_CLASSES; ++i) {
+		prependList(globalPool.freeLists[i], freeLists[i]);
+		freeLists[i] = nullptr;
+	}
+}
+
+/**
+* @brief Returns a non-empty list of free blocks in the size class
+*        @a sizeClass.
+*
+* The blocks are taken over from exited threads or carved from a new chunk.
+*/
+FreeBlock *obtainFreeBlocks(std::size_t sizeClass) {
+	auto &globalPool = getGlobalPool();
+	{
+		std::lock_guard<std::mutex> lock(globalPool.mutex);
+		if (auto *blocks = globalPool.freeLists[sizeClass]) {
+			globalPool.freeLists[sizeClass] = nullptr;
+			return blocks;
+		}
+	}
+
+	auto blockSize = getBlockSize(sizeClass);
+	auto *chunk = static_cast<char *>(
+		::operator new(ValueAllocator::CHUNK_SIZE));
+	{
+		std::lock_guard<std::mutex> lock(globalPool.mutex);
+		globalPool.chunks.emplace(chunk, sizeClass);
+	}
+	FreeBlock *blocks = nullptr;
+	for (std::size_t offset = ValueAllocator::CHUNK_SIZE / blockSize * blockSize;
+			offset > 0; offset -= blockSize) {
+		auto *block = reinterpret_cast<FreeBlock *>(chunk + offset - blockSize);
+		block->next = blocks;
+		blocks = block;
+	}
+	return blocks;
+}
+
+} // anonymous namespace
+
+/**
+* @brief Allocates a block of @a size bytes.
+*
+* @throws std::bad_alloc When there is not enough memory.
+*/
+void *ValueAllocator::allocate(std::size_t size) {
+	if (size > MAX_POOLED_SIZE) {
+		return ::operator new(size);
+	}
+
+	auto sizeClass = getSizeClass(size);
+	if (threadPoolDestroyed) {
+		// The block is put into the global pool when freed, so it has to have
+		// the size of blocks in its size class.
+		return ::operator new(getBlockSize(sizeClass));
+	}
+
+	auto &freeList = threadPool.freeLists[sizeClass];
+	if (!freeList) {
+		freeList = obtainFreeBlocks(sizeClass);
+	}
+	auto *block = freeList;
+	freeList = block->next;
+	return block;
+}
+
+/**
+* @brief Frees the block @a ptr of @a size bytes.
+*
+* @a ptr has to be obtained from allocate() with the same @a size.
+*/
+void ValueAllocator::deallocate(void *ptr, std::size_t size) noexcept {
+	if (!ptr) {
+		return;
+	}
+
+	if (size > MAX_POOLED_SIZE) {
+		::operator delete(ptr);
+		return;
+	}
+
+	auto *block = static_cast<FreeBlock *>(ptr);
+	auto sizeClass = getSizeClass(size);
+	if (threadPoolDestroyed) {
+		auto &globalPool = getGlobalPool();
+		std::lock_guard<std::mutex> lock(globalPool.mutex);
+		block->next = globalPool.freeLists[sizeClass];
+		globalPool.freeLists[sizeClass] = block;
+		return;
+	}
+
+	block->next = threadPool.freeLists[sizeClass];
+	threadPool.freeLists[sizeClass] = block;
+}
+
+/**
+* @brief Returns the number of chunks the blocks have been carved from.
+*/
+std::size_t ValueAllocator::getNumOfAllocatedChunks() {
+	auto &globalPool = getGlobalPool();
+	std::lock_guard<std::mutex> lock(globalPool.mutex);
+	return globalPool.chunks.size();
+}
+
+/**
+* @brief Returns chunks whose blocks are all free to the system.
+*
+* @return Number of returned chunks.
+*
+* Free blocks of the current thread and of exited threads are considered, so
+* it should be called when no other thread keeps free blocks (e.g. after all
+* values of a decompiled module have been destroyed). The remaining free
+* blocks are handed over to all threads.
+*/
+std::size_t ValueAllocator::trim() {
+	auto &globalPool = getGlobalPool();
+	std::lock_guard<std::mutex> lock(globalPool.mutex);
+
+	FreeBlock *freeLists[NUM_OF_SIZE_CLASSES] = {};
+	for (std::size_t i = 0; i < NUM_OF_SIZE_CLASSES; ++i) {
+		freeLists[i] = globalPool.freeLists[i];
+		globalPool.freeLists[i] = nullptr;
+		if (!threadPoolDestroyed) {
+			prependList(freeLists[i], threadPool.freeLists[i]);
+			threadPool.freeLists[i] = nullptr;
+		}
+	}
+
+	// Returns the start of the chunk containing the block (nullptr if it has
+	// been allocated from the heap after its thread's pool was destroyed).
+	auto getChunk = [&](FreeBlock *block) -> char * {
+		auto *ptr = reinterpret_cast<char *>(block);
+		auto it = globalPool.chunks.upper_bound(ptr);
+		if (it == globalPool.chunks.begin()) {
+			return nullptr;
+		}
+		--it;
+		return ptr < it->first + CHUNK_SIZE ? it->first : nullptr;
+	};
+
+	std::map<char *, std::size_t> numOfFreeBlocks;
+	for (auto *list : freeLists) {
+		for (auto *block = list; block; block = block->next) {
+			if (auto *chunk = getChunk(block)) {
+				++numOfFreeBlocks[chunk];
+			}
+		}
+	}
+	auto isChunkFree = [&](char *chunk) {
+		return numOfFreeBlocks.at(chunk)
+			== CHUNK_SIZE / getBlockSize(globalPool.chunks.at(chunk));
+	};
+
+	// Blocks have to be relinked before their chunks are freed.
+	for (std::size_t i = 0; i < NUM_OF_SIZE_CLASSES; ++i) {
+		for (auto *block = freeLists[i]; block;) {
+			auto *next = block->next;
+			auto *chunk = getChunk(block);
+			if (!chunk) {
+				::operator delete(block);
+			} else if (!isChunkFree(chunk)) {
+				block->next = globalPool.freeLists[i];
+				globalPool.freeLists[i] = block;
+			}
+			block = next;
+		}
+	}
+
+	std::size_t numOfFreedChunks = 0;
+	for (auto &p : numOfFreeBlocks) {
+		if (isChunkFree(p.first)) {
+			globalPool.chunks.erase(p.first);
+			::operator delete(p.first);
+			++numOfFreedChunks;
+		}
+	}
+	return numOfFreedChunks;
+}
+
+} // namespace llvmir2hll
+} // namespace retdec
@@ -18,7 +18,8 @@ namespace retdec {
 namespace loader {
 
 Image::Image(const std::shared_ptr<retdec::fileformat::FileFormat>& fileFormat) : _fileFormat(fileFormat), _segments(),
-	_baseAddress(0), _namelessSegNameGen("seg", '0', 4), _statusMessage()
+	_baseAddress(0), _namelessSegNameGen("seg", '0', 4), _statusMessage(),
+	_segmentIndex(), _segmentIndexValid(false), _segmentIndexMutex()
 {
 }
 
@@ -443,6 +444,7 @@ Segment* Image::insertSegment(std::unique_ptr<Segment> segment)
 	// Now give segment name
 	Segment* retSegment = _segments.back().get();
 	nameSegment(retSegment);
+	invalidateSegmentIndex();
 	return retSegment;
 }
 
@@ -453,6 +455,7 @@ void Image::removeSegment(Segment* segment)
 		if (itr->get() == segment)
 		{
 			_segments.erase(itr);
+			invalidateSegmentIndex();
 			return;
 		}
 	}
@@ -472,6 +475,16 @@ void Image::sortSegments()
 			{
 				return seg1->getAddress() < seg2->getAddress();
 			});
+	invalidateSegmentIndex();
+}
+
+/**
+ * Marks the index used by address lookups as outdated. It needs to be called whenever segments
+ * are added, removed, reordered or their address ranges change. The index is rebuilt on the next lookup.
+ */
+void Image::invalidateSegmentIndex()
+{
+	_segmentIndexValid.store(false, std::memory_order_release);
 }
 
 const Segment* Image::_getSegment(std::size_t index) const
@@ -506,13 +519,18 @@ const Segment* Image::_getSegmentWithIndex(std::size_t index) const
 
 const Segment* Image::_getSegmentFromAddress(std::uint64_t address) const
 {
-	for (const auto& segment : getSegments())
+	// Lookups may run in parallel once the image is loaded, so the index is built by one of them only.
+	if (!_segmentIndexValid.load(std::memory_order_acquire))
 	{
-		if (segment->containsAddress(address))
-			return segment.get();
+		std::lock_guard<std::mutex> lock(_segmentIndexMutex);
+		if (!_segmentIndexValid.load(std::memory_order_relaxed))
+		{
+			_segmentIndex.build(_segments);
+			_segmentIndexValid.store(true, std::memory_order_release);
+		}
 	}
 
-	return nullptr;
+	return _segmentIndex.find(address);
 }
 
 } // namespace loader
@@ -0,0 +1,105 @@
+/**
+ * @file src/loader/loader/segment_index.cpp
+ * @brief Definition of index for address lookup of segments.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+#include "retdec/loader/loader/segment_index.h"
+
+namespace retdec {
+namespace loader {
+
+/**
+ * Builds the index from the segments. Previous content of the index is discarded.
+ *
+ * @param segments Segments to index. Segments that precede others in the vector take precedence
+ *                 in the address ranges where they overlap.
+ */
+void SegmentIndex::build(const std::vector<std::unique_ptr<Segment>>& segments)
+{
+	_intervals.clear();
+
+	// Boundaries where segments start and end, together with the positions of segments in the vector.
+	std::vector<std::pair<std::uint64_t, std::size_t>> starts, ends;
+	starts.reserve(segments.size());
+	ends.reserve(segments.size());
+	for (std::size_t i = 0; i < segments.size(); ++i)
+	{
+		// Segments reaching the end of the address space cannot contain any address.
+		const auto& segment = segments[i];
+		if (segment->getAddress() >= segment->getEndAddress())
+			continue;
+
+		starts.emplace_back(segment->getAddress(), i);
+		ends.emplace_back(segment->getEndAddress(), i);
+	}
+
+	std::sort(starts.begin(), starts.end());
+	std::sort(ends.begin(), ends.end());
+
+	// Sweep the boundaries from the lowest address and keep the positions of segments that cover
+	// the current address. The segment with the lowest position owns the interval up to the next boundary.
+	std::set<std::size_t> active;
+	auto startItr = starts.begin();
+	auto endItr = ends.begin();
+	while (startItr != starts.end() || endItr != ends.end())
+	{
+		std::uint64_t address = endItr == ends.end() || (startItr != starts.end() && startItr->first < endItr->first)
+			? startItr->first : endItr->first;
+
+		for (; endItr != ends.end() && endItr->first == address; ++endItr)
+			active.erase(endItr->second);
+		for (; startItr != starts.end() && startItr->first == address; ++startItr)
+			active.insert(startItr->second);
+
+		if (active.empty())
+			continue;
+
+		// There is always an end boundary left while some segment is active.
+		std::uint64_t next = endItr->first;
+		if (startItr != starts.end())
+			next = std::min(next, startItr->first);
+
+		const Segment* segment = segments[*active.begin()].get();
+		if (!_intervals.empty() && _intervals.back().end == address && _intervals.back().segment == segment)
+			_intervals.back().end = next;
+		else
+			_intervals.push_back({address, next, segment});
+	}
+}
+
+/**
+ * Removes all segments from the index.
+ */
+void SegmentIndex::clear()
+{
+	_intervals.clear();
+}
+
+/**
+ * Returns the segment into which provided address falls, if any exists.
+ *
+ * @param address The address to check.
+ *
+ * @return Segment, otherwise nullptr.
+ */
+const Segment* SegmentIndex::find(std::uint64_t address) const
+{
+	// First interval that starts after the address. The address can only fall into the one before it.
+	auto itr = std::upper_bound(_intervals.begin(), _intervals.end(), address, [](std::uint64_t addr, const Interval& interval)
+			{
+				return addr < interval.start;
+			});
+	if (itr == _intervals.begin())
+		return nullptr;
+
+	--itr;
+	return address < itr->end ? itr->segment : nullptr;
+}
+
+} // namespace loader
+} // namespace retdec
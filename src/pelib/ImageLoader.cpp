@@ -345,7 +345,7 @@ std::uint32_t PeLib::ImageLoader::readStringRc(
 }
 
 std::uint32_t PeLib::ImageLoader::readStringRaw(
-	ByteBuffer & fileData,
+	const ByteView & fileData,
 	std::string & str,
 	std::size_t offset,
 	std::size_t maxLength,
@@ -356,8 +356,8 @@ std::uint32_t PeLib::ImageLoader::readStringRaw(
 
 	if(offset < fileData.size())
 	{
-		std::uint8_t * stringBegin = fileData.data() + offset;
-		std::uint8_t * stringEnd;
+		const std::uint8_t * stringBegin = fileData.data() + offset;
+		const std::uint8_t * stringEnd;
 
 		// Make sure we won't read past the end of the buffer
 		if((offset + maxLength) > fileData.size())
@@ -366,7 +366,7 @@ std::uint32_t PeLib::ImageLoader::readStringRaw(
 		// Get the length of the string. Do not go beyond the maximum length
 		// Note that there is no guaratee that the string is zero terminated, so can't use strlen
 		// retdec-regression-tests\tools\fileinfo\bugs\issue-451-strange-section-names\4383fe67fec6ea6e44d2c7d075b9693610817edc68e8b2a76b2246b53b9186a1-unpacked
-		stringEnd = (std::uint8_t *)memchr(stringBegin, 0, maxLength);
+		stringEnd = (const std::uint8_t *)memchr(stringBegin, 0, maxLength);
 		if(stringEnd == nullptr)
 		{
 			// No zero terminator means that the string is limited by max length
@@ -914,7 +914,7 @@ PeLib::LoaderError PeLib::ImageLoader::loaderError() const
 // Interface for loading files
 
 int PeLib::ImageLoader::Load(
-	ByteBuffer & fileData,
+	const ByteView & fileData,
 	std::uint32_t loadFlags)
 {
 	int fileError;
@@ -1645,10 +1645,10 @@ void PeLib::ImageLoader::writeNewImageBase(std::uint64_t newImageBase)
 	}
 }
 
-int PeLib::ImageLoader::captureDosHeader(ByteBuffer & fileData)
+int PeLib::ImageLoader::captureDosHeader(const ByteView & fileData)
 {
-	std::uint8_t * fileBegin = fileData.data();
-	std::uint8_t * fileEnd = fileBegin + fileData.size();
+	const std::uint8_t * fileBegin = fileData.data();
+	const std::uint8_t * fileEnd = fileBegin + fileData.size();
 
 	// Capture the DOS header
 	if((fileBegin + sizeof(PELIB_IMAGE_DOS_HEADER)) >= fileEnd)
@@ -1693,11 +1693,11 @@ int PeLib::ImageLoader::saveDosHeader(
 	return saveToFile(fs, fileOffset, 0, dosHeader.e_lfanew);
 }
 
-int PeLib::ImageLoader::captureNtHeaders(ByteBuffer & fileData)
+int PeLib::ImageLoader::captureNtHeaders(const ByteView & fileData)
 {
-	std::uint8_t * fileBegin = fileData.data();
-	std::uint8_t * filePtr = fileBegin + dosHeader.e_lfanew;
-	std::uint8_t * fileEnd = fileBegin + fileData.size();
+	const std::uint8_t * fileBegin = fileData.data();
+	const std::uint8_t * filePtr = fileBegin + dosHeader.e_lfanew;
+	const std::uint8_t * fileEnd = fileBegin + fileData.size();
 	std::size_t ntHeaderSize;
 	std::uint16_t optionalHeaderMagic = PELIB_IMAGE_NT_OPTIONAL_HDR32_MAGIC;
 
@@ -1719,7 +1719,7 @@ int PeLib::ImageLoader::captureNtHeaders(ByteBuffer & fileData)
 	}
 
 	// Check the NT signature
-	if((ntSignature = *(std::uint32_t *)(filePtr)) != PELIB_IMAGE_NT_SIGNATURE)
+	if((ntSignature = *(const std::uint32_t *)(filePtr)) != PELIB_IMAGE_NT_SIGNATURE)
 	{
 		setLoaderError(LDR_ERROR_NO_NT_SIGNATURE);
 		return ERROR_INVALID_FILE;
@@ -1754,7 +1754,7 @@ int PeLib::ImageLoader::captureNtHeaders(ByteBuffer & fileData)
 	// Capture optional header. Note that we need to parse it
 	// according to IMAGE_OPTIONAL_HEADER::Magic
 	if((filePtr + sizeof(std::uint16_t)) < fileEnd)
-		optionalHeaderMagic = *(std::uint16_t *)(filePtr);
+		optionalHeaderMagic = *(const std::uint16_t *)(filePtr);
 	if(optionalHeaderMagic == PELIB_IMAGE_NT_OPTIONAL_HDR64_MAGIC)
 		captureOptionalHeader64(fileBegin, filePtr, fileEnd);
 	else
@@ -1952,7 +1952,7 @@ int PeLib::ImageLoader::saveNtHeaders(
 }
 
 int PeLib::ImageLoader::captureSectionName(
-	ByteBuffer & fileData,
+	const ByteView & fileData,
 	std::string & sectionName,
 	const std::uint8_t * Name)
 {
@@ -1993,11 +1993,11 @@ int PeLib::ImageLoader::captureSectionName(
 	return ERROR_NONE;
 }
 
-int PeLib::ImageLoader::captureSectionHeaders(ByteBuffer & fileData)
+int PeLib::ImageLoader::captureSectionHeaders(const ByteView & fileData)
 {
-	std::uint8_t * fileBegin = fileData.data();
-	std::uint8_t * filePtr;
-	std::uint8_t * fileEnd = fileBegin + fileData.size();
+	const std::uint8_t * fileBegin = fileData.data();
+	const std::uint8_t * filePtr;
+	const std::uint8_t * fileEnd = fileBegin + fileData.size();
 	bool bRawDataBeyondEOF = false;
 
 	// If there are no sections, then we're done
@@ -2206,7 +2206,7 @@ int PeLib::ImageLoader::saveSectionHeaders(
 	return saveToFile(fs, fileOffset, offsetOfHeaders, sizeOfHeaders);
 }
 
-int PeLib::ImageLoader::captureImageSections(ByteBuffer & fileData, std::uint32_t loadFlags)
+int PeLib::ImageLoader::captureImageSections(const ByteView & fileData, std::uint32_t loadFlags)
 {
 	std::uint32_t virtualAddress = 0;
 	std::uint32_t sizeOfHeaders = optionalHeader.SizeOfHeaders;
@@ -2332,9 +2332,9 @@ int PeLib::ImageLoader::verifyDosHeader(
 	return (ldrError == LDR_ERROR_E_LFANEW_OUT_OF_FILE) ? ERROR_INVALID_FILE : ERROR_NONE;
 }
 
-int PeLib::ImageLoader::loadImageAsIs(ByteBuffer & fileData)
+int PeLib::ImageLoader::loadImageAsIs(const ByteView & fileData)
 {
-	rawFileData = fileData;
+	rawFileData.assign(fileData.begin(), fileData.end());
 	return ERROR_NONE;
 }
 
@@ -2345,12 +2345,12 @@ int PeLib::ImageLoader::loadImageAsIs(ByteBuffer & fileData)
 // but the .NET framework (_CorExeMain) does not care about NumberOfRvaAndSizes
 // and directly takes the DataDirectory without checking NumberOfRvaAndSizes
 std::uint32_t PeLib::ImageLoader::copyDataDirectories(
-	std::uint8_t * optionalHeaderPtr,
-	std::uint8_t * dataDirectoriesPtr,
+	const std::uint8_t * optionalHeaderPtr,
+	const std::uint8_t * dataDirectoriesPtr,
 	std::size_t optionalHeaderMax,			// How many bytes do we have from the beginning of the optional header till the end of the file
 	std::uint32_t numberOfRvaAndSizes)
 {
-	std::uint8_t * dataDirectoriesEnd = dataDirectoriesPtr + PELIB_IMAGE_NUMBEROF_DIRECTORY_ENTRIES * sizeof(PELIB_IMAGE_DATA_DIRECTORY);
+	const std::uint8_t * dataDirectoriesEnd = dataDirectoriesPtr + PELIB_IMAGE_NUMBEROF_DIRECTORY_ENTRIES * sizeof(PELIB_IMAGE_DATA_DIRECTORY);
 
 	// Do not leave numberOfRvaAndSizes higher than the maximum possible value
 	if(numberOfRvaAndSizes > PELIB_IMAGE_NUMBEROF_DIRECTORY_ENTRIES)
@@ -2368,9 +2368,9 @@ std::uint32_t PeLib::ImageLoader::copyDataDirectories(
 }
 
 int PeLib::ImageLoader::captureOptionalHeader64(
-	std::uint8_t * fileBegin,
-	std::uint8_t * filePtr,
-	std::uint8_t * fileEnd)
+	const std::uint8_t * fileBegin,
+	const std::uint8_t * filePtr,
+	const std::uint8_t * fileEnd)
 {
 	PELIB_IMAGE_OPTIONAL_HEADER64 optionalHeader64{};
 	std::uint32_t sizeOfOptionalHeader = sizeof(PELIB_IMAGE_OPTIONAL_HEADER64);
@@ -2429,9 +2429,9 @@ int PeLib::ImageLoader::captureOptionalHeader64(
 }
 
 int PeLib::ImageLoader::captureOptionalHeader32(
-	std::uint8_t * fileBegin,
-	std::uint8_t * filePtr,
-	std::uint8_t * fileEnd)
+	const std::uint8_t * fileBegin,
+	const std::uint8_t * filePtr,
+	const std::uint8_t * fileEnd)
 {
 	PELIB_IMAGE_OPTIONAL_HEADER32 optionalHeader32{};
 	std::uint32_t sizeOfOptionalHeader = sizeof(PELIB_IMAGE_OPTIONAL_HEADER32);
@@ -2491,7 +2491,7 @@ int PeLib::ImageLoader::captureOptionalHeader32(
 }
 
 std::uint32_t PeLib::ImageLoader::captureImageSection(
-	ByteBuffer & fileData,
+	const ByteView & fileData,
 	std::uint32_t virtualAddress,
 	std::uint32_t virtualSize,
 	std::uint32_t pointerToRawData,
@@ -2499,10 +2499,10 @@ std::uint32_t PeLib::ImageLoader::captureImageSection(
 	std::uint32_t characteristics,
 	bool isImageHeader)
 {
-	std::uint8_t * fileBegin = fileData.data();
-	std::uint8_t * rawDataPtr;
-	std::uint8_t * rawDataEnd;
-	std::uint8_t * fileEnd = fileBegin + fileData.size();
+	const std::uint8_t * fileBegin = fileData.data();
+	const std::uint8_t * rawDataPtr;
+	const std::uint8_t * rawDataEnd;
+	const std::uint8_t * fileEnd = fileBegin + fileData.size();
 	std::uint32_t sizeOfInitializedPages;            // The part of section with initialized pages
 	std::uint32_t sizeOfValidPages;                  // The part of section with valid pages
 	std::uint32_t sizeOfSection;                     // Total virtual size of the section
@@ -2752,7 +2752,7 @@ bool PeLib::ImageLoader::isValidMachineForCodeIntegrifyCheck(std::uint32_t Bits)
 // there are some more checks implemented by CI!HashpParsePEHeader
 // (nt!SeValidateImageHeader -> CI!CiValidateImageHeader -> ... -> CI!HashpParsePEHeader in Win7)
 // This function does the same checks like CI!HashpParsePEHeader
-bool PeLib::ImageLoader::checkForBadCodeIntegrityImages(ByteBuffer & fileData)
+bool PeLib::ImageLoader::checkForBadCodeIntegrityImages(const ByteView & fileData)
 {
 	if(optionalHeader.DllCharacteristics & PELIB_IMAGE_DLLCHARACTERISTICS_FORCE_INTEGRITY)
 	{
@@ -2852,7 +2852,7 @@ bool PeLib::ImageLoader::checkForBadCodeIntegrityImages(ByteBuffer & fileData)
 		// just check for the most blatantly corrupt certificates
 		if(forceIntegrityCheckCertificate)
 		{
-			std::uint8_t * certPtr = fileData.data() + SecurityDir.VirtualAddress;
+			const std::uint8_t * certPtr = fileData.data() + SecurityDir.VirtualAddress;
 			if(SecurityDir.Size > 2 && certPtr[0] == 0 && certPtr[1] == 0)
 				return true;
 		}
@@ -33,7 +33,7 @@ namespace PeLib
 		return m_imageLoader.Load(m_iStream, loadHeadersOnly);
 	}
 
-	int PeFileT::loadPeHeaders(ByteBuffer & fileData, bool loadHeadersOnly)
+	int PeFileT::loadPeHeaders(const ByteView & fileData, bool loadHeadersOnly)
 	{
 		return m_imageLoader.Load(fileData, loadHeadersOnly);
 	}
@@ -283,7 +283,7 @@ namespace PeLib
 		return richHeader().read(m_iStream, offset, size, ignoreInvalidKey);
 	}
 
-	int PeFileT::readCoffSymbolTable(ByteBuffer & fileData)
+	int PeFileT::readCoffSymbolTable(const ByteView & fileData)
 	{
 		if(m_imageLoader.getPointerToSymbolTable() && m_imageLoader.getNumberOfSymbols())
 		{
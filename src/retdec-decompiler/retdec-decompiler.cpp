@@ -4,9 +4,13 @@
  * @copyright (c) 2020 Avast Software, licensed under the MIT license
  */
 
+#include <cctype>
 #include <fstream>
 #include <future>
 #include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
 #include <thread>
 
 #include <llvm/ADT/Triple.h>
@@ -46,6 +50,7 @@
 #include "retdec/utils/filesystem.h"
 #include "retdec/utils/io/log.h"
 #include "retdec/utils/memory.h"
+#include "retdec/utils/profiler.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/version.h"
 
@@ -77,12 +82,25 @@ class ProgramOptions
 		bool cleanup = false;
 		std::set<std::string> toClean;
 
+		/// File with batch jobs, "-" for standard input.
+		std::string batchFile;
+		/// These are options of a single job from the batch file.
+		bool batchJob = false;
+
+		/// Output file for the profile of decompilation phases.
+		std::string profileFile;
+
 	public:
 		ProgramOptions(
 				int argc,
 				char *argv[],
 				retdec::config::Config& c,
 				retdec::config::Parameters& p);
+		ProgramOptions(
+				const std::string& name,
+				const std::list<std::string>& args,
+				retdec::config::Config& c,
+				retdec::config::Parameters& p);
 
 		void load();
 
@@ -119,6 +137,19 @@ ProgramOptions::ProgramOptions(
 	}
 }
 
+ProgramOptions::ProgramOptions(
+		const std::string& name,
+		const std::list<std::string>& args,
+		retdec::config::Config& c,
+		retdec::config::Parameters& p)
+		: programName(name)
+		, config(c)
+		, params(p)
+		, _argv(args)
+{
+
+}
+
 void ProgramOptions::load()
 {
 	for (auto i = _argv.begin(); i != _argv.end();)
@@ -174,6 +205,13 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 	}
 	else if (isParam(i, "", "--version"))
 	{
+		// Job must not terminate the whole batch.
+		if (batchJob)
+		{
+			throw std::runtime_error(
+				"[--version] cannot be used inside a batch job"
+			);
+		}
 		Log::info() << retdec::utils::version::getVersionStringLong() << "\n";
 		exit(EXIT_SUCCESS);
 	}
@@ -265,7 +303,8 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 	else if (isParam(i, "-f", "--output-format"))
 	{
 		auto of = getParamOrDie(i);
-		if (!(of == "plain" || of == "json" || of == "json-human"))
+		if (!(of == "plain" || of == "json" || of == "json-human"
+				|| of == "json-compact"))
 		{
 			throw std::runtime_error(
 				"[-f|--output-format] unknown output format: " + of
@@ -355,6 +394,21 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 	{
 		params.setIsSelectedDecodeOnly(true);
 	}
+	else if (isParam(i, "", "--select-decode-depth"))
+	{
+		auto val = getParamOrDie(i);
+		try
+		{
+			params.setSelectedDecodeDepth(std::stoull(val));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--select-decode-depth] invalid depth: " + val
+			);
+		}
+		params.setIsSelectedDecodeOnly(true);
+	}
 	else if (isParam(i, "", "--raw-section-vma"))
 	{
 		auto val = getParamOrDie(i);
@@ -503,6 +557,12 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 	}
 	else if (isParam(i, "", "--timeout"))
 	{
+		if (batchJob)
+		{
+			throw std::runtime_error(
+				"[--timeout] cannot be used inside a batch job"
+			);
+		}
 		auto t = getParamOrDie(i);
 		try
 		{
@@ -515,10 +575,63 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 			);
 		}
 	}
+	else if (isParam(i, "-j", "--jobs"))
+	{
+		auto j = getParamOrDie(i);
+		try
+		{
+			params.setJobs(std::stoull(j));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[-j|--jobs] invalid number of jobs: " + j
+			);
+		}
+	}
+	else if (isParam(i, "", "--cache-dir"))
+	{
+		params.setCacheDir(getParamOrDie(i));
+	}
+	else if (isParam(i, "", "--cache-size"))
+	{
+		auto val = getParamOrDie(i);
+		try
+		{
+			params.setCacheMaxSize(std::stoull(val));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--cache-size] invalid value: " + val
+			);
+		}
+	}
 	else if (isParam(i, "-s", "--silent"))
 	{
 		params.setIsVerboseOutput(false);
 	}
+	else if (isParam(i, "", "--batch"))
+	{
+		if (batchJob)
+		{
+			throw std::runtime_error(
+				"[--batch] cannot be used inside a batch job"
+			);
+		}
+		auto file = getParamOrDie(i);
+		batchFile = file == "-" ? file : checkFile(file, "[--batch]");
+	}
+	else if (isParam(i, "", "--profile"))
+	{
+		if (batchJob)
+		{
+			throw std::runtime_error(
+				"[--profile] cannot be used inside a batch job"
+			);
+		}
+		profileFile = getParamOrDie(i);
+	}
 	// Input file is the only argument that does not have -x or --xyz
 	// before it. But only one input is expected.
 	else if (params.getInputFile().empty())
@@ -536,6 +649,38 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
  */
 void ProgramOptions::afterLoad()
 {
+	// Inputs (and outputs derived from them) are set by the individual jobs.
+	if (!batchFile.empty())
+	{
+		if (!params.getInputFile().empty())
+		{
+			throw std::runtime_error(
+				"[--batch] INPUT_FILE cannot be used together with --batch"
+			);
+		}
+		// A timed out job would be left running while the next one starts.
+		if (params.isTimeout())
+		{
+			throw std::runtime_error(
+				"[--timeout] cannot be used together with --batch"
+			);
+		}
+		// Every job would inherit (and overwrite) the same output files.
+		if (!params.getOutputFile().empty()
+				|| !params.getOutputAsmFile().empty()
+				|| !params.getOutputBitcodeFile().empty()
+				|| !params.getOutputLlvmirFile().empty()
+				|| !params.getOutputConfigFile().empty()
+				|| !params.getOutputUnpackedFile().empty()
+				|| !arExtractPath.empty())
+		{
+			throw std::runtime_error(
+				"[--batch] output files cannot be used together with --batch"
+			);
+		}
+		return;
+	}
+
 	auto in = params.getInputFile();
 	if (params.getOutputAsmFile().empty())
 		params.setOutputAsmFile(in + ".dsm");
@@ -612,23 +757,36 @@ std::string ProgramOptions::checkFile(
 
 void ProgramOptions::printHelpAndDie()
 {
+	// Bad job must not terminate the whole batch.
+	if (batchJob)
+	{
+		throw std::runtime_error("invalid job arguments");
+	}
+
 	Log::info() << programName << R"(:
 Mandatory arguments:
 	INPUT_FILE File to decompile.
 General arguments:
-	[-o|--output FILE] Output file (default: INPUT_FILE.c if OUTPUT_FORMAT is plain, INPUT_FILE.c.json if OUTPUT_FORMAT is json|json-human).
+	[-o|--output FILE] Output file (default: INPUT_FILE.c if OUTPUT_FORMAT is plain, INPUT_FILE.c.json if OUTPUT_FORMAT is json|json-human|json-compact; cannot be used together with --batch).
 	[-s|--silent] Turns off informative output of the decompilation.
-	[-f|--output-format OUTPUT_FORMAT] Output format [plain|json|json-human] (default: plain).
+	[-f|--output-format OUTPUT_FORMAT] Output format [plain|json|json-human|json-compact] (default: plain).
 	[-m|--mode MODE] Force the type of decompilation mode [bin|raw] (default: bin).
 	[-p|--pdb FILE] File with PDB debug information.
 	[-k|--keep-unreachable-funcs] Keep functions that are unreachable from the main function.
 	[--cleanup] Removes temporary files created during the decompilation.
 	[--config] Specify JSON decompilation configuration file.
 	[--disable-static-code-detection] Prevents detection of statically linked code.
+Batch mode arguments:
+	[--batch FILE] Decompile all the jobs from FILE ("-" for standard input) in a single process.
+	               Each line holds arguments of one job (INPUT_FILE and any other arguments from this help),
+	               empty lines and lines starting with '#' are skipped. Arguments given on the command line
+	               are used for all the jobs. A result line with the job's exit code and time is printed
+	               to the standard output for every job.
 Selective decompilation arguments:
 	[--select-ranges RANGES] Specify a comma separated list of ranges to decompile (example: 0x100-0x200,0x300-0x400,0x500-0x600).
 	[--select-functions FUNCS] Specify a comma separated list of functions to decompile (example: fnc1,fnc2,fnc3).
 	[--select-decode-only] Decode only selected parts (functions/ranges). Faster decompilation, but worse results.
+	[--select-decode-depth N] Decode only selected parts and functions they call up to the depth N, so that their arguments and return values can be inferred (implies --select-decode-only, default: 0).
 Raw or Intel HEX decompilation arguments:
 	[-a|--arch ARCH] Specify target architecture [mips|pic32|arm|thumb|arm64|powerpc|x86|x86-64].
 	                 Required if it cannot be autodetected from the input (e.g. raw mode, Intel HEX).
@@ -657,9 +815,18 @@ Backend arguments:
 	[--backend-no-compound-operators] Do not emit compound operators (like +=) instead of assignments.
 	[--backend-no-symbolic-names] Disables the conversion of constant arguments to their symbolic names.
 Decompilation process arguments:
-	[--timeout SECONDS]
+	[--timeout SECONDS] Stop the decompilation after SECONDS (cannot be used together with --batch).
+	[-j|--jobs N] Number of threads used by the parallelized parts of the decompilation, 0 means all hardware threads (default: 1).
 	[--max-memory MAX_MEMORY] Limits the maximal memory used by the given number of bytes.
 	[--no-memory-limit] Disables the default memory limit (half of system RAM).
+	[--cache-dir DIR] Keep a persistent cache of decompiled functions in DIR. Functions whose lifted code did not
+	                  change since they were cached are not optimized in the backend, their output is taken from
+	                  the cache instead.
+	[--cache-size SIZE] Maximal size of the cache in bytes, the least recently used functions are removed when it
+	                    is exceeded (default: 1073741824).
+	[--profile FILE] Write a JSON profile of the decompilation phases (LLVM passes, backend phases and optimizations,
+	                 unpacking, ...) into FILE. Every phase has its wall time, CPU time, peak RSS growth and the number
+	                 of functions and instructions after it.
 LLVM IR debug arguments:
 	[--print-after-all] Dump LLVM IR to stderr after every LLVM pass.
 	[--print-before-all] Dump LLVM IR to stderr before every LLVM pass.
@@ -769,7 +936,9 @@ void limitMaximalMemoryIfRequested(const retdec::config::Parameters& params)
  * This is not wanted. Best solution would be making Parameters unaware of
  * rapidjson.
  */
-void setLogsFrom(const retdec::config::Parameters& params)
+void setLogsFrom(
+		const retdec::config::Parameters& params,
+		Log::Context& logs)
 {
 	auto logFile = params.getLogFile();
 	auto errFile = params.getErrFile();
@@ -783,17 +952,15 @@ void setLogsFrom(const retdec::config::Parameters& params)
 			: new FileLogger(logFile, verbose)
 	);
 
-	Log::set(Log::Type::Info, std::move(outLog));
+	logs.set(Log::Type::Info, std::move(outLog));
 
 	if (!errFile.empty()) {
-		Log::set(Log::Type::Error, Logger::Ptr(new FileLogger(errFile)));
+		logs.set(Log::Type::Error, Logger::Ptr(new FileLogger(errFile)));
 	}
 }
 
 int decompile(retdec::config::Config& config, ProgramOptions& po)
 {
-	setLogsFrom(config.parameters);
-
 	// Macho-O extraction.
 	//
 	retdec::macho_extractor::BreakMachOUniversal fat(
@@ -802,6 +969,7 @@ int decompile(retdec::config::Config& config, ProgramOptions& po)
 	if (fat.isValid())
 	{
 		Log::phase("Mach-O extraction");
+		retdec::utils::Profiler::Scope profile("Mach-O extraction");
 
 		auto extractedFile = po.arExtractPath + "_m";
 
@@ -840,6 +1008,7 @@ int decompile(retdec::config::Config& config, ProgramOptions& po)
 	if (po.arIdx || !po.arName.empty())
 	{
 		Log::phase("Archive extraction");
+		retdec::utils::Profiler::Scope profile("Archive extraction");
 
 		bool ok = true;
 		std::string errMsg;
@@ -931,6 +1100,7 @@ int decompile(retdec::config::Config& config, ProgramOptions& po)
 	//
 
 	Log::phase("Unpacking");
+	retdec::utils::Profiler::Scope unpackProfile("Unpacking");
 	std::vector<std::string> unpackArgs;
 	unpackArgs.push_back("whatever_program_name");
 	unpackArgs.push_back(config.parameters.getInputFile());
@@ -943,6 +1113,7 @@ int decompile(retdec::config::Config& config, ProgramOptions& po)
 			unpackArgs[3].data()
 	};
 	auto unpackCode = retdec::unpackertool::_main(4, uargv);
+	unpackProfile.stop();
 	if (unpackCode == 0) // EXIT_CODE_OK
 	{
 		config.parameters.setInputFile(
@@ -956,6 +1127,75 @@ int decompile(retdec::config::Config& config, ProgramOptions& po)
 	return retdec::decompile(config);
 }
 
+/**
+ * Run decompilation with the given @a config and @a po.
+ * Handles timeout and converts exceptions into exit codes.
+ *
+ * If the decompilation times out, it is left running in a detached thread.
+ * This is why config, options and loggers are shared -- the thread keeps
+ * them alive.
+ */
+int runDecompilation(
+		std::shared_ptr<retdec::config::Config> config,
+		std::shared_ptr<ProgramOptions> po)
+{
+	auto logs = std::make_shared<Log::Context>();
+	try
+	{
+		setLogsFrom(config->parameters, *logs);
+	}
+	catch (const std::runtime_error& e)
+	{
+		Log::error() << Log::Error << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	Log::ContextScope logScope(logs.get());
+
+	int ret = 0;
+	try
+	{
+		if (config->parameters.isTimeout())
+		{
+			std::packaged_task<int()> task([config, po, logs]()
+			{
+				Log::ContextScope logScope(logs.get());
+				return decompile(*config, *po);
+			});
+			auto future = task.get_future();
+			std::thread thr(std::move(task));
+			auto timeout = std::chrono::seconds(config->parameters.getTimeout());
+			if (future.wait_for(timeout) != std::future_status::timeout)
+			{
+				thr.join();
+				ret = future.get(); // this will propagate exception
+			}
+			else
+			{
+				thr.detach(); // we leave the thread still running
+				Log::error() << "timeout after: " << config->parameters.getTimeout()
+						<< " seconds" << std::endl;
+				ret = EXIT_TIMEOUT;
+			}
+		}
+		else
+		{
+			ret = decompile(*config, *po);
+		}
+	}
+	catch (const std::runtime_error& e)
+	{
+		Log::error() << Log::Error << e.what() << std::endl;
+		ret = EXIT_FAILURE;
+	}
+	catch (const std::bad_alloc& e)
+	{
+		Log::error() << "catched std::bad_alloc" << std::endl;
+		ret = EXIT_BAD_ALLOC;
+	}
+
+	return ret;
+}
+
 //
 //==============================================================================
 // Cleanup.
@@ -975,6 +1215,188 @@ void cleanup(ProgramOptions& po)
 	}
 }
 
+//
+//==============================================================================
+// Profile.
+//==============================================================================
+//
+
+/**
+ * Write the profile of decompilation phases if it was requested.
+ */
+void writeProfileIfRequested(const ProgramOptions& po)
+{
+	if (po.profileFile.empty())
+	{
+		return;
+	}
+
+	if (!retdec::utils::Profiler::writeJson(po.profileFile))
+	{
+		Log::error() << Log::Warning << "failed to write profile: "
+				<< po.profileFile << std::endl;
+	}
+}
+
+//
+//==============================================================================
+// Batch mode.
+//==============================================================================
+//
+
+/**
+ * Split a batch job line into arguments. Arguments are separated by
+ * whitespace, double quotes can be used to group arguments with whitespace.
+ */
+std::list<std::string> splitJobLine(const std::string& line)
+{
+	std::list<std::string> args;
+	std::string arg;
+	bool inArg = false;
+	bool inQuotes = false;
+	for (char c : line)
+	{
+		if (c == '"')
+		{
+			inQuotes = !inQuotes;
+			inArg = true;
+		}
+		else if (!inQuotes && std::isspace(static_cast<unsigned char>(c)))
+		{
+			if (inArg)
+			{
+				args.push_back(arg);
+				arg.clear();
+				inArg = false;
+			}
+		}
+		else
+		{
+			arg += c;
+			inArg = true;
+		}
+	}
+	if (inQuotes)
+	{
+		throw std::runtime_error("unterminated quotes in job: " + line);
+	}
+	if (inArg)
+	{
+		args.push_back(arg);
+	}
+	return args;
+}
+
+/**
+ * Decompile all the jobs from the batch file in this process.
+ *
+ * Resources that do not depend on the input are initialized only once and
+ * kept warm for all the jobs: the default decompiler config, LLVM passes
+ * and parsed library type information.
+ *
+ * @param config Config with the defaults and command line arguments applied.
+ *               Every job starts with its copy.
+ * @param po     Command line options.
+ * @return @c EXIT_SUCCESS if all the jobs succeeded, @c EXIT_FAILURE
+ *         otherwise.
+ */
+int batch(const retdec::config::Config& config, const ProgramOptions& po)
+{
+	std::ifstream file;
+	if (po.batchFile != "-")
+	{
+		file.open(po.batchFile);
+		if (!file)
+		{
+			throw std::runtime_error(
+				"[--batch] failed to open: " + po.batchFile
+			);
+		}
+	}
+	std::istream& jobs = po.batchFile == "-" ? std::cin : file;
+
+	std::size_t jobCnt = 0;
+	std::size_t failedCnt = 0;
+	auto batchStart = std::chrono::steady_clock::now();
+
+	std::string line;
+	while (std::getline(jobs, line))
+	{
+		auto first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line[first] == '#')
+		{
+			continue;
+		}
+		++jobCnt;
+
+		auto jobStart = std::chrono::steady_clock::now();
+
+		auto jobConfig = std::make_shared<retdec::config::Config>(config);
+		std::shared_ptr<ProgramOptions> jobPo;
+		int ret = EXIT_SUCCESS;
+		try
+		{
+			jobPo = std::make_shared<ProgramOptions>(
+					po.programName,
+					splitJobLine(line),
+					*jobConfig,
+					jobConfig->parameters
+			);
+			jobPo->batchJob = true;
+			jobPo->mode = po.mode;
+			jobPo->bitSize = po.bitSize;
+			jobPo->cleanup = po.cleanup;
+			jobPo->load();
+		}
+		catch (const std::runtime_error& e)
+		{
+			Log::error() << Log::Error << e.what() << std::endl;
+			ret = EXIT_FAILURE;
+		}
+
+		if (ret == EXIT_SUCCESS)
+		{
+			retdec::utils::Profiler::Scope profile(
+					"batch job " + std::to_string(jobCnt)
+			);
+			ret = runDecompilation(jobConfig, jobPo);
+			cleanup(*jobPo);
+		}
+
+		if (ret != EXIT_SUCCESS)
+		{
+			++failedCnt;
+		}
+
+		std::chrono::duration<double> jobTime =
+				std::chrono::steady_clock::now() - jobStart;
+		std::cout << "[batch] job " << jobCnt
+				<< (ret == EXIT_SUCCESS ? " ok" : " failed")
+				<< " (exit code " << ret << ") in "
+				<< std::fixed << std::setprecision(3) << jobTime.count() << "s: "
+				<< line.substr(first) << std::endl;
+
+		// The timed out decompilation is still running in a detached thread,
+		// other jobs must not run alongside it.
+		if (ret == EXIT_TIMEOUT)
+		{
+			Log::error() << Log::Error
+					<< "[batch] job " << jobCnt << " timed out, aborting the batch"
+					<< std::endl;
+			break;
+		}
+	}
+
+	std::chrono::duration<double> batchTime =
+			std::chrono::steady_clock::now() - batchStart;
+	std::cout << "[batch] " << jobCnt << " jobs, "
+			<< failedCnt << " failed, in "
+			<< std::fixed << std::setprecision(3) << batchTime.count() << "s"
+			<< std::endl;
+
+	return failedCnt == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 //
 //==============================================================================
 // Main.
@@ -992,7 +1414,7 @@ int main(int argc, char **argv)
 
 	// Load the default config parameters.
 	//
-	retdec::config::Config config;
+	auto config = std::make_shared<retdec::config::Config>();
 	auto binpath = retdec::utils::getThisBinaryDirectoryPath();
 	fs::path configPath(fs::canonical(binpath).parent_path());
 	configPath.append("share");
@@ -1000,16 +1422,21 @@ int main(int argc, char **argv)
 	configPath.append("decompiler-config.json");
 	if (fs::exists(configPath))
 	{
-		config = retdec::config::Config::fromFile(configPath.string());
-		config.parameters.fixRelativePaths(fs::canonical(configPath).parent_path().string());
+		*config = retdec::config::Config::fromFile(configPath.string());
+		config->parameters.fixRelativePaths(fs::canonical(configPath).parent_path().string());
 	}
 
 	// Parse program arguments.
 	//
-	ProgramOptions po(argc, argv, config, config.parameters);
+	auto po = std::make_shared<ProgramOptions>(
+			argc,
+			argv,
+			*config,
+			config->parameters
+	);
 	try
 	{
-		po.load();
+		po->load();
 	}
 	catch (const std::runtime_error& e)
 	{
@@ -1019,53 +1446,40 @@ int main(int argc, char **argv)
 
 	// Limit program memory.
 	//
-	limitMaximalMemoryIfRequested(config.parameters);
+	limitMaximalMemoryIfRequested(config->parameters);
 
+	// Profile decompilation phases.
+	//
+	if (!po->profileFile.empty())
+	{
+		retdec::utils::Profiler::enable();
+	}
 
-	// Decompile.
+	// Decompile all the jobs in batch mode.
 	//
-	int ret = 0;
-	try
+	if (!po->batchFile.empty())
 	{
-		std::stringstream buffer;
-		if (config.parameters.isTimeout())
+		int ret = EXIT_SUCCESS;
+		try
 		{
-			std::packaged_task<
-					int(retdec::config::Config&,
-					ProgramOptions&)> task(decompile);
-			auto future = task.get_future();
-			std::thread thr(std::move(task), std::ref(config), std::ref(po));
-			auto timeout = std::chrono::seconds(config.parameters.getTimeout());
-			if (future.wait_for(timeout) != std::future_status::timeout)
-			{
-				thr.join();
-				ret = future.get(); // this will propagate exception
-			}
-			else
-			{
-				thr.detach(); // we leave the thread still running
-				Log::error() << "timeout after: " << config.parameters.getTimeout()
-						<< " seconds" << std::endl;
-				ret = EXIT_TIMEOUT;
-			}
+			ret = batch(*config, *po);
 		}
-		else
+		catch (const std::runtime_error& e)
 		{
-			ret = decompile(config, po);
+			Log::error() << Log::Error << e.what() << std::endl;
+			ret = EXIT_FAILURE;
 		}
+
+		writeProfileIfRequested(*po);
+		return ret;
 	}
-	catch (const std::runtime_error& e)
-	{
-		Log::error() << Log::Error << e.what() << std::endl;
-		ret = EXIT_FAILURE;
-	}
-	catch (const std::bad_alloc& e)
-	{
-		Log::error() << "catched std::bad_alloc" << std::endl;
-		ret = EXIT_BAD_ALLOC;
-	}
 
-	cleanup(po);
+	// Decompile.
+	//
+	int ret = runDecompilation(config, po);
+
+	cleanup(*po);
+	writeProfileIfRequested(*po);
 
 	return ret;
 }
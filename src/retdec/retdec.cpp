@@ -44,12 +44,14 @@
 #include "retdec/bin2llvmir/optimizations/provider_init/provider_init.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
 #include "retdec/bin2llvmir/providers/config.h"
+#include "retdec/bin2llvmir/providers/provider_context.h"
 
 #include "retdec/llvmir2hll/llvmir2hll.h"
 
 #include "retdec/config/config.h"
 #include "retdec/retdec/retdec.h"
 #include "retdec/utils/memory.h"
+#include "retdec/utils/profiler.h"
 #include "retdec/utils/io/log.h"
 
 using namespace retdec::utils::io;
@@ -304,6 +306,8 @@ LlvmModuleContextPair disassemble(
 {
 	auto context = std::make_unique<llvm::LLVMContext>();
 	auto module = createLlvmModule(*context);
+	auto providers = std::make_unique<bin2llvmir::ProviderContext>(
+			module.get());
 
 	config::Config c;
 	c.parameters.setInputFile(inputPath);
@@ -320,7 +324,10 @@ LlvmModuleContextPair disassemble(
 
 	fillFunctions(*module, fs);
 
-	return LlvmModuleContextPair{std::move(module), std::move(context)};
+	return LlvmModuleContextPair{
+			std::move(module),
+			std::move(context),
+			std::move(providers)};
 }
 
 //==============================================================================
@@ -329,18 +336,25 @@ LlvmModuleContextPair disassemble(
 
 /**
  * Call a bunch of LLVM initialization functions, same as the original opt.
+ * It is done only once per process, all the subsequent calls (e.g. other
+ * decompilations in the same process) just return the already initialized
+ * registry.
  */
 llvm::PassRegistry& initializeLlvmPasses()
 {
-	// Initialize passes
-	llvm::PassRegistry& Registry = *llvm::PassRegistry::getPassRegistry();
-	initializeCore(Registry);
-	initializeScalarOpts(Registry);
-	initializeIPO(Registry);
-	initializeAnalysis(Registry);
-	initializeTransformUtils(Registry);
-	initializeInstCombine(Registry);
-	initializeTarget(Registry);
+	static llvm::PassRegistry& Registry = []() -> llvm::PassRegistry&
+	{
+		// Initialize passes
+		llvm::PassRegistry& r = *llvm::PassRegistry::getPassRegistry();
+		initializeCore(r);
+		initializeScalarOpts(r);
+		initializeIPO(r);
+		initializeAnalysis(r);
+		initializeTransformUtils(r);
+		initializeInstCombine(r);
+		initializeTarget(r);
+		return r;
+	}();
 	return Registry;
 }
 
@@ -357,7 +371,7 @@ class ModulePassPrinter : public ModulePass
 		std::string PhaseArg;
 		std::string PassName;
 
-		static std::string LastPhase;
+		static thread_local std::string LastPhase;
 		inline static const std::string LlvmAggregatePhaseName = "LLVM";
 
 	public:
@@ -406,7 +420,85 @@ class ModulePassPrinter : public ModulePass
 		}
 };
 char ModulePassPrinter::ID = 0;
-std::string ModulePassPrinter::LastPhase;
+thread_local std::string ModulePassPrinter::LastPhase;
+
+/**
+ * This pass starts or stops profiling of other, subsequent pass.
+ * In pass manager, the starting instance should be placed right before the
+ * profiled pass and the stopping one right after it. They share the scope
+ * of the profiled phase.
+ */
+class ModulePassProfiler : public ModulePass
+{
+	public:
+		static char ID;
+		using ScopePtr = std::shared_ptr<std::unique_ptr<utils::Profiler::Scope>>;
+
+		std::string PhaseArg;
+		ScopePtr Scope;
+		bool Start = true;
+		std::string PassName;
+
+	public:
+		ModulePassProfiler(
+				const std::string& phaseArg,
+				ScopePtr scope,
+				bool start)
+				: ModulePass(ID)
+				, PhaseArg(phaseArg)
+				, Scope(scope)
+				, Start(start)
+				, PassName("ModulePass Profiler: " + PhaseArg)
+		{
+
+		}
+
+		bool runOnModule(Module &M) override
+		{
+			if (Start)
+			{
+				Scope->reset(new utils::Profiler::Scope(PhaseArg));
+				return false;
+			}
+
+			if (*Scope == nullptr)
+			{
+				return false;
+			}
+
+			(*Scope)->stop();
+
+			std::uint64_t fncs = 0;
+			std::uint64_t insns = 0;
+			for (Function& F : M)
+			{
+				if (F.isDeclaration())
+				{
+					continue;
+				}
+				++fncs;
+				for (BasicBlock& BB : F)
+				{
+					insns += BB.size();
+				}
+			}
+			(*Scope)->setCounts(fncs, insns);
+
+			Scope->reset();
+			return false;
+		}
+
+		llvm::StringRef getPassName() const override
+		{
+			return PassName.c_str();
+		}
+
+		void getAnalysisUsage(AnalysisUsage &AU) const override
+		{
+			AU.setPreservesAll();
+		}
+};
+char ModulePassProfiler::ID = 0;
 
 /**
  * Add the pass to the pass manager - no verification.
@@ -420,7 +512,17 @@ static inline void addPass(
 			PI->getPassName().str(),
 			PI->getPassArgument().str()
 	));
+
+	if (!utils::Profiler::isEnabled())
+	{
+		PM.add(P);
+		return;
+	}
+
+	auto scope = std::make_shared<std::unique_ptr<utils::Profiler::Scope>>();
+	PM.add(new ModulePassProfiler(PI->getPassArgument().str(), scope, true));
 	PM.add(P);
+	PM.add(new ModulePassProfiler(PI->getPassArgument().str(), scope, false));
 
 // if (!PI->isAnalysis())
 // PM.add(P->createPrinterPass(
@@ -439,7 +541,9 @@ static inline void addPass(
  * Before merging these two methods (providing them suitable interface)
  * each change in one of them must be reflected to both.
  */
-void setLogsFrom(const retdec::config::Parameters& params)
+void setLogsFrom(
+		const retdec::config::Parameters& params,
+		Log::Context& logs)
 {
 	auto logFile = params.getLogFile();
 	auto errFile = params.getErrFile();
@@ -453,16 +557,26 @@ void setLogsFrom(const retdec::config::Parameters& params)
 			: new FileLogger(logFile, verbose)
 	);
 
-	Log::set(Log::Type::Info, std::move(outLog));
+	logs.set(Log::Type::Info, std::move(outLog));
 
 	if (!errFile.empty()) {
-		Log::set(Log::Type::Error, Logger::Ptr(new FileLogger(errFile)));
+		logs.set(Log::Type::Error, Logger::Ptr(new FileLogger(errFile)));
 	}
 }
 
 bool decompile(retdec::config::Config& config, std::string* outString)
 {
-	setLogsFrom(config.parameters);
+	// Loggers of this decompilation, so that parallel decompilations do not
+	// replace each other's loggers. Loggers already activated by the caller
+	// are kept.
+	Log::Context logs;
+	auto* activeLogs = Log::getContext();
+	if (activeLogs == nullptr)
+	{
+		setLogsFrom(config.parameters, logs);
+		activeLogs = &logs;
+	}
+	Log::ContextScope logScope(activeLogs);
 
 	Log::phase("Initialization");
 	auto& passRegistry = initializeLlvmPasses();
@@ -472,6 +586,8 @@ bool decompile(retdec::config::Config& config, std::string* outString)
 
 	auto context = std::make_unique<llvm::LLVMContext>();
 	auto module = createLlvmModule(*context);
+	// Provider data of this decompilation, released before the module.
+	bin2llvmir::ProviderContext providers(module.get());
 
 	// Create a PassManager to hold and optimize the collection of passes we
 	// are about to build.
@@ -706,8 +706,8 @@ void Finder::search(
 	// Start Yara detector.
 	YaraDetector detector;
 	detector.addRuleFile(yaraFile);
-	auto inputBytes = fileFormat->getLoadedBytes();
-	detector.analyze(inputBytes);
+	const auto inputBytes = fileFormat->getLoadedBytes();
+	detector.analyze(inputBytes.data(), inputBytes.size());
 	if (!detector.isInValidState())
 	{
 		return;
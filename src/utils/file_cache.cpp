@@ -0,0 +1,215 @@
+/**
+* @file src/utils/file_cache.cpp
+* @brief Persistent on-disk cache of entries identified by keys.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "retdec/utils/file_cache.h"
+#include "retdec/utils/filesystem.h"
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+/**
+* @brief Returns a name suffix of a temporary file that is unique among all
+*        threads and (most likely) all processes sharing the cache.
+*/
+std::string getUniqueTmpSuffix() {
+	static std::atomic<std::uint64_t> counter(0);
+
+	std::ostringstream suffix;
+	suffix << ".tmp."
+		<< std::hash<std::thread::id>()(std::this_thread::get_id()) << "."
+		<< std::chrono::steady_clock::now().time_since_epoch().count() << "."
+		<< counter++;
+	return suffix.str();
+}
+
+} // anonymous namespace
+
+/**
+* @brief Creates a cache stored in the directory @a dir.
+*
+* @param[in] dir Directory with the entries. It is created if it does not
+*                exist.
+* @param[in] maxSize Maximal total size of the entries (in bytes).
+*
+* If the directory cannot be created, the cache is not usable: no entries are
+* found and nothing is stored.
+*/
+FileCache::FileCache(const std::string& dir, std::uint64_t maxSize):
+		_dir(dir), _maxSize(maxSize) {
+	std::error_code ec;
+	fs::create_directories(_dir, ec);
+	_usable = !_dir.empty() && fs::is_directory(_dir, ec);
+}
+
+/**
+* @brief Returns the directory with the entries.
+*/
+const std::string& FileCache::getDir() const {
+	return _dir;
+}
+
+/**
+* @brief Returns the maximal total size of the entries (in bytes).
+*/
+std::uint64_t FileCache::getMaxSize() const {
+	return _maxSize;
+}
+
+/**
+* @brief Can the cache be used?
+*/
+bool FileCache::isUsable() const {
+	return _usable;
+}
+
+/**
+* @brief Returns the content of the entry with @a key, if there is one.
+*
+* The entry is marked as the most recently used one.
+*/
+std::optional<std::string> FileCache::get(const std::string& key) const {
+	if (!_usable || !isValidKey(key)) {
+		return std::nullopt;
+	}
+
+	auto path = getEntryPath(key);
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+	if (!file) {
+		return std::nullopt;
+	}
+
+	std::ostringstream content;
+	content << file.rdbuf();
+	if (file.bad()) {
+		return std::nullopt;
+	}
+	file.close();
+
+	// The modification time is used as the time of the last use.
+	std::error_code ec;
+	fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+	return content.str();
+}
+
+/**
+* @brief Stores @a content as the entry with @a key.
+*
+* An existing entry with the same key is replaced.
+*
+* @return @c true if the entry was stored, @c false otherwise.
+*/
+bool FileCache::put(const std::string& key, const std::string& content) {
+	if (!_usable || !isValidKey(key)) {
+		return false;
+	}
+
+	auto path = getEntryPath(key);
+	auto tmpPath = path + getUniqueTmpSuffix();
+	{
+		std::ofstream file(tmpPath, std::ios::out | std::ios::binary);
+		if (!file.write(content.data(), content.size())) {
+			file.close();
+			std::error_code ec;
+			fs::remove(tmpPath, ec);
+			return false;
+		}
+	}
+
+	std::error_code ec;
+	fs::rename(tmpPath, path, ec);
+	if (ec) {
+		fs::remove(tmpPath, ec);
+		return false;
+	}
+	return true;
+}
+
+/**
+* @brief Removes the least recently used entries until the total size of the
+*        entries does not exceed the maximal size.
+*/
+void FileCache::evict() {
+	if (!_usable) {
+		return;
+	}
+
+	struct Entry {
+		fs::path path;
+		std::uint64_t size;
+		fs::file_time_type lastUse;
+	};
+	std::vector<Entry> entries;
+	std::uint64_t totalSize = 0;
+
+	std::error_code ec;
+	for (fs::directory_iterator i(_dir, ec), e; !ec && i != e; i.increment(ec)) {
+		std::error_code entryEc;
+		if (!i->is_regular_file(entryEc)) {
+			continue;
+		}
+		auto size = i->file_size(entryEc);
+		auto lastUse = fs::last_write_time(i->path(), entryEc);
+		if (entryEc) {
+			continue;
+		}
+		entries.push_back({i->path(), size, lastUse});
+		totalSize += size;
+	}
+	if (totalSize <= _maxSize) {
+		return;
+	}
+
+	std::sort(entries.begin(), entries.end(),
+		[](const Entry& e1, const Entry& e2) {
+			return e1.lastUse < e2.lastUse;
+		}
+	);
+	for (const auto& entry : entries) {
+		if (totalSize <= _maxSize) {
+			break;
+		}
+		if (fs::remove(entry.path, ec)) {
+			totalSize -= entry.size;
+		}
+	}
+}
+
+/**
+* @brief Can @a key be used as a key of an entry?
+*
+* Keys are used as file names, so they may contain only ASCII letters, digits,
+* @c '-', and @c '_'.
+*/
+bool FileCache::isValidKey(const std::string& key) {
+	return !key.empty() && std::all_of(key.begin(), key.end(),
+		[](char c) {
+			return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z')
+				|| (c >= 'A' && c <= 'Z') || c == '-' || c == '_';
+		}
+	);
+}
+
+/**
+* @brief Returns the path to the file of the entry with @a key.
+*/
+std::string FileCache::getEntryPath(const std::string& key) const {
+	return (fs::path(_dir) / key).string();
+}
+
+} // namespace utils
+} // namespace retdec
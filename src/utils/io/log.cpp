@@ -29,12 +29,19 @@ Logger::Ptr Log::writers[] = {
 
 Logger Log::defaultLogger(std::cout, true);
 
+thread_local Log::Context* Log::activeContext = nullptr;
+
 Logger& Log::get(const Log::Type& logType)
 {
 	// This can happen only after adding new Log::Type
 	// after Log::Type::Undefined in Log::Type enum.
 	assert(static_cast<int>(logType) <= static_cast<int>(Log::Type::Undefined));
 
+	if (activeContext) {
+		if (auto logger = activeContext->get(logType))
+			return *logger;
+	}
+
 	if (auto logger = writers[static_cast<int>(logType)].get())
 		return *logger;
 
@@ -51,6 +58,11 @@ void Log::set(const Log::Type& lt, Logger::Ptr&& logger)
 	writers[static_cast<int>(lt)] = std::move(logger);
 }
 
+Log::Context* Log::getContext()
+{
+	return activeContext;
+}
+
 Logger Log::info()
 {
 	return get(Log::Type::Info);
@@ -71,6 +83,31 @@ Logger Log::error()
 	return Logger(get(Log::Type::Error));
 }
 
+void Log::Context::set(const Log::Type& lt, Logger::Ptr&& logger)
+{
+	assert(static_cast<int>(lt) <= static_cast<int>(Log::Type::Undefined));
+
+	writers[static_cast<int>(lt)] = std::move(logger);
+}
+
+Logger* Log::Context::get(const Log::Type& lt) const
+{
+	assert(static_cast<int>(lt) <= static_cast<int>(Log::Type::Undefined));
+
+	return writers[static_cast<int>(lt)].get();
+}
+
+Log::ContextScope::ContextScope(Log::Context* context):
+	previous(Log::activeContext)
+{
+	Log::activeContext = context;
+}
+
+Log::ContextScope::~ContextScope()
+{
+	Log::activeContext = previous;
+}
+
 }
 }
 }
@@ -0,0 +1,155 @@
+/**
+* @file src/utils/mapped_file.cpp
+* @brief Read-only memory-mapped file.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include "retdec/utils/file_io.h"
+#include "retdec/utils/mapped_file.h"
+#include "retdec/utils/os.h"
+
+#ifdef OS_WINDOWS
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Opens the file at @a path.
+*
+* @return Shared read-only content of the file, or @c nullptr if the file
+*         cannot be read at all.
+*/
+std::shared_ptr<const MappedFile> MappedFile::open(const std::string& path) {
+	std::shared_ptr<MappedFile> file(new MappedFile());
+	if (file->map(path) || file->read(path)) {
+		return file;
+	}
+	return nullptr;
+}
+
+MappedFile::~MappedFile() {
+	if (_mapping == nullptr) {
+		return;
+	}
+
+#ifdef OS_WINDOWS
+	UnmapViewOfFile(_mapping);
+#else
+	munmap(_mapping, _size);
+#endif
+}
+
+/**
+* @brief Returns the content of the file.
+*/
+const std::uint8_t* MappedFile::data() const {
+	return _data;
+}
+
+/**
+* @brief Returns the size of the file.
+*/
+std::size_t MappedFile::size() const {
+	return _size;
+}
+
+/**
+* @brief Is the file empty?
+*/
+bool MappedFile::empty() const {
+	return _size == 0;
+}
+
+/**
+* @brief Is the content mapped into memory (rather than read into a buffer)?
+*/
+bool MappedFile::isMapped() const {
+	return _mapping != nullptr;
+}
+
+/**
+* @brief Maps the file at @a path into memory.
+*
+* Empty files and files that are not regular files are not mapped.
+*/
+bool MappedFile::map(const std::string& path) {
+#ifdef OS_WINDOWS
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0
+			|| static_cast<std::uint64_t>(fileSize.QuadPart) > SIZE_MAX) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0,
+		nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr) {
+		return false;
+	}
+
+	// The view keeps the mapping alive, so it can be closed right away.
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (view == nullptr) {
+		return false;
+	}
+
+	_mapping = view;
+	_size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+		close(fd);
+		return false;
+	}
+
+	auto size = static_cast<std::size_t>(st.st_size);
+	void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid after the descriptor is closed.
+	close(fd);
+	if (view == MAP_FAILED) {
+		return false;
+	}
+
+	_mapping = view;
+	_size = size;
+#endif
+
+	_data = static_cast<const std::uint8_t*>(_mapping);
+	return true;
+}
+
+/**
+* @brief Reads the whole file at @a path into the owned buffer.
+*/
+bool MappedFile::read(const std::string& path) {
+	if (!readFile(path, _buffer)) {
+		return false;
+	}
+
+	_data = _buffer.data();
+	_size = _buffer.size();
+	return true;
+}
+
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,127 @@
+/**
+* @file src/utils/parallel.cpp
+* @brief Utilities for running independent work items in parallel.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "retdec/utils/io/log.h"
+#include "retdec/utils/parallel.h"
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Returns the number of hardware threads, or @c 1 if it cannot be
+*        determined.
+*/
+unsigned getHardwareConcurrency() {
+	auto n = std::thread::hardware_concurrency();
+	return n ? n : 1;
+}
+
+/**
+* @brief Converts the user-requested number of jobs into the number of
+*        threads to use.
+*
+* @param requested Requested number of jobs. @c 0 means "use all hardware
+*                  threads".
+*/
+unsigned getNumberOfJobs(std::uint64_t requested) {
+	if (requested == 0) {
+		return getHardwareConcurrency();
+	}
+	return static_cast<unsigned>(
+		std::min<std::uint64_t>(requested, 1024)
+	);
+}
+
+/**
+* @brief Calls @a work for every index from <tt>[0, count)</tt> using at most
+*        @a jobs threads.
+*
+* Work items are handed out dynamically, so items of different cost are
+* balanced between threads. The calling thread takes part in the work. If
+* @a jobs is @c 1 (or there is a single item), everything runs on the calling
+* thread in the ascending order of indexes.
+*
+* The first exception thrown by any work item is rethrown after all threads
+* finish. Items that were not started at that point are skipped.
+*
+* Work items log through the loggers of the calling thread (see
+* io::Log::Context).
+*/
+void parallelFor(
+		std::size_t count,
+		unsigned jobs,
+		const std::function<void(std::size_t)>& work) {
+	if (count == 0) {
+		return;
+	}
+
+	auto threads = std::min<std::size_t>(std::max(jobs, 1u), count);
+	if (threads == 1) {
+		for (std::size_t i = 0; i < count; ++i) {
+			work(i);
+		}
+		return;
+	}
+
+	std::atomic<std::size_t> next(0);
+	std::atomic<bool> failed(false);
+	std::exception_ptr error;
+	std::mutex errorMutex;
+
+	auto worker = [&]() {
+		while (!failed) {
+			auto i = next++;
+			if (i >= count) {
+				return;
+			}
+
+			try {
+				work(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (!error) {
+					error = std::current_exception();
+				}
+				failed = true;
+			}
+		}
+	};
+
+	auto* logContext = io::Log::getContext();
+
+	std::vector<std::thread> pool;
+	pool.reserve(threads - 1);
+	for (std::size_t t = 1; t < threads; ++t) {
+		try {
+			pool.emplace_back([&]() {
+				io::Log::ContextScope logScope(logContext);
+				worker();
+			});
+		} catch (const std::system_error&) {
+			// Go on with the threads we already have.
+			break;
+		}
+	}
+	worker();
+	for (auto& t : pool) {
+		t.join();
+	}
+
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+
+} // namespace utils
+} // namespace retdec
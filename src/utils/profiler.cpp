@@ -0,0 +1,228 @@
+/**
+* @file src/utils/profiler.cpp
+* @brief Per-phase timing and memory profile of the decompilation.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+
+#include "retdec/utils/memory.h"
+#include "retdec/utils/profiler.h"
+#include "retdec/utils/time.h"
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+std::atomic<bool> enabled(false);
+std::mutex phasesMutex;
+std::vector<Profiler::Phase> phases;
+
+/// Nesting level of the next phase started by this thread.
+thread_local std::size_t currentLevel = 0;
+
+/**
+* @brief Writes @a str as a JSON string into @a out.
+*/
+void writeJsonString(std::ostream& out, const std::string& str) {
+	out << '"';
+	for (unsigned char c : str) {
+		switch (c) {
+			case '"': out << "\\\""; break;
+			case '\\': out << "\\\\"; break;
+			case '\n': out << "\\n"; break;
+			case '\r': out << "\\r"; break;
+			case '\t': out << "\\t"; break;
+			default:
+				if (c < 0x20) {
+					char buf[7];
+					std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+					out << buf;
+				} else {
+					out << c;
+				}
+		}
+	}
+	out << '"';
+}
+
+/**
+* @brief Writes an optional count into @a out, @c null if it is not set.
+*/
+void writeJsonCount(std::ostream& out, const std::optional<std::uint64_t>& n) {
+	if (n) {
+		out << *n;
+	} else {
+		out << "null";
+	}
+}
+
+} // anonymous namespace
+
+/**
+* @brief Starts measuring the phase @a name, if the profiler is enabled.
+*/
+Profiler::Scope::Scope(const std::string& name) {
+	if (!Profiler::isEnabled()) {
+		return;
+	}
+
+	Phase phase;
+	phase.name = name;
+	phase.level = currentLevel++;
+	{
+		std::lock_guard<std::mutex> lock(phasesMutex);
+		index = phases.size();
+		phases.push_back(std::move(phase));
+	}
+
+	peakRssStart = getPeakMemoryUsage();
+	cpuStart = getElapsedTime();
+	wallStart = std::chrono::steady_clock::now();
+}
+
+Profiler::Scope::~Scope() {
+	stop();
+}
+
+/**
+* @brief Is the phase being recorded?
+*
+* Use this to skip computing counts for @c setCounts() when the profiler is
+* disabled.
+*/
+bool Profiler::Scope::isActive() const {
+	return index.has_value();
+}
+
+/**
+* @brief Stops measuring the phase.
+*
+* Calling it more than once has no effect.
+*/
+void Profiler::Scope::stop() {
+	if (!index || stopped) {
+		return;
+	}
+	stopped = true;
+
+	std::chrono::duration<double> wallTime =
+		std::chrono::steady_clock::now() - wallStart;
+	auto cpuTime = getElapsedTime() - cpuStart;
+	auto peakRss = getPeakMemoryUsage();
+	--currentLevel;
+
+	std::lock_guard<std::mutex> lock(phasesMutex);
+	// The profile may have been cleared in the meantime.
+	if (*index < phases.size()) {
+		auto& phase = phases[*index];
+		phase.wallTime = wallTime.count();
+		phase.cpuTime = cpuTime;
+		phase.peakRssDelta = peakRss > peakRssStart ? peakRss - peakRssStart : 0;
+	}
+}
+
+/**
+* @brief Sets the number of functions and instructions after the phase.
+*
+* It can be called after @c stop(), so that counting is not included in the
+* measured time.
+*/
+void Profiler::Scope::setCounts(std::uint64_t functions,
+		std::uint64_t instructions) {
+	if (!index) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(phasesMutex);
+	if (*index < phases.size()) {
+		phases[*index].functions = functions;
+		phases[*index].instructions = instructions;
+	}
+}
+
+/**
+* @brief Enables profiling of the phases started from now on.
+*/
+void Profiler::enable() {
+	enabled = true;
+}
+
+/**
+* @brief Disables profiling of the phases started from now on.
+*/
+void Profiler::disable() {
+	enabled = false;
+}
+
+/**
+* @brief Is profiling enabled?
+*/
+bool Profiler::isEnabled() {
+	return enabled;
+}
+
+/**
+* @brief Returns all the recorded phases in the order they were started.
+*/
+std::vector<Profiler::Phase> Profiler::getPhases() {
+	std::lock_guard<std::mutex> lock(phasesMutex);
+	return phases;
+}
+
+/**
+* @brief Removes all the recorded phases.
+*/
+void Profiler::clear() {
+	std::lock_guard<std::mutex> lock(phasesMutex);
+	phases.clear();
+}
+
+/**
+* @brief Writes the profile as a JSON array with one object per phase.
+*/
+void Profiler::writeJson(std::ostream& out) {
+	auto ps = getPhases();
+
+	out << "[";
+	for (std::size_t i = 0; i < ps.size(); ++i) {
+		const auto& p = ps[i];
+		out << (i ? ",\n" : "\n") << "    {"
+			<< "\"phase\": ";
+		writeJsonString(out, p.name);
+		out << ", \"level\": " << p.level
+			<< std::fixed << std::setprecision(6)
+			<< ", \"wallTime\": " << p.wallTime
+			<< ", \"cpuTime\": " << p.cpuTime
+			<< ", \"peakRssDelta\": " << p.peakRssDelta
+			<< ", \"functions\": ";
+		writeJsonCount(out, p.functions);
+		out << ", \"instructions\": ";
+		writeJsonCount(out, p.instructions);
+		out << "}";
+	}
+	out << (ps.empty() ? "]" : "\n]") << std::endl;
+}
+
+/**
+* @brief Writes the profile as JSON into the file @a path.
+*
+* @return @c true if the file was written, @c false otherwise.
+*/
+bool Profiler::writeJson(const std::string& path) {
+	std::ofstream out(path);
+	if (!out) {
+		return false;
+	}
+
+	writeJson(out);
+	return static_cast<bool>(out);
+}
+
+} // namespace utils
+} // namespace retdec
@@ -9,6 +9,7 @@
 #include <yara/types.h>
 
 #include "retdec/yaracpp/yara_detector.h"
+#include "retdec/yaracpp/yara_rule_cache.h"
 
 namespace retdec {
 namespace yaracpp {
@@ -44,22 +45,31 @@ struct Scanner<std::string>
 	}
 };
 
+/**
+ * Memory buffer borrowed from the caller.
+ */
+struct MemoryBuffer
+{
+	const std::uint8_t* data;
+	std::size_t size;
+};
+
 /**
  * Specialization for scanning memory buffers.
  */
 template <>
-struct Scanner<std::vector<std::uint8_t>>
+struct Scanner<MemoryBuffer>
 {
 	static bool scan(
 			YR_RULES* rules,
 			YR_CALLBACK_FUNC callback,
 			YaraDetector::CallbackSettings& settings,
-			const std::vector<std::uint8_t>& buffer)
+			const MemoryBuffer& buffer)
 	{
 		return yr_rules_scan_mem(
 				rules,
-				const_cast<uint8_t*>(buffer.data()),
-				buffer.size(),
+				const_cast<uint8_t*>(buffer.data),
+				buffer.size,
 				0,
 				callback,
 				&settings, 0
@@ -104,13 +114,6 @@ YaraDetector::YaraDetector()
  */
 YaraDetector::~YaraDetector()
 {
-	for (auto* file : files)
-	{
-		if (file)
-			fclose(file);
-	}
-
-	files.clear();
 	detectedRules.clear();
 	undetectedRules.clear();
 
@@ -119,14 +122,10 @@ YaraDetector::~YaraDetector()
 		yr_compiler_destroy(compiler);
 	}
 
-	if (textFilesRules)
-		yr_rules_destroy(textFilesRules);
+	if (stringRules)
+		yr_rules_destroy(stringRules);
 
-	for (auto* rules : precompiledRules)
-	{
-		if (rules)
-			yr_rules_destroy(rules);
-	}
+	fileRules.clear();
 
 	yr_finalize();
 }
@@ -290,41 +289,26 @@ bool YaraDetector::addRules(const char *string)
 }
 
 /**
- * Add external file with text rules
+ * Add external file with precompiled or text rules
  * @param pathToFile Path to rule file
  * @param nameSpace Namespace to use for the given rule file. If the file is
- *                  already compiled, this has no effect. If it is a text file,
- *                  this allows to have multiple rules with the same ID across
- *                  multiple rule files.
+ *                  already compiled, this has no effect.
+ *
+ * Rules are taken from YaraRuleCache, so every rule file is loaded or
+ * compiled only once per process. Every text rule file is compiled on its
+ * own, so rules with the same ID may be used across multiple rule files,
+ * but rules cannot reference rules from other files, not even from files
+ * added with the same namespace.
  */
 bool YaraDetector::addRuleFile(
 		const std::string &pathToFile,
 		const std::string &nameSpace)
 {
-	// AT first, try to load the files as precompiled file
-	YR_RULES* rules = nullptr;
-	if (yr_rules_load(pathToFile.c_str(), &rules) == ERROR_SUCCESS)
-	{
-		precompiledRules.push_back(rules);
-	}
-	// If we didn't succeeded consider it as text file
-	else
-	{
-		auto file = fopen(pathToFile.c_str(), "r");
-		if (!file)
-			return false;
-
-		const char* ns = nameSpace.empty() ? nullptr : nameSpace.c_str();
-		if (yr_compiler_add_file(compiler, file, ns, nullptr) != 0)
-		{
-			fclose(file);
-			return false;
-		}
-
-		files.push_back(file);
-		needsRecompilation = true;
-	}
+	auto rules = YaraRuleCache::getInstance().getRules(pathToFile, nameSpace);
+	if (!rules)
+		return false;
 
+	fileRules.push_back(std::move(rules));
 	return true;
 }
 
@@ -360,7 +344,27 @@ bool YaraDetector::analyze(
  */
 bool YaraDetector::analyze(std::vector<std::uint8_t> &bytes, bool storeAllRules)
 {
-	return analyzeWithScan(bytes, storeAllRules);
+	return analyze(bytes.data(), bytes.size(), storeAllRules);
+}
+
+/**
+ * Analyze input bytes without copying them
+ * @param data Pointer to input bytes
+ * @param size Number of input bytes
+ * @param storeAllRules If this parameter is set to @c true,
+ *                      store all rules (not only detected)
+ * @return @c true if analysis completed without any error, otherwise @c false.
+ *
+ * Bytes are scanned in place against all added rule sets, so e.g.
+ * a memory-mapped input file can be scanned by several detectors without
+ * reading it again.
+ */
+bool YaraDetector::analyze(
+		const std::uint8_t *data,
+		std::size_t size,
+		bool storeAllRules)
+{
+	return analyzeWithScan(MemoryBuffer{data, size}, storeAllRules);
 }
 
 /**
@@ -397,16 +401,19 @@ bool YaraDetector::analyzeWithScan(T&& value, bool storeAllRules)
 			undetectedRules
 	);
 
-	auto rules = getCompiledRules();
-	if (!(rules))
-		return false;
+	if (needsRecompilation || stringRules)
+	{
+		auto rules = getCompiledRules();
+		if (!(rules))
+			return false;
 
-	if (!scan(rules, yaraCallback, settings, std::forward<T>(value)))
-		return false;
+		if (!scan(rules, yaraCallback, settings, value))
+			return false;
+	}
 
-	for (auto* rules : precompiledRules)
+	for (const auto& rules : fileRules)
 	{
-		if (!scan(rules, yaraCallback, settings, std::forward<T>(value)))
+		if (!scan(rules.get(), yaraCallback, settings, value))
 			return false;
 	}
 
@@ -414,15 +421,14 @@ bool YaraDetector::analyzeWithScan(T&& value, bool storeAllRules)
 }
 
 /**
- * Returns the compiled rules from text files.
+ * Returns the compiled rules from strings.
  * @return Compiled rules.
  */
 YR_RULES* YaraDetector::getCompiledRules()
 {
-	// File is text file and needs to be compiled first
-	// All text files are compiled into single YR_RULES structure and
+	// All strings are compiled into single YR_RULES structure and
 	// we shouldn't compile it twice if it's not needed
-	// analyze() called for the first time or the file was added since the
+	// analyze() called for the first time or rules were added since the
 	// last analyze() call
 	if (needsRecompilation)
 	{
@@ -430,14 +436,14 @@ YR_RULES* YaraDetector::getCompiledRules()
 		if (yr_compiler_get_rules(compiler, &rules) != ERROR_SUCCESS)
 			return nullptr;
 
-		if (textFilesRules)
-			yr_rules_destroy(textFilesRules);
+		if (stringRules)
+			yr_rules_destroy(stringRules);
 
-		textFilesRules = rules;
+		stringRules = rules;
 		needsRecompilation = false;
 	}
 
-	return textFilesRules;
+	return stringRules;
 }
 
 } // namespace yaracpp
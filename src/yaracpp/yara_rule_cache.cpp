@@ -0,0 +1,248 @@
+/**
+ * @file src/yaracpp/yara_rule_cache.cpp
+ * @brief Process-wide cache of compiled YARA rules.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <thread>
+
+#include <yara.h>
+#include <yara/compiler.h>
+
+#include "retdec/yaracpp/yara_rule_cache.h"
+
+namespace retdec {
+namespace yaracpp {
+
+namespace {
+
+/**
+ * Take ownership of @a rules
+ */
+std::shared_ptr<YR_RULES> makeSharedRules(YR_RULES* rules)
+{
+	return std::shared_ptr<YR_RULES>(rules, yr_rules_destroy);
+}
+
+/**
+ * Compile text rule file
+ * @param pathToFile Path to rule file
+ * @param nameSpace Namespace of rules (empty for default namespace)
+ * @return Compiled rules or @c nullptr if the file cannot be compiled
+ */
+YR_RULES* compileRuleFile(
+		const std::string &pathToFile,
+		const std::string &nameSpace)
+{
+	auto file = fopen(pathToFile.c_str(), "r");
+	if (!file)
+		return nullptr;
+
+	YR_RULES* rules = nullptr;
+	YR_COMPILER* compiler = nullptr;
+	if (yr_compiler_create(&compiler) == ERROR_SUCCESS)
+	{
+		const char* ns = nameSpace.empty() ? nullptr : nameSpace.c_str();
+		if (yr_compiler_add_file(compiler, file, ns, nullptr) == 0
+				&& yr_compiler_get_rules(compiler, &rules) != ERROR_SUCCESS)
+		{
+			rules = nullptr;
+		}
+
+		yr_compiler_destroy(compiler);
+	}
+
+	fclose(file);
+	return rules;
+}
+
+} // anonymous namespace
+
+/**
+ * Get the cache shared by the whole process
+ */
+YaraRuleCache& YaraRuleCache::getInstance()
+{
+	static YaraRuleCache instance;
+	return instance;
+}
+
+/**
+ * Constructor
+ */
+YaraRuleCache::YaraRuleCache()
+{
+	initialized = (yr_initialize() == ERROR_SUCCESS);
+}
+
+/**
+ * Destructor
+ */
+YaraRuleCache::~YaraRuleCache()
+{
+	entries.clear();
+
+	if (initialized)
+		yr_finalize();
+}
+
+/**
+ * Get rules from rule file
+ * @param pathToFile Path to precompiled or text rule file
+ * @param nameSpace Namespace to use for the given rule file. If the file is
+ *                  already compiled, this has no effect.
+ * @return Loaded rules or @c nullptr if the file cannot be loaded
+ *
+ * Rules are loaded only when they are requested for the first time or when
+ * the rule file has been modified since they were loaded.
+ */
+std::shared_ptr<YR_RULES> YaraRuleCache::getRules(
+		const std::string &pathToFile,
+		const std::string &nameSpace)
+{
+	std::error_code ec;
+	const auto modificationTime = fs::last_write_time(pathToFile, ec);
+	if (ec)
+		return nullptr;
+
+	const auto key = std::make_pair(pathToFile, nameSpace);
+	bool persist = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!initialized)
+			return nullptr;
+
+		auto it = entries.find(key);
+		if (it != entries.end() && it->second.modificationTime == modificationTime)
+			return it->second.rules;
+
+		persist = persistCompiledRules;
+	}
+
+	// Rules are loaded without holding the lock, so that long compilation
+	// of one file does not block detectors using other files.
+	auto rules = loadRules(pathToFile, nameSpace, modificationTime, persist);
+	if (!rules)
+		return nullptr;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto &entry = entries[key];
+	// Another thread may have loaded the same file in the meantime.
+	if (entry.rules && entry.modificationTime == modificationTime)
+		return entry.rules;
+
+	entry.modificationTime = modificationTime;
+	entry.rules = rules;
+	return rules;
+}
+
+/**
+ * Set whether compiled text rules are stored next to their source files
+ * @param persist If this parameter is set to @c true, compiled rules are
+ *    stored into file given by @c getCompiledRulesPath() and loaded from
+ *    it in later runs, as long as they are not older than the text rules
+ */
+void YaraRuleCache::setPersistCompiledRules(bool persist)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	persistCompiledRules = persist;
+}
+
+/**
+ * Check if compiled text rules are stored next to their source files
+ */
+bool YaraRuleCache::getPersistCompiledRules() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return persistCompiledRules;
+}
+
+/**
+ * Remove all rules from cache
+ *
+ * Rules still used by some detector are destroyed when it stops using them.
+ */
+void YaraRuleCache::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.clear();
+}
+
+/**
+ * Get path to file with persisted compiled rules
+ * @param pathToFile Path to text rule file
+ * @param nameSpace Namespace of rules
+ * @return Path to file next to the rule file with extension @c .yarac
+ *    (preceded by namespace if it is not empty)
+ */
+std::string YaraRuleCache::getCompiledRulesPath(
+		const std::string &pathToFile,
+		const std::string &nameSpace)
+{
+	auto path = fs::path(pathToFile);
+	path.replace_extension(nameSpace.empty()
+			? ".yarac"
+			: "." + nameSpace + ".yarac");
+	return path.string();
+}
+
+/**
+ * Load rules from rule file
+ * @param pathToFile Path to precompiled or text rule file
+ * @param nameSpace Namespace of rules from text rule file
+ * @param modificationTime Modification time of rule file
+ * @param persist If this parameter is set to @c true, use and store
+ *    compiled rules next to text rule file
+ * @return Loaded rules or @c nullptr if the file cannot be loaded
+ */
+std::shared_ptr<YR_RULES> YaraRuleCache::loadRules(
+		const std::string &pathToFile,
+		const std::string &nameSpace,
+		fs::file_time_type modificationTime,
+		bool persist)
+{
+	// At first, try to load the file as precompiled file.
+	YR_RULES* rules = nullptr;
+	if (yr_rules_load(pathToFile.c_str(), &rules) == ERROR_SUCCESS)
+		return makeSharedRules(rules);
+
+	const auto compiledPath = getCompiledRulesPath(pathToFile, nameSpace);
+	persist = persist && compiledPath != pathToFile;
+	if (persist)
+	{
+		std::error_code ec;
+		const auto compiledTime = fs::last_write_time(compiledPath, ec);
+		if (!ec
+				&& compiledTime >= modificationTime
+				&& yr_rules_load(compiledPath.c_str(), &rules) == ERROR_SUCCESS)
+		{
+			return makeSharedRules(rules);
+		}
+	}
+
+	rules = compileRuleFile(pathToFile, nameSpace);
+	if (!rules)
+		return nullptr;
+
+	if (persist)
+	{
+		// Write into temporary file first, so that other processes never
+		// load partially written rules.
+		std::error_code ec;
+		const auto tmpPath = compiledPath + ".tmp."
+				+ std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()))
+				+ "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+		if (yr_rules_save(rules, tmpPath.c_str()) == ERROR_SUCCESS)
+			fs::rename(tmpPath, compiledPath, ec);
+		else
+			fs::remove(tmpPath, ec);
+	}
+
+	return makeSharedRules(rules);
+}
+
+} // namespace yaracpp
+} // namespace retdec
@@ -44,6 +44,39 @@ DummyTest)
 	EXPECT_EQ( nullptr, module->getGlobalVariable("glob1") );
 }
 
+TEST_F(ReachingDefinitionsTests,
+definitionsFromBothBranchesReachUseAfterJoin)
+{
+	parseInput(R"(
+		@glob0 = global i32 0
+		define void @func1(i1 %c) {
+		entry:
+			br i1 %c, label %left, label %right
+		left:
+			store i32 1, i32* @glob0
+			br label %join
+		right:
+			store i32 2, i32* @glob0
+			br label %join
+		join:
+			%x = load i32, i32* @glob0
+			ret void
+		}
+	)");
+	auto* l = getInstructionByName("x");
+
+	RDA.runOnModule(*module);
+
+	auto* use = RDA.getUse(l);
+	ASSERT_NE(nullptr, use);
+	EXPECT_EQ(2, use->defs.size());
+	for (auto* d : use->defs)
+	{
+		EXPECT_TRUE(isa<StoreInst>(d->def));
+		EXPECT_EQ(1, RDA.usesFromDef(d->def).size());
+	}
+}
+
 } // namespace tests
 } // namespace bin2llvmir
 } // namespace retdec
@@ -4,6 +4,9 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <chrono>
+#include <iostream>
+
 #include <gtest/gtest.h>
 
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
@@ -153,6 +156,105 @@ TEST_F(AsmInstructionTests, getBasicBlockAddressReturnsAddressIfAddrInfoAvailabl
 	EXPECT_EQ(1234, addr);
 }
 
+//
+// getTrueBasicBlockAddress()
+//
+
+TEST_F(AsmInstructionTests, getTrueBasicBlockAddressReturnsUndefAddressIfNotGeneratedName)
+{
+	parseInput(R"(
+		define void @fnc() {
+		bb:
+			%a = add i32 0, 1
+			ret void
+		}
+	)");
+	auto* bb = getInstructionByName("a")->getParent();
+	AsmInstruction::setTrueBasicBlockAddress(bb, 0x1000);
+
+	auto addr = AsmInstruction::getTrueBasicBlockAddress(bb);
+
+	EXPECT_TRUE(addr.isUndefined());
+}
+
+TEST_F(AsmInstructionTests, getTrueBasicBlockAddressPrefersAddressFromTable)
+{
+	parseInput(R"(
+		define void @fnc() {
+		dec_label_pc_1000:
+			store volatile i64 1234, i64* @llvm2asm
+			%a = add i32 0, 1
+			ret void
+		}
+		@llvm2asm = global i64 0
+	)");
+	auto* mapGv = getGlobalByName("llvm2asm");
+	AsmInstruction::setLlvmToAsmGlobalVariable(module.get(), mapGv);
+	auto* bb = getInstructionByName("a")->getParent();
+	AsmInstruction::setTrueBasicBlockAddress(bb, 0x2000);
+
+	auto addr = AsmInstruction::getTrueBasicBlockAddress(bb);
+
+	EXPECT_EQ(0x2000, addr);
+}
+
+TEST_F(AsmInstructionTests, getTrueBasicBlockAddressUsesInstructionAddressIfNotInTable)
+{
+	parseInput(R"(
+		define void @fnc() {
+		dec_label_pc_1000:
+			store volatile i64 1234, i64* @llvm2asm
+			%a = add i32 0, 1
+			ret void
+		}
+		@llvm2asm = global i64 0
+	)");
+	auto* mapGv = getGlobalByName("llvm2asm");
+	AsmInstruction::setLlvmToAsmGlobalVariable(module.get(), mapGv);
+	auto* bb = getInstructionByName("a")->getParent();
+
+	auto addr = AsmInstruction::getTrueBasicBlockAddress(bb);
+
+	EXPECT_EQ(1234, addr);
+}
+
+TEST_F(AsmInstructionTests, getTrueBasicBlockAddressParsesNameIfNotInTable)
+{
+	parseInput(R"(
+		define void @fnc() {
+		dec_label_pc_1000:
+			%a = add i32 0, 1
+			ret void
+		}
+	)");
+	auto* bb = getInstructionByName("a")->getParent();
+
+	auto addr = AsmInstruction::getTrueBasicBlockAddress(bb);
+
+	EXPECT_EQ(0x1000, addr);
+}
+
+TEST_F(AsmInstructionTests, getTrueBasicBlockAddressDropsTableEntryOfDeletedBasicBlock)
+{
+	parseInput(R"(
+		define void @fnc() {
+			ret void
+		dec_label_pc_1000:
+			ret void
+		}
+	)");
+	auto* f = getFunctionByName("fnc");
+	auto* bb = &f->back();
+	AsmInstruction::setTrueBasicBlockAddress(bb, 0x2000);
+	bb->eraseFromParent();
+	auto* newBb = llvm::BasicBlock::Create(context, "dec_label_pc_1000", f);
+	llvm::ReturnInst::Create(context, newBb);
+
+	auto addr = AsmInstruction::getTrueBasicBlockAddress(newBb);
+
+	EXPECT_EQ(0x1000, addr);
+}
+
 //
 // isLlvmToAsmInstruction()
 //
@@ -1706,6 +1808,91 @@ TEST_F(AsmInstructionTests, getInstructionFirstReturnsNullptrIfItDoesNotContainI
 	EXPECT_EQ(nullptr, ai.getInstructionFirst<llvm::CallInst>());
 }
 
+//
+// getCapstoneInsn()
+//
+
+TEST_F(AsmInstructionTests, getCapstoneInsnReturnsMappedInsn)
+{
+	parseInput(R"(
+		define void @fnc() {
+			store volatile i64 1234, i64* @llvm2asm
+			store volatile i64 5678, i64* @llvm2asm
+			ret void
+		}
+		@llvm2asm = global i64 0
+	)");
+	auto* mapGv = getGlobalByName("llvm2asm");
+	AsmInstruction::setLlvmToAsmGlobalVariable(module.get(), mapGv);
+	cs_insn insn = {};
+	auto* s = getNthInstruction<StoreInst>(0);
+	AsmInstruction::getLlvmToCapstoneInsnMap(module.get()).try_emplace(s, &insn);
+
+	EXPECT_EQ(&insn, AsmInstruction(module.get(), 1234).getCapstoneInsn());
+	EXPECT_EQ(nullptr, AsmInstruction(module.get(), 5678).getCapstoneInsn());
+}
+
+TEST_F(AsmInstructionTests, getCapstoneInsnReturnsNullptrIfModuleHasNoMap)
+{
+	parseInput(R"(
+		define void @fnc() {
+			store volatile i64 1234, i64* @llvm2asm
+			ret void
+		}
+		@llvm2asm = global i64 0
+	)");
+	auto* mapGv = getGlobalByName("llvm2asm");
+	AsmInstruction::setLlvmToAsmGlobalVariable(module.get(), mapGv);
+
+	EXPECT_EQ(nullptr, AsmInstruction(module.get(), 1234).getCapstoneInsn());
+}
+
+/**
+ * Micro-benchmark of iteration over ASM instructions of a large module and of
+ * their mapping to Capstone instructions.
+ * Run it with --gtest_also_run_disabled_tests.
+ */
+TEST_F(AsmInstructionTests, DISABLED_benchmarkIterationOverMillionInstructions)
+{
+	const std::size_t numInsns = 1000000;
+	auto* i64 = Type::getInt64Ty(context);
+	auto* mapGv = new GlobalVariable(
+			*module,
+			i64,
+			false,
+			GlobalValue::ExternalLinkage,
+			ConstantInt::get(i64, 0),
+			"llvm2asm");
+	AsmInstruction::setLlvmToAsmGlobalVariable(module.get(), mapGv);
+	auto* fnc = Function::Create(
+			FunctionType::get(Type::getVoidTy(context), false),
+			GlobalValue::ExternalLinkage,
+			"fnc",
+			module.get());
+	IRBuilder<> irb(BasicBlock::Create(context, "", fnc));
+	std::vector<cs_insn> insns(numInsns);
+	auto& insnMap = AsmInstruction::getLlvmToCapstoneInsnMap(module.get());
+	for (std::size_t i = 0; i < numInsns; ++i)
+	{
+		auto* s = irb.CreateStore(ConstantInt::get(i64, i * 4), mapGv, true);
+		insnMap.try_emplace(s, &insns[i]);
+		irb.CreateLoad(i64, mapGv);
+	}
+	irb.CreateRetVoid();
+
+	auto start = std::chrono::steady_clock::now();
+	std::size_t found = 0;
+	for (AsmInstruction ai(fnc); ai.isValid(); ai = ai.getNext())
+	{
+		found += ai.getCapstoneInsn() != nullptr;
+	}
+	std::chrono::duration<double, std::milli> time =
+			std::chrono::steady_clock::now() - start;
+
+	std::cout << numInsns << " instructions: " << time.count() << " ms\n";
+	EXPECT_EQ(numInsns, found);
+}
+
 } // namespace tests
 } // namespace bin2llvmir
 } // namespace retdec
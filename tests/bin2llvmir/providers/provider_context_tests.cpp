@@ -0,0 +1,105 @@
+/**
+* @file tests/bin2llvmir/providers/tests/provider_context_tests.cpp
+* @brief Tests for the @c ProviderContext.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <thread>
+
+#include "retdec/bin2llvmir/providers/config.h"
+#include "retdec/bin2llvmir/providers/provider_context.h"
+#include "bin2llvmir/utils/llvmir_tests.h"
+
+using namespace ::testing;
+using namespace llvm;
+
+namespace retdec {
+namespace bin2llvmir {
+namespace tests {
+
+/**
+ * @brief Tests for the @c ProviderContext.
+ */
+class ProviderContextTests: public LlvmIrTests
+{
+	protected:
+		/**
+		 * Repeatedly create a context for the module @a m, add a config
+		 * with the input file @a name into it, and check that the context
+		 * sees only this config.
+		 * @return @c true if all the checks passed.
+		 */
+		bool decompileRepeatedly(Module* m, const std::string& name)
+		{
+			retdec::config::Config c;
+			c.parameters.setInputFile(name);
+
+			for (unsigned i = 0; i < 1000; ++i)
+			{
+				ProviderContext ctx(m);
+				ConfigProvider::addConfig(m, c);
+
+				auto* config = ctx.getConfig();
+				if (config == nullptr
+						|| config->getConfig().parameters.getInputFile() != name)
+				{
+					return false;
+				}
+			}
+			return ConfigProvider::getConfig(m) == nullptr;
+		}
+};
+
+TEST_F(ProviderContextTests, getConfigReturnsConfigOfContextModule)
+{
+	LLVMContext context2;
+	Module module2("module2", context2);
+	retdec::config::Config c1;
+	c1.parameters.setInputFile("first");
+	retdec::config::Config c2;
+	c2.parameters.setInputFile("second");
+	ConfigProvider::addConfig(module.get(), c1);
+	ConfigProvider::addConfig(&module2, c2);
+
+	ProviderContext ctx1(module.get());
+	ProviderContext ctx2(&module2);
+
+	EXPECT_EQ("first", ctx1.getConfig()->getConfig().parameters.getInputFile());
+	EXPECT_EQ("second", ctx2.getConfig()->getConfig().parameters.getInputFile());
+}
+
+TEST_F(ProviderContextTests, destructorClearsOnlyDataOfContextModule)
+{
+	LLVMContext context2;
+	Module module2("module2", context2);
+	retdec::config::Config c;
+	ConfigProvider::addConfig(module.get(), c);
+	ConfigProvider::addConfig(&module2, c);
+
+	{
+		ProviderContext ctx(module.get());
+	}
+
+	EXPECT_EQ(nullptr, ConfigProvider::getConfig(module.get()));
+	EXPECT_NE(nullptr, ConfigProvider::getConfig(&module2));
+}
+
+TEST_F(ProviderContextTests, contextsOfParallelDecompilationsDoNotInterfere)
+{
+	LLVMContext context2;
+	Module module2("module2", context2);
+	bool ok1 = false;
+	bool ok2 = false;
+
+	std::thread t1([&]() { ok1 = decompileRepeatedly(module.get(), "first"); });
+	std::thread t2([&]() { ok2 = decompileRepeatedly(&module2, "second"); });
+	t1.join();
+	t2.join();
+
+	EXPECT_TRUE(ok1);
+	EXPECT_TRUE(ok2);
+}
+
+} // namespace tests
+} // namespace bin2llvmir
+} // namespace retdec
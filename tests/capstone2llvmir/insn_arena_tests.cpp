@@ -0,0 +1,124 @@
+/**
+ * @file tests/capstone2llvmir/insn_arena_tests.cpp
+ * @brief InsnArena unit tests.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "retdec/capstone2llvmir/insn_arena.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace capstone2llvmir {
+namespace tests {
+
+class InsnArenaTests : public Test
+{
+
+};
+
+TEST_F(InsnArenaTests, allocateReturnsDistinctInsnsWithOwnDetails)
+{
+	InsnArena arena(2);
+	std::set<cs_insn*> insns;
+	std::set<cs_detail*> details;
+
+	for (int i = 0; i < 5; ++i)
+	{
+		auto* insn = arena.allocate();
+		ASSERT_NE(nullptr, insn);
+		ASSERT_NE(nullptr, insn->detail);
+		insns.insert(insn);
+		details.insert(insn->detail);
+	}
+
+	EXPECT_EQ(5, insns.size());
+	EXPECT_EQ(5, details.size());
+	EXPECT_EQ(5, arena.size());
+}
+
+TEST_F(InsnArenaTests, allocateCopyCopiesInsnWithDetailIntoOwnRecord)
+{
+	InsnArena other;
+	auto* insn = other.allocate();
+	insn->id = 42;
+	insn->size = 3;
+	insn->detail->regs_read_count = 2;
+	InsnArena arena;
+
+	auto* copy = arena.allocateCopy(*insn);
+	other.clear();
+
+	EXPECT_EQ(1, arena.size());
+	EXPECT_EQ(42, copy->id);
+	EXPECT_EQ(3, copy->size);
+	ASSERT_NE(nullptr, copy->detail);
+	EXPECT_EQ(2, copy->detail->regs_read_count);
+}
+
+TEST_F(InsnArenaTests, deallocateReusesLastInsn)
+{
+	InsnArena arena;
+	auto* insn1 = arena.allocate();
+	auto* insn2 = arena.allocate();
+
+	arena.deallocate(insn2);
+	EXPECT_EQ(1, arena.size());
+	EXPECT_EQ(insn2, arena.allocate());
+
+	arena.deallocate(insn1);
+	EXPECT_EQ(2, arena.size());
+}
+
+TEST_F(InsnArenaTests, clearFreesAllInsns)
+{
+	InsnArena arena;
+	arena.allocate();
+	arena.allocate();
+
+	arena.clear();
+
+	EXPECT_EQ(0, arena.size());
+	EXPECT_NE(nullptr, arena.allocate());
+}
+
+TEST_F(InsnArenaTests, mergeTakesOverInsnsAndKeepsCurrentChunk)
+{
+	InsnArena arena(4);
+	InsnArena other(2);
+	auto* insn1 = arena.allocate();
+	auto* insn2 = other.allocate();
+	insn2->id = 42;
+
+	arena.merge(std::move(other));
+
+	EXPECT_EQ(2, arena.size());
+	EXPECT_EQ(0, other.size());
+	EXPECT_EQ(42, insn2->id);
+	auto* insn3 = arena.allocate();
+	EXPECT_NE(insn1, insn3);
+	EXPECT_NE(insn2, insn3);
+	arena.deallocate(insn3);
+	EXPECT_EQ(2, arena.size());
+}
+
+TEST_F(InsnArenaTests, mergeIntoEmptyArenaDoesNotReuseMergedInsns)
+{
+	InsnArena arena(2);
+	InsnArena other(2);
+	auto* insn1 = other.allocate();
+
+	arena.merge(std::move(other));
+	auto* insn2 = arena.allocate();
+
+	EXPECT_NE(insn1, insn2);
+	EXPECT_EQ(2, arena.size());
+}
+
+} // namespace tests
+} // namespace capstone2llvmir
+} // namespace retdec
@@ -0,0 +1,96 @@
+/**
+* @file tests/fileformat/crypto_tests.cpp
+* @brief Tests for the @c crypto module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/utils/crypto.h"
+#include "retdec/fileformat/utils/other.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+/**
+ * Tests for the @c crypto module.
+ */
+class CryptoTests : public Test
+{
+	protected:
+		/**
+		 * Returns @a length bytes of pseudo-random data.
+		 */
+		std::vector<unsigned char> getData(std::uint64_t length)
+		{
+			std::vector<unsigned char> data(length);
+			std::uint32_t state = 12345;
+			for (auto &b : data)
+			{
+				state = state * 1103515245 + 12345;
+				b = static_cast<unsigned char>(state >> 16);
+			}
+			return data;
+		}
+
+		/**
+		 * Checks that all the digests computed in one pass are the same as
+		 * the ones computed by the separate functions.
+		 */
+		void checkDigestsOf(const std::vector<unsigned char> &data)
+		{
+			auto digests = computeDigests(
+					data.data(),
+					data.size(),
+					DIGEST_CRC32 | DIGEST_MD5 | DIGEST_SHA1
+						| DIGEST_SHA256 | DIGEST_ENTROPY
+			);
+
+			EXPECT_EQ(getCrc32(data.data(), data.size()), digests.crc32);
+			EXPECT_EQ(getMd5(data.data(), data.size()), digests.md5);
+			EXPECT_EQ(getSha1(data.data(), data.size()), digests.sha1);
+			EXPECT_EQ(getSha256(data.data(), data.size()), digests.sha256);
+			EXPECT_DOUBLE_EQ(
+					computeDataEntropy(data.data(), data.size()),
+					digests.entropy
+			);
+		}
+};
+
+TEST_F(CryptoTests, ComputeDigestsOfEmptyDataIsSameAsSeparateFunctions)
+{
+	checkDigestsOf(getData(0));
+}
+
+TEST_F(CryptoTests, ComputeDigestsOfDataShorterThanBlockIsSameAsSeparateFunctions)
+{
+	checkDigestsOf(getData(1000));
+}
+
+TEST_F(CryptoTests, ComputeDigestsOfDataLongerThanBlockIsSameAsSeparateFunctions)
+{
+	// Longer than DIGEST_BLOCK_SIZE (64 KiB), with a partial last block.
+	checkDigestsOf(getData(3 * 64 * 1024 + 123));
+}
+
+TEST_F(CryptoTests, ComputeDigestsComputesOnlyRequestedDigests)
+{
+	auto data = getData(1000);
+
+	auto digests = computeDigests(data.data(), data.size(), DIGEST_MD5);
+
+	EXPECT_EQ(getMd5(data.data(), data.size()), digests.md5);
+	EXPECT_TRUE(digests.crc32.empty());
+	EXPECT_TRUE(digests.sha1.empty());
+	EXPECT_TRUE(digests.sha256.empty());
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -0,0 +1,152 @@
+/**
+* @file tests/fileformat/file_format_tests.cpp
+* @brief Tests for the @c file_format module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/file_format/elf/elf_format.h"
+#include "retdec/fileformat/file_format/intel_hex/intel_hex_format.h"
+#include "retdec/fileformat/file_format/macho/macho_format.h"
+#include "retdec/fileformat/file_format/pe/pe_format.h"
+#include "fileformat/fileformat_tests.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+/**
+ * Tests for parts of file which are loaded on first use.
+ */
+class FileFormatLazyLoadingTests : public Test
+{
+	protected:
+		/**
+		 * Request strings and certificate table of @a parallel from several
+		 * threads at once and check that they are the same as the ones
+		 * of @a sequential, which are requested from a single thread.
+		 */
+		void checkPartsAreSameWhenRequestedInParallel(
+				const FileFormat &sequential,
+				const FileFormat &parallel)
+		{
+			const auto &strings = sequential.getStrings();
+			const auto *certificateTable = sequential.getCertificateTable();
+
+			std::vector<const std::vector<String>*> parallelStrings(4);
+			std::vector<const CertificateTable*> parallelCertificateTables(4);
+			std::vector<std::thread> threads;
+			for (std::size_t i = 0; i < parallelStrings.size(); ++i)
+			{
+				threads.emplace_back([&, i]() {
+					parallelStrings[i] = &parallel.getStrings();
+					parallelCertificateTables[i] = parallel.getCertificateTable();
+				});
+			}
+			for (auto &thread : threads)
+			{
+				thread.join();
+			}
+
+			for (std::size_t i = 0; i < parallelStrings.size(); ++i)
+			{
+				EXPECT_EQ(&parallel.getStrings(), parallelStrings[i]);
+				EXPECT_EQ(strings, *parallelStrings[i]);
+				EXPECT_EQ(parallel.getCertificateTable(), parallelCertificateTables[i]);
+				EXPECT_EQ(certificateTable == nullptr, parallelCertificateTables[i] == nullptr);
+			}
+		}
+};
+
+TEST_F(FileFormatLazyLoadingTests, ElfStringsAreSameAfterLazyLoading)
+{
+	ElfFormat parser(elfBytes.data(), elfBytes.size(), LoadFlags::DETECT_STRINGS);
+
+	const auto &strings = parser.getStrings();
+
+	ASSERT_EQ(1, strings.size());
+	EXPECT_TRUE(strings[0].isAscii());
+	EXPECT_EQ(7, strings[0].getFileOffset());
+	EXPECT_EQ("Hi World", strings[0].getContent());
+	EXPECT_EQ(&strings, &parser.getStrings());
+	EXPECT_EQ(1, parser.getStrings().size());
+}
+
+TEST_F(FileFormatLazyLoadingTests, IntelHexStringsAreSameAfterLazyLoading)
+{
+	std::stringstream ihexStream(ihexBytes);
+	IntelHexFormat parser(ihexStream, LoadFlags::DETECT_STRINGS);
+
+	const auto &strings = parser.getStrings();
+
+	ASSERT_EQ(2, strings.size());
+	EXPECT_EQ(68, strings[0].getFileOffset());
+	EXPECT_EQ("Ny#F#", strings[0].getContent());
+	EXPECT_EQ(85, strings[1].getFileOffset());
+	EXPECT_EQ("Vp+^q+r+s!F", strings[1].getContent());
+	EXPECT_EQ(&strings, &parser.getStrings());
+	EXPECT_EQ(2, parser.getStrings().size());
+}
+
+TEST_F(FileFormatLazyLoadingTests, StringsAreNotLoadedWithoutDetectStringsFlag)
+{
+	ElfFormat parser(elfBytes.data(), elfBytes.size());
+
+	EXPECT_TRUE(parser.getStrings().empty());
+}
+
+TEST_F(FileFormatLazyLoadingTests, ElfPartsAreSameWhenRequestedInParallel)
+{
+	ElfFormat sequential(elfBytes.data(), elfBytes.size(), LoadFlags::DETECT_STRINGS);
+	ElfFormat parallel(elfBytes.data(), elfBytes.size(), LoadFlags::DETECT_STRINGS);
+
+	checkPartsAreSameWhenRequestedInParallel(sequential, parallel);
+}
+
+TEST_F(FileFormatLazyLoadingTests, MachOPartsAreSameWhenRequestedInParallel)
+{
+	MachOFormat sequential(machoBytes.data(), machoBytes.size(), LoadFlags::DETECT_STRINGS);
+	MachOFormat parallel(machoBytes.data(), machoBytes.size(), LoadFlags::DETECT_STRINGS);
+
+	checkPartsAreSameWhenRequestedInParallel(sequential, parallel);
+}
+
+TEST_F(FileFormatLazyLoadingTests, PePartsAreSameWhenRequestedInParallel)
+{
+	PeFormat sequential(peBytes.data(), peBytes.size(), LoadFlags::DETECT_STRINGS);
+	PeFormat parallel(peBytes.data(), peBytes.size(), LoadFlags::DETECT_STRINGS);
+
+	checkPartsAreSameWhenRequestedInParallel(sequential, parallel);
+
+	const auto &classes = sequential.getDefinedDotnetClasses();
+	std::vector<std::size_t> parallelClassCounts(4);
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < parallelClassCounts.size(); ++i)
+	{
+		threads.emplace_back([&, i]() {
+			parallelClassCounts[i] = parallel.getDefinedDotnetClasses().size();
+		});
+	}
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+
+	for (auto count : parallelClassCounts)
+	{
+		EXPECT_EQ(classes.size(), count);
+	}
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -204,6 +204,54 @@ TEST_F(PeFormatTests_data, DataInterpretationDefault)
 	EXPECT_EQ(0x105d0040103805c7, res);
 }
 
+/**
+ * Tests for the @c pe_format module - file with debug directory.
+ */
+class PeFormatTests_debugDirectory : public Test
+{
+	protected:
+		/// RVA of the data of the only debug directory entry
+		static const std::uint32_t debugDataRva = 0x11e0;
+		/// size of the data of the only debug directory entry
+		static const std::uint32_t debugDataSize = 0x10;
+
+		std::unique_ptr<PeFormat> parser;
+
+	public:
+		PeFormatTests_debugDirectory() : bytes(peBytes)
+		{
+			// Debug data directory pointing to one entry at RVA 0x11c0.
+			write32(0xe8, 0x11c0);
+			write32(0xec, 28);
+			// The entry (IMAGE_DEBUG_TYPE_CODEVIEW) with data at RVA 0x11e0.
+			write32(0x3c0 + 12, 2);
+			write32(0x3c0 + 16, debugDataSize);
+			write32(0x3c0 + 20, debugDataRva);
+			write32(0x3c0 + 24, 0x3e0);
+
+			parser = std::make_unique<PeFormat>(bytes.data(), bytes.size());
+		}
+
+	private:
+		void write32(std::size_t offset, std::uint32_t value)
+		{
+			for (std::size_t i = 0; i < 4; ++i)
+			{
+				bytes[offset + i] = (value >> (8 * i)) & 0xff;
+			}
+		}
+
+		std::vector<uint8_t> bytes;
+};
+
+TEST_F(PeFormatTests_debugDirectory, DebugDataAreNonDecodableWithoutLoadingPdbInfo)
+{
+	const auto &ranges = parser->getNonDecodableAddressRanges();
+
+	EXPECT_TRUE(ranges.contains(debugDataRva));
+	EXPECT_TRUE(ranges.contains(debugDataRva + debugDataSize - 1));
+}
+
 } // namespace tests
 } // namespace fileformat
 } // namespace retdec
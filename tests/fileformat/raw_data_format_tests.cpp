@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -126,6 +127,85 @@ TEST_F(RawDataFormatTests_data, TestInvalidEP)
 	EXPECT_EQ(0x8000, result);
 }
 
+/**
+ * Tests for detection of strings in the @c raw_data module.
+ */
+class RawDataFormatTests_strings : public Test
+{
+	protected:
+		/**
+		 * Load strings from @a data with @a endianness. Raw data form
+		 * a single section, so the strings at the beginning and at the end
+		 * of @a data lie at the section boundaries.
+		 */
+		const std::vector<String>& getStrings(
+				const std::string &data,
+				Endianness endianness = Endianness::LITTLE)
+		{
+			parser = std::make_unique<RawDataFormat>(
+					reinterpret_cast<const std::uint8_t*>(data.data()),
+					data.size(),
+					LoadFlags::DETECT_STRINGS);
+			parser->setEndianness(endianness);
+			return parser->getStrings();
+		}
+
+	private:
+		std::unique_ptr<RawDataFormat> parser;
+};
+
+TEST_F(RawDataFormatTests_strings, AsciiStringsAtSectionBoundariesAreFound)
+{
+	const auto &strings = getStrings(std::string("abcd\x01\x02wxyz", 10));
+
+	ASSERT_EQ(2, strings.size());
+	EXPECT_TRUE(strings[0].isAscii());
+	EXPECT_EQ(0, strings[0].getFileOffset());
+	EXPECT_EQ("abcd", strings[0].getContent());
+	EXPECT_TRUE(strings[1].isAscii());
+	EXPECT_EQ(6, strings[1].getFileOffset());
+	EXPECT_EQ("wxyz", strings[1].getContent());
+}
+
+TEST_F(RawDataFormatTests_strings, LittleEndianWideStringsAtSectionBoundariesAreFound)
+{
+	const auto &strings = getStrings(
+			std::string("a\0b\0c\0d\0\x01\x02w\0x\0y\0z\0", 18));
+
+	ASSERT_EQ(2, strings.size());
+	EXPECT_TRUE(strings[0].isWide());
+	EXPECT_EQ(0, strings[0].getFileOffset());
+	EXPECT_EQ("abcd", strings[0].getContent());
+	EXPECT_TRUE(strings[1].isWide());
+	EXPECT_EQ(10, strings[1].getFileOffset());
+	EXPECT_EQ("wxyz", strings[1].getContent());
+}
+
+TEST_F(RawDataFormatTests_strings, BigEndianWideStringsAtSectionBoundariesAreFound)
+{
+	const auto &strings = getStrings(
+			std::string("\0a\0b\0c\0d\x01\x02\0w\0x\0y\0z", 18),
+			Endianness::BIG);
+
+	ASSERT_EQ(2, strings.size());
+	EXPECT_TRUE(strings[0].isWide());
+	EXPECT_EQ(0, strings[0].getFileOffset());
+	EXPECT_EQ("abcd", strings[0].getContent());
+	EXPECT_TRUE(strings[1].isWide());
+	EXPECT_EQ(10, strings[1].getFileOffset());
+	EXPECT_EQ("wxyz", strings[1].getContent());
+}
+
+TEST_F(RawDataFormatTests_strings, WideStringDoesNotContainCharacterCutBySectionEnd)
+{
+	const auto &strings = getStrings(std::string("w\0x\0y\0z\0q", 9));
+
+	ASSERT_EQ(1, strings.size());
+	EXPECT_TRUE(strings[0].isWide());
+	EXPECT_EQ(0, strings[0].getFileOffset());
+	EXPECT_EQ("wxyz", strings[0].getContent());
+}
+
 } // namespace tests
 } // namespace fileformat
 } // namespace retdec
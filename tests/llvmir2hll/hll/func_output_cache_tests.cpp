@@ -0,0 +1,275 @@
+/**
+* @file tests/llvmir2hll/hll/func_output_cache_tests.cpp
+* @brief Tests for the @c func_output_cache module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <gtest/gtest.h>
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "llvmir2hll/ir/tests_with_module.h"
+#include "retdec/config/config.h"
+#include "retdec/llvmir2hll/hll/func_output_cache.h"
+#include "retdec/llvmir2hll/hll/output_managers/plain_manager.h"
+#include "retdec/llvmir2hll/ir/int_type.h"
+#include "retdec/llvmir2hll/ir/variable.h"
+#include "retdec/utils/filesystem.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace llvmir2hll {
+namespace tests {
+
+/**
+* @brief Tests for the @c func_output_cache module.
+*/
+class FuncOutputCacheTests: public TestsWithModule {
+protected:
+	FuncOutputCacheTests();
+	~FuncOutputCacheTests();
+
+	void addLLVMFunc(const std::string &name, bool withAlloca = false);
+	RecordingOutputManager::Tokens getTokensCallingFunc(
+		const std::string &calleeName) const;
+	RecordingOutputManager::Tokens getTokensUsingGlobalVar(
+		const std::string &varName) const;
+	std::string emitCachedOutput(FuncOutputCache &cache);
+
+protected:
+	std::string dir = (fs::temp_directory_path()
+		/ "retdec-tests-llvmir2hll-func-output-cache").string();
+	retdec::config::Config config;
+};
+
+FuncOutputCacheTests::FuncOutputCacheTests() {
+	fs::remove_all(dir);
+}
+
+FuncOutputCacheTests::~FuncOutputCacheTests() {
+	fs::remove_all(dir);
+}
+
+/**
+* @brief Adds a <tt>void name()</tt> function definition into the LLVM module.
+*/
+void FuncOutputCacheTests::addLLVMFunc(const std::string &name,
+		bool withAlloca) {
+	auto func = llvm::Function::Create(
+		llvm::FunctionType::get(llvm::Type::getVoidTy(llvmContext), false),
+		llvm::GlobalValue::ExternalLinkage, name, &llvmModule);
+	llvm::IRBuilder<> builder(llvm::BasicBlock::Create(llvmContext, "", func));
+	if (withAlloca) {
+		builder.CreateAlloca(llvm::Type::getInt32Ty(llvmContext));
+	}
+	builder.CreateRetVoid();
+}
+
+/**
+* @brief Returns tokens of a call of the function named @a calleeName.
+*/
+RecordingOutputManager::Tokens FuncOutputCacheTests::getTokensCallingFunc(
+		const std::string &calleeName) const {
+	using Kind = RecordingOutputManager::TokenKind;
+	return {
+		{Kind::FunctionId, calleeName, Address()},
+		{Kind::Punctuation, "(", Address()},
+		{Kind::Punctuation, ")", Address()},
+		{Kind::Punctuation, ";", Address()}
+	};
+}
+
+/**
+* @brief Returns tokens of an expression statement using the global variable
+*        named @a varName.
+*/
+RecordingOutputManager::Tokens FuncOutputCacheTests::getTokensUsingGlobalVar(
+		const std::string &varName) const {
+	using Kind = RecordingOutputManager::TokenKind;
+	return {
+		{Kind::GlobalVariableId, varName, Address()},
+		{Kind::Punctuation, ";", Address()}
+	};
+}
+
+/**
+* @brief Returns the cached output of @c testFunc emitted by @a cache.
+*/
+std::string FuncOutputCacheTests::emitCachedOutput(FuncOutputCache &cache) {
+	std::string code;
+	llvm::raw_string_ostream codeStream(code);
+	PlainOutputManager out(codeStream);
+	if (!cache.emitCachedOutput(testFunc, out)) {
+		return "<not emitted>";
+	}
+	return codeStream.str();
+}
+
+TEST_F(FuncOutputCacheTests,
+NothingIsLoadedFromEmptyCache) {
+	addLLVMFunc("test");
+	FuncOutputCache cache(dir, 1000000, "context");
+
+	EXPECT_EQ(0, cache.loadOutputs(module, llvmModule, config));
+	EXPECT_FALSE(module->isFuncOutputCached(testFunc));
+	EXPECT_EQ("<not emitted>", emitCachedOutput(cache));
+}
+
+TEST_F(FuncOutputCacheTests,
+StoredOutputIsLoadedInNextRun) {
+	addLLVMFunc("test");
+	FuncOutputCache cache(dir, 1000000, "context");
+	cache.loadOutputs(module, llvmModule, config);
+	cache.storeOutput(testFunc, getTokensCallingFunc("test"));
+
+	FuncOutputCache otherCache(dir, 1000000, "context");
+
+	EXPECT_EQ(1, otherCache.loadOutputs(module, llvmModule, config));
+	EXPECT_TRUE(module->isFuncOutputCached(testFunc));
+	EXPECT_EQ("test();", emitCachedOutput(otherCache));
+}
+
+TEST_F(FuncOutputCacheTests,
+NamesOfFunctionsInLoadedOutputAreMappedToCurrentNames) {
+	addLLVMFunc("test");
+	FuncOutputCache cache(dir, 1000000, "context");
+	cache.loadOutputs(module, llvmModule, config);
+	cache.storeOutput(testFunc, getTokensCallingFunc("test"));
+	FuncOutputCache otherCache(dir, 1000000, "context");
+	otherCache.loadOutputs(module, llvmModule, config);
+
+	testFunc->setName("renamed");
+
+	EXPECT_EQ("renamed();", emitCachedOutput(otherCache));
+}
+
+TEST_F(FuncOutputCacheTests,
+OutputIsNotLoadedWhenContextDiffers) {
+	addLLVMFunc("test");
+	FuncOutputCache cache(dir, 1000000, "context");
+	cache.loadOutputs(module, llvmModule, config);
+	cache.storeOutput(testFunc, getTokensCallingFunc("test"));
+
+	FuncOutputCache otherCache(dir, 1000000, "other context");
+
+	EXPECT_EQ(0, otherCache.loadOutputs(module, llvmModule, config));
+}
+
+TEST_F(FuncOutputCacheTests,
+OutputIsNotLoadedWhenFuncChanges) {
+	addLLVMFunc("test");
+	FuncOutputCache cache(dir, 1000000, "context");
+	cache.loadOutputs(module, llvmModule, config);
+	cache.storeOutput(testFunc, getTokensCallingFunc("test"));
+
+	llvmModule.getFunction("test")->eraseFromParent();
+	addLLVMFunc("test", true);
+	FuncOutputCache otherCache(dir, 1000000, "context");
+
+	EXPECT_EQ(0, otherCache.loadOutputs(module, llvmModule, config));
+}
+
+TEST_F(FuncOutputCacheTests,
+OutputIsNotLoadedWhenReferencedFuncDoesNotExist) {
+	addLLVMFunc("test");
+	FuncOutputCache cache(dir, 1000000, "context");
+	cache.loadOutputs(module, llvmModule, config);
+	addFuncDecl("other");
+	cache.storeOutput(testFunc, getTokensCallingFunc("other"));
+
+	module->removeFunc(module->getFuncByName("other"));
+	FuncOutputCache otherCache(dir, 1000000, "context");
+
+	EXPECT_EQ(0, otherCache.loadOutputs(module, llvmModule, config));
+}
+
+TEST_F(FuncOutputCacheTests,
+OutputIsNotLoadedWhenReferencedGlobalVarDisappearsBetweenRuns) {
+	addLLVMFunc("test");
+	auto varG = Variable::create("g", IntType::create(32));
+	module->addGlobalVar(varG);
+	FuncOutputCache cache(dir, 1000000, "context");
+	cache.loadOutputs(module, llvmModule, config);
+	cache.storeOutput(testFunc, getTokensUsingGlobalVar("g"));
+
+	module->removeGlobalVar(varG);
+	FuncOutputCache otherCache(dir, 1000000, "context");
+
+	EXPECT_EQ(0, otherCache.loadOutputs(module, llvmModule, config));
+	EXPECT_FALSE(module->isFuncOutputCached(testFunc));
+}
+
+TEST_F(FuncOutputCacheTests,
+GlobalVarReferencedByLoadedOutputIsPreventedFromRemoval) {
+	addLLVMFunc("test");
+	auto varG = Variable::create("g", IntType::create(32));
+	module->addGlobalVar(varG);
+	auto varH = Variable::create("h", IntType::create(32));
+	module->addGlobalVar(varH);
+	FuncOutputCache cache(dir, 1000000, "context");
+	cache.loadOutputs(module, llvmModule, config);
+	cache.storeOutput(testFunc, getTokensUsingGlobalVar("g"));
+
+	FuncOutputCache otherCache(dir, 1000000, "context");
+	otherCache.loadOutputs(module, llvmModule, config);
+
+	EXPECT_FALSE(module->canRemoveVar(varG));
+	EXPECT_TRUE(module->canRemoveVar(varH));
+}
+
+TEST_F(FuncOutputCacheTests,
+OutputIsDroppedWhenReferencedGlobalVarIsRemovedAfterLoading) {
+	addLLVMFunc("test");
+	auto varG = Variable::create("g", IntType::create(32));
+	module->addGlobalVar(varG);
+	FuncOutputCache cache(dir, 1000000, "context");
+	cache.loadOutputs(module, llvmModule, config);
+	cache.storeOutput(testFunc, getTokensUsingGlobalVar("g"));
+	FuncOutputCache otherCache(dir, 1000000, "context");
+	otherCache.loadOutputs(module, llvmModule, config);
+
+	module->removeGlobalVar(varG);
+
+	EXPECT_EQ(FuncVector{testFunc}, otherCache.dropUnusableOutputs());
+	EXPECT_FALSE(module->isFuncOutputCached(testFunc));
+	EXPECT_EQ("<not emitted>", emitCachedOutput(otherCache));
+}
+
+TEST_F(FuncOutputCacheTests,
+OutputIsNotDroppedWhenReferencedGlobalVarExists) {
+	addLLVMFunc("test");
+	auto varG = Variable::create("g", IntType::create(32));
+	module->addGlobalVar(varG);
+	FuncOutputCache cache(dir, 1000000, "context");
+	cache.loadOutputs(module, llvmModule, config);
+	cache.storeOutput(testFunc, getTokensUsingGlobalVar("g"));
+	FuncOutputCache otherCache(dir, 1000000, "context");
+	otherCache.loadOutputs(module, llvmModule, config);
+
+	varG->setName("renamed");
+
+	EXPECT_TRUE(otherCache.dropUnusableOutputs().empty());
+	EXPECT_TRUE(module->isFuncOutputCached(testFunc));
+	EXPECT_EQ("renamed;", emitCachedOutput(otherCache));
+}
+
+TEST_F(FuncOutputCacheTests,
+OutputIsNotLoadedWhenAddressPopHasNoMatchingPush) {
+	using Kind = RecordingOutputManager::TokenKind;
+	addLLVMFunc("test");
+	FuncOutputCache cache(dir, 1000000, "context");
+	cache.loadOutputs(module, llvmModule, config);
+	cache.storeOutput(testFunc, {{Kind::AddressPop, "", Address()}});
+
+	FuncOutputCache otherCache(dir, 1000000, "context");
+
+	EXPECT_EQ(0, otherCache.loadOutputs(module, llvmModule, config));
+}
+
+} // namespace tests
+} // namespace llvmir2hll
+} // namespace retdec
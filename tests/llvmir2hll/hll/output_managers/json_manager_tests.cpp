@@ -247,6 +247,31 @@ TEST_F(JsonOutputManagerTests, address_push_and_pop_do_nothing)
 		emitSingleToken());
 }
 
+//
+// compact output
+//
+
+TEST_F(JsonOutputManagerTests, compact_output_emits_kinds_once_and_tokens_as_arrays)
+{
+	std::string code;
+	llvm::raw_string_ostream compactStream(code);
+	JsonOutputManagerPlain compactManager(compactStream, true);
+	compactManager.setOutputLanguage("C");
+
+	compactManager.addressPush(0x1000);
+	compactManager.keyword("return");
+	compactManager.space();
+	compactManager.constantInt("0");
+	compactManager.addressPop();
+	compactManager.finalize();
+	compactStream.flush();
+
+	EXPECT_TRUE(retdec::utils::startsWith(code, R"({"kinds":["nl","ws",)"));
+	EXPECT_TRUE(retdec::utils::endsWith(
+		code,
+		R"("tokens":[{"addr":""},{"addr":"0x1000"},[10,"return"],[1," "],[15,"0"]],"language":"C"})"));
+}
+
 } // namespace tests
 } // namespace llvmir2hll
-} // namespace retdec
\ No newline at end of file
+} // namespace retdec
@@ -0,0 +1,110 @@
+/**
+* @file tests/llvmir2hll/hll/output_managers/recording_manager_tests.cpp
+* @brief Implementation of class for tests of recording output manager.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include "llvmir2hll/hll/output_managers/output_manager_tests.h"
+#include "retdec/llvmir2hll/hll/output_managers/plain_manager.h"
+#include "retdec/llvmir2hll/hll/output_managers/recording_manager.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace llvmir2hll {
+namespace tests {
+
+class RecordingOutputManagerTests: public OutputManagerTests
+{
+	protected:
+		virtual void SetUp() override;
+
+		void emitSampleCode(OutputManager& out);
+
+	protected:
+		/// Manager into which the recorder passes the tokens.
+		UPtr<OutputManager> plainManager;
+
+		/// Manager under test.
+		RecordingOutputManager* recorder = nullptr;
+};
+
+void RecordingOutputManagerTests::SetUp()
+{
+	OutputManagerTests::SetUp();
+	plainManager = UPtr<OutputManager>(new PlainOutputManager(codeStream));
+	plainManager->setCommentPrefix("//");
+	recorder = new RecordingOutputManager(*plainManager);
+	manager = UPtr<OutputManager>(recorder);
+}
+
+void RecordingOutputManagerTests::emitSampleCode(OutputManager& out)
+{
+	out.addressPush(Address(0x1000));
+	out.dataType("int");
+	out.space();
+	out.functionId("main");
+	out.punctuation('(');
+	out.punctuation(')');
+	out.space();
+	out.punctuation('{');
+	out.newLine();
+	out.space("\t");
+	out.keyword("return");
+	out.space();
+	out.constantInt("0");
+	out.punctuation(';');
+	out.space();
+	out.comment("line\ncomment");
+	out.newLine();
+	out.punctuation('}');
+	out.addressPop();
+}
+
+TEST_F(RecordingOutputManagerTests, commentPrefixIsTakenFromWrappedManager)
+{
+	EXPECT_EQ("//", recorder->getCommentPrefix());
+}
+
+TEST_F(RecordingOutputManagerTests, tokensArePassedToWrappedManager)
+{
+	emitSampleCode(*manager);
+
+	EXPECT_EQ("int main() {\n\treturn 0; // line comment\n}", emitCode());
+}
+
+TEST_F(RecordingOutputManagerTests, tokensAreRecorded)
+{
+	manager->addressPush(Address(0x1000));
+	manager->keyword("return");
+	manager->punctuation(';');
+	manager->addressPop();
+
+	const auto& tokens = recorder->getTokens();
+	ASSERT_EQ(4, tokens.size());
+	EXPECT_EQ(RecordingOutputManager::TokenKind::AddressPush, tokens[0].kind);
+	EXPECT_EQ(Address(0x1000), tokens[0].address);
+	EXPECT_EQ(RecordingOutputManager::TokenKind::Keyword, tokens[1].kind);
+	EXPECT_EQ("return", tokens[1].value);
+	EXPECT_EQ(RecordingOutputManager::TokenKind::Punctuation, tokens[2].kind);
+	EXPECT_EQ(";", tokens[2].value);
+	EXPECT_EQ(RecordingOutputManager::TokenKind::AddressPop, tokens[3].kind);
+}
+
+TEST_F(RecordingOutputManagerTests, replayedTokensProduceSameCode)
+{
+	emitSampleCode(*manager);
+	auto code = emitCode();
+
+	std::string replayedCode;
+	llvm::raw_string_ostream replayedCodeStream(replayedCode);
+	PlainOutputManager otherManager(replayedCodeStream);
+	otherManager.setCommentPrefix("//");
+	RecordingOutputManager::replay(recorder->getTokens(), otherManager);
+
+	EXPECT_EQ(code, replayedCodeStream.str());
+}
+
+} // namespace tests
+} // namespace llvmir2hll
+} // namespace retdec
@@ -11,6 +11,7 @@
 #include "retdec/llvmir2hll/ir/int_type.h"
 #include "retdec/llvmir2hll/ir/variable.h"
 #include "retdec/llvmir2hll/ir/void_type.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
 #include "llvmir2hll/support/observer_mock.h"
 
 using namespace ::testing;
@@ -189,6 +190,22 @@ HasLocalVarWithoutIgnoringParamtersDoesNotIgnoreParameters) {
 	EXPECT_TRUE(func->hasLocalVar(varA, true));
 }
 
+//
+// setLocalVars()
+//
+
+TEST_F(FunctionTests,
+SetLocalVarsRecordsModification) {
+	auto func = getFuncDefinition();
+	auto varA = Variable::create("a", IntType::create(32));
+
+	ModificationRecorder modifications;
+	func->setLocalVars(VarSet{varA});
+
+	EXPECT_TRUE(modifications.hasModifications());
+	EXPECT_TRUE(func->hasLocalVar(varA));
+}
+
 //
 // convertToDeclaration()
 //
@@ -916,6 +916,80 @@ GetSelectedButNotFoundFuncsReturnsCorrectValue) {
 	ASSERT_EQ(SELECTED_BUT_NOT_FOUND_FUNCS, module->getSelectedButNotFoundFuncs());
 }
 
+//
+// isFuncOptimizedBy(), markFuncAsOptimizedBy()
+//
+
+TEST_F(ModuleTests,
+FuncIsNotOptimizedByOptimizerByDefault) {
+	auto testFunc = addFuncDef("test");
+	ASSERT_FALSE(module->isFuncOptimizedBy(testFunc, "Copy"));
+}
+
+TEST_F(ModuleTests,
+FuncIsOptimizedByOptimizerAfterBeingMarkedAsOptimizedByIt) {
+	auto testFunc = addFuncDef("test");
+	module->markFuncAsOptimizedBy(testFunc, "Copy");
+
+	ASSERT_TRUE(module->isFuncOptimizedBy(testFunc, "Copy"));
+	ASSERT_FALSE(module->isFuncOptimizedBy(testFunc, "Deref"));
+}
+
+TEST_F(ModuleTests,
+FuncIsNotOptimizedByOptimizerAfterBeingMarkedAsModified) {
+	auto testFunc = addFuncDef("test");
+	module->markFuncAsOptimizedBy(testFunc, "Copy");
+
+	module->markFuncAsModified(testFunc);
+
+	ASSERT_FALSE(module->isFuncOptimizedBy(testFunc, "Copy"));
+}
+
+TEST_F(ModuleTests,
+ModificationOfOtherFuncDoesNotAffectWhetherFuncIsOptimizedByOptimizer) {
+	auto testFunc = addFuncDef("test");
+	auto otherFunc = addFuncDef("other");
+	module->markFuncAsOptimizedBy(testFunc, "Copy");
+
+	module->markFuncAsModified(otherFunc);
+
+	ASSERT_TRUE(module->isFuncOptimizedBy(testFunc, "Copy"));
+}
+
+TEST_F(ModuleTests,
+FuncIsNotOptimizedByOptimizerAfterAllFuncsAreMarkedAsModified) {
+	auto testFunc = addFuncDef("test");
+	module->markFuncAsOptimizedBy(testFunc, "Copy");
+
+	module->markAllFuncsAsModified();
+
+	ASSERT_FALSE(module->isFuncOptimizedBy(testFunc, "Copy"));
+}
+
+//
+// getModificationEpoch()
+//
+
+TEST_F(ModuleTests,
+ModificationEpochChangesWhenFuncIsMarkedAsModified) {
+	auto testFunc = addFuncDef("test");
+	auto epoch = module->getModificationEpoch();
+
+	module->markFuncAsModified(testFunc);
+
+	ASSERT_NE(epoch, module->getModificationEpoch());
+}
+
+TEST_F(ModuleTests,
+ModificationEpochDoesNotChangeWhenFuncIsMarkedAsOptimizedByOptimizer) {
+	auto testFunc = addFuncDef("test");
+	auto epoch = module->getModificationEpoch();
+
+	module->markFuncAsOptimizedBy(testFunc, "Copy");
+
+	ASSERT_EQ(epoch, module->getModificationEpoch());
+}
+
 } // namespace tests
 } // namespace llvmir2hll
 } // namespace retdec
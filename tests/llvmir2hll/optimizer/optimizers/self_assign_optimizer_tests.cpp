@@ -11,6 +11,7 @@
 #include "retdec/llvmir2hll/ir/const_int.h"
 #include "retdec/llvmir2hll/ir/empty_stmt.h"
 #include "retdec/llvmir2hll/ir/function.h"
+#include "retdec/llvmir2hll/ir/function_builder.h"
 #include "retdec/llvmir2hll/ir/int_type.h"
 #include "retdec/llvmir2hll/ir/module.h"
 #include "retdec/llvmir2hll/ir/return_stmt.h"
@@ -204,6 +205,45 @@ FuncWithJustSelfAssignIsOptimizedToEmptyBody) {
 		testFunc->getBody()->getSuccessor();
 }
 
+TEST_F(SelfAssignOptimizerTests,
+FuncsAreOptimizedInParallelWhenParallelOptimizationIsEnabled) {
+	// Add the following functions to the module (g is a global variable):
+	//
+	//   void test() { g = g; return; }
+	//   void testN() { g = g; return; } // N = 0, 1, ..., 9
+	//
+	ShPtr<Variable> varG(Variable::create("g", IntType::create(16)));
+	module->addGlobalVar(varG);
+	FuncVector funcs{testFunc};
+	for (int i = 0; i < 10; ++i) {
+		ShPtr<Function> func(FunctionBuilder("test" + std::to_string(i))
+			.definitionWithEmptyBody()
+			.build());
+		module->addFunc(func);
+		funcs.push_back(func);
+	}
+	for (const auto &func : funcs) {
+		func->setBody(AssignStmt::create(varG, varG, ReturnStmt::create()));
+	}
+
+	// Optimize the module.
+	ShPtr<SelfAssignOptimizer> optimizer(new SelfAssignOptimizer(module));
+	optimizer->enableParallelOptimization(4, [this]() {
+		return std::make_shared<SelfAssignOptimizer>(module);
+	});
+	optimizer->optimize();
+
+	// Check that the output is correct.
+	for (const auto &func : funcs) {
+		ASSERT_TRUE(isa<ReturnStmt>(func->getBody())) <<
+			"expected ReturnStmt in " << func->getName() <<
+			", got " << func->getBody();
+		EXPECT_TRUE(!func->getBody()->hasSuccessor()) <<
+			"expected no successor in " << func->getName() <<
+			", got " << func->getBody()->getSuccessor();
+	}
+}
+
 } // namespace tests
 } // namespace llvmir2hll
 } // namespace retdec
@@ -12,6 +12,8 @@
 #include "retdec/llvmir2hll/ir/const_float.h"
 #include "retdec/llvmir2hll/ir/const_int.h"
 #include "retdec/llvmir2hll/ir/eq_op_expr.h"
+#include "retdec/llvmir2hll/ir/function.h"
+#include "retdec/llvmir2hll/ir/function_builder.h"
 #include "retdec/llvmir2hll/ir/gt_op_expr.h"
 #include "retdec/llvmir2hll/ir/int_type.h"
 #include "retdec/llvmir2hll/ir/lt_eq_op_expr.h"
@@ -223,6 +225,81 @@ BiggerAddAndSubAndMulExpression) {
 		"got `" << outConstInt << "`";
 }
 
+TEST_F(SimplifyArithmExprOptimizerTests,
+FuncIsMarkedAsOptimizedWhenNoChangesArePossibleAfterItsOptimization) {
+	// return 3 + 7;
+	//
+	// Optimized to return 10, which cannot be optimized any further.
+	//
+	testFunc->setBody(ReturnStmt::create(
+		AddOpExpr::create(
+			ConstInt::create(3, 64),
+			ConstInt::create(7, 64)
+	)));
+
+	optimize(module);
+
+	EXPECT_TRUE(module->isFuncOptimizedBy(testFunc, "SimplifyArithmExpr"));
+}
+
+TEST_F(SimplifyArithmExprOptimizerTests,
+FuncsAreOptimizedInParallelWhenParallelOptimizationIsEnabled) {
+	// Add the following functions to the module:
+	//
+	//   int test() { return ((3 + 7) - 2) * 4; }
+	//   int testN() { return ((3 + 7) - 2) * 4; } // N = 0, 1, ..., 9
+	//
+	// All of them are optimized to return 32.
+	//
+	FuncVector funcs{testFunc};
+	for (int i = 0; i < 10; ++i) {
+		ShPtr<Function> func(FunctionBuilder("test" + std::to_string(i))
+			.definitionWithEmptyBody()
+			.build());
+		module->addFunc(func);
+		funcs.push_back(func);
+	}
+	for (const auto &func : funcs) {
+		func->setBody(ReturnStmt::create(
+			MulOpExpr::create(
+				SubOpExpr::create(
+					AddOpExpr::create(
+						ConstInt::create(3, 64),
+						ConstInt::create(7, 64)
+					),
+					ConstInt::create(2, 64)
+				),
+				ConstInt::create(4, 64)
+		)));
+	}
+
+	// Optimize the module. Every instance needs its own evaluator.
+	ShPtr<SimplifyArithmExprOptimizer> optimizer(
+		new SimplifyArithmExprOptimizer(module,
+			StrictArithmExprEvaluator::create()));
+	optimizer->enableParallelOptimization(4, [this]() {
+		return std::make_shared<SimplifyArithmExprOptimizer>(module,
+			StrictArithmExprEvaluator::create());
+	});
+	optimizer->optimize();
+
+	// Check that the output is correct.
+	for (const auto &func : funcs) {
+		ShPtr<ReturnStmt> returnStmt(cast<ReturnStmt>(func->getBody()));
+		ASSERT_TRUE(returnStmt) <<
+			"expected ReturnStmt in " << func->getName() <<
+			", got " << func->getBody();
+		ShPtr<ConstInt> outConstInt(cast<ConstInt>(returnStmt->getRetVal()));
+		ASSERT_TRUE(outConstInt) <<
+			"expected `ConstInt` in " << func->getName() << ", "
+			"got `" << returnStmt->getRetVal() << "`";
+		EXPECT_EQ(ConstInt::create(32, 64)->getValue(),
+			outConstInt->getValue()) <<
+			"expected `32` in " << func->getName() << ", "
+			"got `" << outConstInt << "`";
+	}
+}
+
 } // namespace tests
 } // namespace llvmir2hll
 } // namespace retdec
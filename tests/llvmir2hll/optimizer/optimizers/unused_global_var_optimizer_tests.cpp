@@ -97,6 +97,23 @@ RemovesGlobalVarWhenItIsNotUsed) {
 	ASSERT_FALSE(module->hasGlobalVar("g"));
 }
 
+TEST_F(UnusedGlobalVarOptimizerTests,
+DoesNotRemoveUnusedGlobalVarWhenModulePreventsItsRemoval) {
+	// Set-up the module.
+	//
+	// int g;
+	//
+	auto varG = Variable::create("g", IntType::create(32));
+	module->addGlobalVar(varG);
+	module->preventRemovalOfVar(varG);
+
+	// Optimize the module.
+	Optimizer::optimize<UnusedGlobalVarOptimizer>(module);
+
+	// Check that the output is correct.
+	ASSERT_TRUE(module->hasGlobalVar("g"));
+}
+
 } // namespace tests
 } // namespace llvmir2hll
 } // namespace retdec
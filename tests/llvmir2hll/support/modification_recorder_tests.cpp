@@ -0,0 +1,72 @@
+/**
+* @file tests/llvmir2hll/support/modification_recorder_tests.cpp
+* @brief Tests for the @c modification_recorder module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <gtest/gtest.h>
+
+#include "retdec/llvmir2hll/ir/int_type.h"
+#include "retdec/llvmir2hll/ir/variable.h"
+#include "retdec/llvmir2hll/support/modification_recorder.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace llvmir2hll {
+namespace tests {
+
+/**
+* @brief Tests for the @c modification_recorder module.
+*/
+class ModificationRecorderTests: public Test {};
+
+TEST_F(ModificationRecorderTests,
+NoModificationIsRecordedWhenNothingIsModified) {
+	auto var = Variable::create("a", IntType::create(32));
+
+	ModificationRecorder modifications;
+	var->getName();
+
+	ASSERT_FALSE(modifications.hasModifications());
+}
+
+TEST_F(ModificationRecorderTests,
+ModificationIsRecordedWhenValueIsModified) {
+	auto var = Variable::create("a", IntType::create(32));
+
+	ModificationRecorder modifications;
+	var->setName("b");
+
+	ASSERT_TRUE(modifications.hasModifications());
+}
+
+TEST_F(ModificationRecorderTests,
+ModificationIsRecordedOnlyIntoInnermostRecorder) {
+	auto var = Variable::create("a", IntType::create(32));
+
+	ModificationRecorder outerModifications;
+	{
+		ModificationRecorder innerModifications;
+		var->setName("b");
+		ASSERT_EQ(1, innerModifications.getNumOfModifications());
+	}
+	ASSERT_FALSE(outerModifications.hasModifications());
+
+	var->setName("c");
+	ASSERT_EQ(1, outerModifications.getNumOfModifications());
+}
+
+TEST_F(ModificationRecorderTests,
+ModificationIsNotRecordedWhenThereIsNoRecorder) {
+	auto var = Variable::create("a", IntType::create(32));
+
+	var->setName("b");
+
+	ModificationRecorder modifications;
+	ASSERT_FALSE(modifications.hasModifications());
+}
+
+} // namespace tests
+} // namespace llvmir2hll
+} // namespace retdec
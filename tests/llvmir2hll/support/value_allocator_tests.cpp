@@ -0,0 +1,128 @@
+/**
+* @file tests/llvmir2hll/support/value_allocator_tests.cpp
+* @brief Tests for the @c value_allocator module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/llvmir2hll/ir/const_int.h"
+#include "retdec/llvmir2hll/support/value_allocator.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace llvmir2hll {
+namespace tests {
+
+/**
+* @brief Tests for the @c value_allocator module.
+*/
+class ValueAllocatorTests: public Test {};
+
+TEST_F(ValueAllocatorTests,
+FreedBlockIsReusedForBlockOfSameSize) {
+	void *block = ValueAllocator::allocate(40);
+	ValueAllocator::deallocate(block, 40);
+
+	void *otherBlock = ValueAllocator::allocate(40);
+
+	EXPECT_EQ(block, otherBlock);
+	ValueAllocator::deallocate(otherBlock, 40);
+}
+
+TEST_F(ValueAllocatorTests,
+BlocksAreAlignedAndDoNotOverlap) {
+	void *block1 = ValueAllocator::allocate(24);
+	void *block2 = ValueAllocator::allocate(24);
+	std::memset(block1, 0xaa, 24);
+	std::memset(block2, 0xbb, 24);
+
+	EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(block1)
+		% alignof(std::max_align_t));
+	EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(block2)
+		% alignof(std::max_align_t));
+	EXPECT_EQ(0xaa, static_cast<unsigned char *>(block1)[23]);
+	ValueAllocator::deallocate(block1, 24);
+	ValueAllocator::deallocate(block2, 24);
+}
+
+TEST_F(ValueAllocatorTests,
+LargeBlocksCanBeAllocatedAndFreed) {
+	void *block = ValueAllocator::allocate(ValueAllocator::MAX_POOLED_SIZE + 1);
+	std::memset(block, 0, ValueAllocator::MAX_POOLED_SIZE + 1);
+
+	ValueAllocator::deallocate(block, ValueAllocator::MAX_POOLED_SIZE + 1);
+}
+
+TEST_F(ValueAllocatorTests,
+BlockCanBeFreedInOtherThread) {
+	void *block = ValueAllocator::allocate(64);
+
+	std::thread([&]() {
+		ValueAllocator::deallocate(block, 64);
+		void *otherBlock = ValueAllocator::allocate(64);
+		EXPECT_EQ(block, otherBlock);
+		ValueAllocator::deallocate(otherBlock, 64);
+	}).join();
+}
+
+TEST_F(ValueAllocatorTests,
+ValuesAreAllocatedFromPool) {
+	auto value = ConstInt::create(1, 32);
+	void *valueBlock = value.get();
+	value.reset();
+
+	void *block = ValueAllocator::allocate(sizeof(ConstInt));
+
+	EXPECT_EQ(valueBlock, block);
+	ValueAllocator::deallocate(block, sizeof(ConstInt));
+}
+
+TEST_F(ValueAllocatorTests,
+TrimReturnsChunksWhoseBlocksAreAllFree) {
+	// A size class not used by values, so that its chunks are used only here.
+	const std::size_t size = ValueAllocator::MAX_POOLED_SIZE;
+	const std::size_t numOfBlocks = 3 * ValueAllocator::CHUNK_SIZE / size;
+	std::vector<void *> blocks;
+	for (std::size_t i = 0; i < numOfBlocks; ++i) {
+		blocks.push_back(ValueAllocator::allocate(size));
+	}
+	auto numOfChunks = ValueAllocator::getNumOfAllocatedChunks();
+
+	// Only the first block is kept, so its chunk cannot be returned.
+	for (std::size_t i = 1; i < numOfBlocks; ++i) {
+		ValueAllocator::deallocate(blocks[i], size);
+	}
+	EXPECT_GE(ValueAllocator::trim(), 2);
+	EXPECT_LE(ValueAllocator::getNumOfAllocatedChunks(), numOfChunks - 2);
+
+	// The kept block is still usable and the remaining free blocks of its
+	// chunk are reused.
+	std::memset(blocks[0], 0xaa, size);
+	numOfChunks = ValueAllocator::getNumOfAllocatedChunks();
+	void *otherBlock = ValueAllocator::allocate(size);
+	EXPECT_EQ(numOfChunks, ValueAllocator::getNumOfAllocatedChunks());
+	ValueAllocator::deallocate(otherBlock, size);
+	ValueAllocator::deallocate(blocks[0], size);
+}
+
+TEST_F(ValueAllocatorTests,
+TrimReturnsChunksFreedInOtherThread) {
+	const std::size_t size = ValueAllocator::MAX_POOLED_SIZE;
+	std::thread([&]() {
+		void *block = ValueAllocator::allocate(size);
+		ValueAllocator::deallocate(block, size);
+	}).join();
+
+	EXPECT_GE(ValueAllocator::trim(), 1);
+}
+
+} // namespace tests
+} // namespace llvmir2hll
+} // namespace retdec
@@ -0,0 +1,160 @@
+/**
+ * @file tests/loader/segment_index_tests.cpp
+ * @brief Tests for the @c segment_index module.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "retdec/loader/loader/segment_index.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace loader {
+namespace tests {
+
+class SegmentIndexTests : public Test
+{
+public:
+	Segment* addSegment(std::uint64_t address, std::uint64_t size)
+	{
+		segments.push_back(std::make_unique<Segment>(nullptr, address, size, nullptr));
+		return segments.back().get();
+	}
+
+	const Segment* linearFind(std::uint64_t address) const
+	{
+		for (const auto& segment : segments)
+		{
+			if (segment->containsAddress(address))
+				return segment.get();
+		}
+
+		return nullptr;
+	}
+
+	std::vector<std::unique_ptr<Segment>> segments;
+	SegmentIndex index;
+};
+
+TEST_F(SegmentIndexTests,
+EmptyIndexFindsNothing) {
+	EXPECT_EQ(nullptr, index.find(0));
+	EXPECT_EQ(nullptr, index.find(0x1000));
+}
+
+TEST_F(SegmentIndexTests,
+FindWorksForDisjointSegments) {
+	auto* seg1 = addSegment(0x3000, 0x100);
+	auto* seg2 = addSegment(0x1000, 0x200);
+	auto* seg3 = addSegment(0x1200, 0x10);
+	index.build(segments);
+
+	EXPECT_EQ(nullptr, index.find(0xFFF));
+	EXPECT_EQ(seg2, index.find(0x1000));
+	EXPECT_EQ(seg2, index.find(0x11FF));
+	EXPECT_EQ(seg3, index.find(0x1200));
+	EXPECT_EQ(seg3, index.find(0x120F));
+	EXPECT_EQ(nullptr, index.find(0x1210));
+	EXPECT_EQ(seg1, index.find(0x3000));
+	EXPECT_EQ(seg1, index.find(0x30FF));
+	EXPECT_EQ(nullptr, index.find(0x3100));
+}
+
+TEST_F(SegmentIndexTests,
+FindPrefersEarlierSegmentForOverlappingSegments) {
+	auto* seg1 = addSegment(0x1100, 0x100);
+	auto* seg2 = addSegment(0x1000, 0x400);
+	addSegment(0x1000, 0x10);
+	index.build(segments);
+
+	EXPECT_EQ(seg2, index.find(0x1000));
+	EXPECT_EQ(seg2, index.find(0x10FF));
+	EXPECT_EQ(seg1, index.find(0x1100));
+	EXPECT_EQ(seg1, index.find(0x11FF));
+	EXPECT_EQ(seg2, index.find(0x1200));
+	EXPECT_EQ(nullptr, index.find(0x1400));
+}
+
+TEST_F(SegmentIndexTests,
+FindWorksForSegmentsWithZeroSize) {
+	auto* seg1 = addSegment(0x1000, 0);
+	auto* seg2 = addSegment(0x1000, 0x10);
+	index.build(segments);
+
+	EXPECT_EQ(seg1, index.find(0x1000));
+	EXPECT_EQ(seg2, index.find(0x1001));
+}
+
+TEST_F(SegmentIndexTests,
+RebuildReflectsChangedSegments) {
+	auto* seg1 = addSegment(0x1000, 0x100);
+	index.build(segments);
+	seg1->resize(0x200);
+	index.build(segments);
+
+	EXPECT_EQ(seg1, index.find(0x11FF));
+}
+
+TEST_F(SegmentIndexTests,
+ClearRemovesAllSegments) {
+	addSegment(0x1000, 0x100);
+	index.build(segments);
+	index.clear();
+
+	EXPECT_EQ(nullptr, index.find(0x1000));
+}
+
+TEST_F(SegmentIndexTests,
+FindMatchesLinearSearchForManyOverlappingSegments) {
+	// Object files have many sections at the same or overlapping addresses.
+	for (std::uint64_t i = 0; i < 1000; ++i)
+		addSegment((i * 7919) % 0x4000, 0x10 + (i * 31) % 0x300);
+	index.build(segments);
+
+	for (std::uint64_t address = 0; address < 0x4400; address += 3)
+		ASSERT_EQ(linearFind(address), index.find(address)) << "address " << address;
+}
+
+/**
+ * Micro-benchmark comparing the index with the linear search over segments,
+ * which was used before. Run it with --gtest_also_run_disabled_tests.
+ */
+TEST_F(SegmentIndexTests,
+DISABLED_BenchmarkFindInThousandsOfSegments) {
+	const std::uint64_t numSegments = 5000;
+	const std::uint64_t numLookups = 1000000;
+	for (std::uint64_t i = 0; i < numSegments; ++i)
+		addSegment(0x10000 + i * 0x100, 0x80);
+
+	auto start = std::chrono::steady_clock::now();
+	index.build(segments);
+	auto buildTime = std::chrono::steady_clock::now() - start;
+
+	std::size_t found = 0;
+	start = std::chrono::steady_clock::now();
+	for (std::uint64_t i = 0; i < numLookups; ++i)
+		found += index.find(0x10000 + (i * 7919) % (numSegments * 0x100)) != nullptr;
+	auto indexTime = std::chrono::steady_clock::now() - start;
+
+	std::size_t linearFound = 0;
+	start = std::chrono::steady_clock::now();
+	for (std::uint64_t i = 0; i < numLookups; ++i)
+		linearFound += linearFind(0x10000 + (i * 7919) % (numSegments * 0x100)) != nullptr;
+	auto linearTime = std::chrono::steady_clock::now() - start;
+
+	using ms = std::chrono::duration<double, std::milli>;
+	std::cout << numSegments << " segments, " << numLookups << " lookups:\n"
+		<< "  build:  " << ms(buildTime).count() << " ms\n"
+		<< "  index:  " << ms(indexTime).count() << " ms\n"
+		<< "  linear: " << ms(linearTime).count() << " ms\n";
+	EXPECT_EQ(linearFound, found);
+}
+
+} // namespace tests
+} // namespace loader
+} // namespace retdec
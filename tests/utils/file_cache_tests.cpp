@@ -0,0 +1,125 @@
+/**
+* @file tests/utils/file_cache_tests.cpp
+* @brief Tests for the @c file_cache module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/file_cache.h"
+#include "retdec/utils/filesystem.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c file_cache module.
+*/
+class FileCacheTests: public Test {
+protected:
+	void SetUp() override {
+		fs::remove_all(dir);
+	}
+
+	void TearDown() override {
+		fs::remove_all(dir);
+	}
+
+	void setLastUse(const std::string& key, int secondsAgo) {
+		fs::last_write_time(fs::path(dir) / key,
+			fs::file_time_type::clock::now() - std::chrono::seconds(secondsAgo));
+	}
+
+	std::string dir = (fs::temp_directory_path()
+		/ "retdec-tests-utils-file-cache").string();
+};
+
+TEST_F(FileCacheTests,
+ConstructorCreatesDirectory) {
+	FileCache cache(dir, 100);
+
+	EXPECT_TRUE(cache.isUsable());
+	EXPECT_TRUE(fs::is_directory(dir));
+}
+
+TEST_F(FileCacheTests,
+GetReturnsNothingForMissingEntry) {
+	FileCache cache(dir, 100);
+
+	EXPECT_FALSE(cache.get("abc"));
+}
+
+TEST_F(FileCacheTests,
+GetReturnsStoredEntryAlsoInOtherInstance) {
+	FileCache cache(dir, 100);
+	ASSERT_TRUE(cache.put("abc", std::string("x\0y", 3)));
+
+	FileCache otherCache(dir, 100);
+	auto content = otherCache.get("abc");
+
+	ASSERT_TRUE(content);
+	EXPECT_EQ(std::string("x\0y", 3), *content);
+}
+
+TEST_F(FileCacheTests,
+PutReplacesExistingEntry) {
+	FileCache cache(dir, 100);
+	cache.put("abc", "old");
+
+	cache.put("abc", "new");
+
+	EXPECT_EQ("new", cache.get("abc").value_or(""));
+}
+
+TEST_F(FileCacheTests,
+InvalidKeysAreRejected) {
+	FileCache cache(dir, 100);
+
+	EXPECT_FALSE(cache.put("", "content"));
+	EXPECT_FALSE(cache.put("../abc", "content"));
+	EXPECT_FALSE(cache.get("../abc"));
+}
+
+TEST_F(FileCacheTests,
+EvictRemovesLeastRecentlyUsedEntriesUntilSizeIsWithinLimit) {
+	FileCache cache(dir, 10);
+	cache.put("a", "1234");
+	cache.put("b", "1234");
+	cache.put("c", "1234");
+	setLastUse("a", 30);
+	setLastUse("b", 20);
+	setLastUse("c", 10);
+
+	cache.evict();
+
+	EXPECT_FALSE(cache.get("a"));
+	EXPECT_TRUE(cache.get("b"));
+	EXPECT_TRUE(cache.get("c"));
+}
+
+TEST_F(FileCacheTests,
+GetMarksEntryAsRecentlyUsed) {
+	FileCache cache(dir, 10);
+	cache.put("a", "1234");
+	cache.put("b", "1234");
+	cache.put("c", "1234");
+	setLastUse("a", 30);
+	setLastUse("b", 20);
+	setLastUse("c", 10);
+
+	cache.get("a");
+	cache.evict();
+
+	EXPECT_TRUE(cache.get("a"));
+	EXPECT_FALSE(cache.get("b"));
+	EXPECT_TRUE(cache.get("c"));
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
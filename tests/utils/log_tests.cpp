@@ -0,0 +1,118 @@
+/**
+* @file tests/utils/log_tests.cpp
+* @brief Tests for the @c log module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/io/log.h"
+#include "retdec/utils/parallel.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace io {
+namespace tests {
+
+/**
+* @brief Tests for the @c log module.
+*/
+class LogTests: public Test
+{
+	protected:
+		std::string logInContext(
+				std::ostringstream& out,
+				const std::string& message)
+		{
+			Log::Context context;
+			context.set(Log::Type::Info, std::make_unique<Logger>(out));
+			Log::ContextScope scope(&context);
+
+			Log::info() << message;
+			return out.str();
+		}
+};
+
+TEST_F(LogTests,
+GetContextReturnsNullptrWithoutActiveContext) {
+	ASSERT_EQ(nullptr, Log::getContext());
+}
+
+TEST_F(LogTests,
+ContextScopeActivatesAndRestoresContext) {
+	Log::Context outer;
+	Log::Context inner;
+
+	{
+		Log::ContextScope outerScope(&outer);
+		ASSERT_EQ(&outer, Log::getContext());
+		{
+			Log::ContextScope innerScope(&inner);
+			ASSERT_EQ(&inner, Log::getContext());
+		}
+		ASSERT_EQ(&outer, Log::getContext());
+	}
+	ASSERT_EQ(nullptr, Log::getContext());
+}
+
+TEST_F(LogTests,
+LoggerFromActiveContextIsUsed) {
+	std::ostringstream out;
+
+	ASSERT_EQ("message", logInContext(out, "message"));
+}
+
+TEST_F(LogTests,
+TypesWithoutLoggerInContextFallBackToGlobalLoggers) {
+	auto* global = &Log::get(Log::Type::Error);
+	Log::Context context;
+	Log::ContextScope scope(&context);
+
+	ASSERT_EQ(global, &Log::get(Log::Type::Error));
+}
+
+TEST_F(LogTests,
+ContextsOfParallelThreadsDoNotInterfere) {
+	std::ostringstream out1;
+	std::ostringstream out2;
+	std::string result1;
+	std::string result2;
+
+	std::thread t1([&]() { result1 = logInContext(out1, "first"); });
+	std::thread t2([&]() { result2 = logInContext(out2, "second"); });
+	t1.join();
+	t2.join();
+
+	ASSERT_EQ("first", result1);
+	ASSERT_EQ("second", result2);
+}
+
+TEST_F(LogTests,
+ParallelForWorkersUseContextOfCallingThread) {
+	std::ostringstream out;
+	Log::Context context;
+	context.set(Log::Type::Info, std::make_unique<Logger>(out));
+	Log::ContextScope scope(&context);
+	std::vector<Logger*> loggers(100);
+
+	parallelFor(loggers.size(), 4, [&](std::size_t i) {
+		loggers[i] = &Log::get(Log::Type::Info);
+	});
+
+	for (auto* l : loggers) {
+		ASSERT_EQ(context.get(Log::Type::Info), l);
+	}
+}
+
+} // namespace tests
+} // namespace io
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,72 @@
+/**
+* @file tests/utils/mapped_file_tests.cpp
+* @brief Tests for the @c mapped_file module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/utils/mapped_file.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c mapped_file module.
+*/
+class MappedFileTests: public Test {
+protected:
+	void TearDown() override {
+		fs::remove(path);
+	}
+
+	void createFile(const std::string& content) {
+		std::ofstream file(path, std::ios::out | std::ios::binary);
+		file << content;
+	}
+
+	std::string path = (fs::temp_directory_path()
+		/ "retdec-tests-utils-mapped-file.bin").string();
+};
+
+TEST_F(MappedFileTests,
+OpenReturnsContentOfFile) {
+	createFile(std::string("ab\0cd", 5));
+
+	auto file = MappedFile::open(path);
+
+	ASSERT_NE(nullptr, file);
+	EXPECT_TRUE(file->isMapped());
+	ASSERT_EQ(5, file->size());
+	EXPECT_EQ(
+		std::string("ab\0cd", 5),
+		std::string(reinterpret_cast<const char*>(file->data()), file->size())
+	);
+}
+
+TEST_F(MappedFileTests,
+OpenReturnsEmptyContentForEmptyFile) {
+	createFile("");
+
+	auto file = MappedFile::open(path);
+
+	ASSERT_NE(nullptr, file);
+	EXPECT_TRUE(file->empty());
+	EXPECT_EQ(0, file->size());
+}
+
+TEST_F(MappedFileTests,
+OpenReturnsNullptrForNonexistentFile) {
+	EXPECT_EQ(nullptr, MappedFile::open(path));
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
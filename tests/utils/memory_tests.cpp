@@ -42,6 +42,11 @@ GetTotalSystemMemoryReturnsNonZeroSize) {
 	ASSERT_GT(size, 0);
 }
 
+TEST_F(MemoryTests,
+GetPeakMemoryUsageReturnsNonZeroSize) {
+	ASSERT_GT(getPeakMemoryUsage(), 0);
+}
+
 TEST_F(MemoryTests,
 LimitSystemMemoryReturnsTrueWhenLimitingTotalSystemMemoryToNonZeroSize) {
 	auto totalSize = getTotalSystemMemory();
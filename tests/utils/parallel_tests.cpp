@@ -0,0 +1,88 @@
+/**
+* @file tests/utils/parallel_tests.cpp
+* @brief Tests for the @c parallel module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/parallel.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c parallel module.
+*/
+class ParallelTests: public Test {};
+
+//
+// getNumberOfJobs()
+//
+
+TEST_F(ParallelTests,
+GetNumberOfJobsReturnsHardwareConcurrencyForZero) {
+	ASSERT_EQ(getHardwareConcurrency(), getNumberOfJobs(0));
+}
+
+TEST_F(ParallelTests,
+GetNumberOfJobsReturnsRequestedNumberOfJobs) {
+	ASSERT_EQ(1, getNumberOfJobs(1));
+	ASSERT_EQ(8, getNumberOfJobs(8));
+}
+
+//
+// parallelFor()
+//
+
+TEST_F(ParallelTests,
+ParallelForDoesNothingForZeroItems) {
+	bool called = false;
+
+	parallelFor(0, 4, [&](std::size_t) { called = true; });
+
+	ASSERT_FALSE(called);
+}
+
+TEST_F(ParallelTests,
+ParallelForWithSingleJobProcessesItemsInOrder) {
+	std::vector<std::size_t> order;
+
+	parallelFor(5, 1, [&](std::size_t i) { order.push_back(i); });
+
+	ASSERT_EQ(std::vector<std::size_t>({0, 1, 2, 3, 4}), order);
+}
+
+TEST_F(ParallelTests,
+ParallelForProcessesEveryItemExactlyOnce) {
+	std::vector<std::atomic<int>> hits(1000);
+
+	parallelFor(hits.size(), 4, [&](std::size_t i) { ++hits[i]; });
+
+	for (auto& h : hits) {
+		ASSERT_EQ(1, h);
+	}
+}
+
+TEST_F(ParallelTests,
+ParallelForRethrowsExceptionFromWorkItem) {
+	ASSERT_THROW(
+		parallelFor(100, 4, [](std::size_t i) {
+			if (i == 42) {
+				throw std::runtime_error("failure");
+			}
+		}),
+		std::runtime_error
+	);
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,115 @@
+/**
+* @file tests/utils/profiler_tests.cpp
+* @brief Tests for the @c profiler module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/profiler.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c profiler module.
+*/
+class ProfilerTests: public Test {
+protected:
+	void SetUp() override {
+		Profiler::clear();
+		Profiler::enable();
+	}
+
+	void TearDown() override {
+		Profiler::disable();
+		Profiler::clear();
+	}
+};
+
+TEST_F(ProfilerTests,
+NoPhaseIsRecordedWhenProfilerIsDisabled) {
+	Profiler::disable();
+
+	{
+		Profiler::Scope scope("phase");
+		EXPECT_FALSE(scope.isActive());
+	}
+
+	EXPECT_TRUE(Profiler::getPhases().empty());
+}
+
+TEST_F(ProfilerTests,
+PhasesAreRecordedInOrderOfStartWithNestingLevels) {
+	{
+		Profiler::Scope outer("outer");
+		{
+			Profiler::Scope inner("inner");
+		}
+	}
+	Profiler::Scope next("next");
+	next.stop();
+
+	auto phases = Profiler::getPhases();
+	ASSERT_EQ(3, phases.size());
+	EXPECT_EQ("outer", phases[0].name);
+	EXPECT_EQ(0, phases[0].level);
+	EXPECT_EQ("inner", phases[1].name);
+	EXPECT_EQ(1, phases[1].level);
+	EXPECT_EQ("next", phases[2].name);
+	EXPECT_EQ(0, phases[2].level);
+	EXPECT_GE(phases[0].wallTime, phases[1].wallTime);
+}
+
+TEST_F(ProfilerTests,
+CountsAreSetOnlyWhenGiven) {
+	{
+		Profiler::Scope scope("counted");
+		scope.stop();
+		scope.setCounts(2, 10);
+	}
+	Profiler::Scope("not counted");
+
+	auto phases = Profiler::getPhases();
+	ASSERT_EQ(2, phases.size());
+	EXPECT_EQ(2, phases[0].functions);
+	EXPECT_EQ(10, phases[0].instructions);
+	EXPECT_FALSE(phases[1].functions);
+	EXPECT_FALSE(phases[1].instructions);
+}
+
+TEST_F(ProfilerTests,
+WriteJsonWritesOneObjectPerPhase) {
+	{
+		Profiler::Scope scope("a \"quoted\" phase");
+		scope.stop();
+		scope.setCounts(1, 3);
+	}
+
+	std::ostringstream out;
+	Profiler::writeJson(out);
+
+	auto json = out.str();
+	EXPECT_NE(std::string::npos, json.find("\"phase\": \"a \\\"quoted\\\" phase\""));
+	EXPECT_NE(std::string::npos, json.find("\"functions\": 1"));
+	EXPECT_NE(std::string::npos, json.find("\"instructions\": 3"));
+	EXPECT_NE(std::string::npos, json.find("\"wallTime\": "));
+	EXPECT_NE(std::string::npos, json.find("\"peakRssDelta\": "));
+}
+
+TEST_F(ProfilerTests,
+WriteJsonWritesEmptyArrayWhenThereAreNoPhases) {
+	std::ostringstream out;
+	Profiler::writeJson(out);
+
+	EXPECT_EQ("[]\n", out.str());
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,158 @@
+/**
+* @file tests/yaracpp/yara_rule_cache_tests.cpp
+* @brief Tests for the @c yara_rule_cache module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <chrono>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/yaracpp/yara_rule_cache.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace yaracpp {
+namespace tests {
+
+/**
+* @brief Tests for the @c yara_rule_cache module.
+*/
+class YaraRuleCacheTests: public Test {
+protected:
+	void SetUp() override {
+		fs::remove_all(dir);
+		fs::create_directories(dir);
+		YaraRuleCache::getInstance().clear();
+		YaraRuleCache::getInstance().setPersistCompiledRules(false);
+	}
+
+	void TearDown() override {
+		YaraRuleCache::getInstance().clear();
+		YaraRuleCache::getInstance().setPersistCompiledRules(false);
+		fs::remove_all(dir);
+	}
+
+	void writeRules(const std::string& content) {
+		std::ofstream(ruleFile) << content;
+	}
+
+	void setModificationTime(const std::string& path, int secondsAgo) {
+		fs::last_write_time(path,
+			fs::file_time_type::clock::now() - std::chrono::seconds(secondsAgo));
+	}
+
+	std::string dir = (fs::temp_directory_path()
+		/ "retdec-tests-yaracpp-rule-cache").string();
+	std::string ruleFile = (fs::path(dir) / "rules.yara").string();
+};
+
+TEST_F(YaraRuleCacheTests,
+GetRulesReturnsNothingForMissingFile) {
+	EXPECT_EQ(nullptr, YaraRuleCache::getInstance().getRules(ruleFile));
+}
+
+TEST_F(YaraRuleCacheTests,
+GetRulesReturnsNothingForInvalidRules) {
+	writeRules("rule {");
+
+	EXPECT_EQ(nullptr, YaraRuleCache::getInstance().getRules(ruleFile));
+}
+
+TEST_F(YaraRuleCacheTests,
+GetRulesReturnsCachedRulesForUnmodifiedFile) {
+	writeRules("rule a { condition: true }");
+
+	auto rules = YaraRuleCache::getInstance().getRules(ruleFile);
+	auto cachedRules = YaraRuleCache::getInstance().getRules(ruleFile);
+
+	ASSERT_NE(nullptr, rules);
+	EXPECT_EQ(rules, cachedRules);
+}
+
+TEST_F(YaraRuleCacheTests,
+GetRulesReturnsDifferentRulesForDifferentNamespaces) {
+	writeRules("rule a { condition: true }");
+
+	auto rules = YaraRuleCache::getInstance().getRules(ruleFile, "first");
+	auto otherRules = YaraRuleCache::getInstance().getRules(ruleFile, "second");
+
+	ASSERT_NE(nullptr, rules);
+	ASSERT_NE(nullptr, otherRules);
+	EXPECT_NE(rules, otherRules);
+}
+
+TEST_F(YaraRuleCacheTests,
+GetRulesReloadsRulesAfterModification) {
+	writeRules("rule a { condition: true }");
+	setModificationTime(ruleFile, 10);
+	auto rules = YaraRuleCache::getInstance().getRules(ruleFile);
+
+	writeRules("rule b { condition: false }");
+	setModificationTime(ruleFile, 5);
+	auto reloadedRules = YaraRuleCache::getInstance().getRules(ruleFile);
+
+	ASSERT_NE(nullptr, rules);
+	ASSERT_NE(nullptr, reloadedRules);
+	EXPECT_NE(rules, reloadedRules);
+	EXPECT_EQ(reloadedRules, YaraRuleCache::getInstance().getRules(ruleFile));
+}
+
+TEST_F(YaraRuleCacheTests,
+CompiledRulesAreNotPersistedByDefault) {
+	writeRules("rule a { condition: true }");
+
+	ASSERT_NE(nullptr, YaraRuleCache::getInstance().getRules(ruleFile));
+
+	EXPECT_FALSE(fs::exists(YaraRuleCache::getCompiledRulesPath(ruleFile)));
+}
+
+TEST_F(YaraRuleCacheTests,
+CompiledRulesArePersistedAndReused) {
+	YaraRuleCache::getInstance().setPersistCompiledRules(true);
+	writeRules("rule a { condition: true }");
+	setModificationTime(ruleFile, 10);
+
+	ASSERT_NE(nullptr, YaraRuleCache::getInstance().getRules(ruleFile));
+	const auto compiledFile = YaraRuleCache::getCompiledRulesPath(ruleFile);
+	ASSERT_TRUE(fs::exists(compiledFile));
+
+	// Invalid text rules which are older than the compiled ones can be
+	// loaded only from the compiled file.
+	YaraRuleCache::getInstance().clear();
+	writeRules("rule {");
+	setModificationTime(ruleFile, 5);
+
+	EXPECT_NE(nullptr, YaraRuleCache::getInstance().getRules(ruleFile));
+}
+
+TEST_F(YaraRuleCacheTests,
+PersistedCompiledRulesAreNotReusedWhenOlderThanTextRules) {
+	YaraRuleCache::getInstance().setPersistCompiledRules(true);
+	writeRules("rule a { condition: true }");
+	setModificationTime(ruleFile, 10);
+	ASSERT_NE(nullptr, YaraRuleCache::getInstance().getRules(ruleFile));
+	const auto compiledFile = YaraRuleCache::getCompiledRulesPath(ruleFile);
+	ASSERT_TRUE(fs::exists(compiledFile));
+	setModificationTime(compiledFile, 10);
+
+	YaraRuleCache::getInstance().clear();
+	writeRules("rule {");
+
+	EXPECT_EQ(nullptr, YaraRuleCache::getInstance().getRules(ruleFile));
+}
+
+TEST_F(YaraRuleCacheTests,
+CompiledRulesPathIsNextToRuleFile) {
+	EXPECT_EQ("dir/rules.yarac",
+		YaraRuleCache::getCompiledRulesPath("dir/rules.yara"));
+	EXPECT_EQ("dir/rules.crypto.yarac",
+		YaraRuleCache::getCompiledRulesPath("dir/rules.yara", "crypto"));
+}
+
+} // namespace tests
+} // namespace yaracpp
+} // namespace retdec